@@ -8,6 +8,7 @@
 #ifndef TCHECKER_ALGORITHMS_COVREACH_ALGORITHM_HH
 #define TCHECKER_ALGORITHMS_COVREACH_ALGORITHM_HH
 
+#include <algorithm>
 #include <functional>
 #include <iterator>
 #include <tuple>
@@ -61,6 +62,46 @@ namespace tchecker {
       using edge_ptr_t = typename GRAPH::edge_ptr_t;
       using waiting_t = WAITING<node_ptr_t>;
     public:
+      /*!
+       \brief Constructor
+       \param keep_edges : edges flag
+       \param keep_parents : parents flag
+       \post this algorithm stores edges in the graph if keep_edges is true. Otherwise, the graph only stores
+       the nodes, which is enough to decide reachability and saves the memory of edges. Each node points to its
+       parent node (i.e. the node it has been computed from) if keep_parents is true, which allows to compute a
+       trace to the accepting node
+       */
+      explicit algorithm_t(bool keep_edges = true, bool keep_parents = false)
+      : _keep_edges(keep_edges), _keep_parents(keep_parents)
+      {}
+      
+      /*!
+       \brief Copy constructor
+       */
+      algorithm_t(tchecker::covreach::algorithm_t<TS, GRAPH, WAITING> const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      algorithm_t(tchecker::covreach::algorithm_t<TS, GRAPH, WAITING> &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~algorithm_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::algorithm_t<TS, GRAPH, WAITING> &
+      operator= (tchecker::covreach::algorithm_t<TS, GRAPH, WAITING> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::algorithm_t<TS, GRAPH, WAITING> &
+      operator= (tchecker::covreach::algorithm_t<TS, GRAPH, WAITING> &&) = default;
+      
       /*!
        \brief Reachability algorithm with node covering
        \param ts : a transition system
@@ -71,7 +112,8 @@ namespace tchecker {
        \post this algorithm visits ts and builds graph. Graph stores the maximal nodes in ts and edges
        between them. There are two kind of edges: actual edges which correspond to a transition in ts,
        and abstract edges. There is an abstract edge n1->n2 when the actual successor of n1 in ts is
-       smaller than n2 (for some n2 in the graph). The order in which the states of ts are visited
+       smaller than n2 (for some n2 in the graph). Edges are only stored if this algorithm has been built with
+       keep_edges set to true. The order in which the states of ts are visited
        depends on the policy implemented by WAITING.
        The algorithms stops when an accepting node has been found, or when the graph has been entirely
        visited.
@@ -81,8 +123,50 @@ namespace tchecker {
       std::tuple<enum tchecker::covreach::outcome_t, tchecker::covreach::stats_t>
       run(TS & ts, GRAPH & graph, tchecker::covreach::accepting_condition_t<node_ptr_t> accepting)
       {
-        tchecker::covreach::builder_t<TS, ts_allocator_t> builder(ts, graph.ts_allocator());
+        node_ptr_t accepting_node{nullptr};
+        return run(ts, graph, accepting, accepting_node);
+      }
+      
+      
+      /*!
+       \brief Reachability algorithm with node covering
+       \param ts : a transition system
+       \param graph : a graph
+       \param accepting : an accepting function over nodes
+       \param accepting_node : a node
+       \pre see run(ts, graph, accepting)
+       \post see run(ts, graph, accepting). Moreover, accepting_node points to the accepting node that has been
+       found if any, and to nullptr otherwise
+       \return REACHABLE if TS has an accepting run, UNREACHABLE otherwise
+       \note accepting_node should be released before graph is freed
+       */
+      std::tuple<enum tchecker::covreach::outcome_t, tchecker::covreach::stats_t>
+      run(TS & ts, GRAPH & graph, tchecker::covreach::accepting_condition_t<node_ptr_t> accepting,
+          node_ptr_t & accepting_node)
+      {
         waiting_t waiting;
+        return run(ts, graph, accepting, waiting, accepting_node);
+      }
+      
+      
+      /*!
+       \brief Reachability algorithm with node covering
+       \param ts : a transition system
+       \param graph : a graph
+       \param accepting : an accepting function over nodes
+       \param waiting : a waiting container
+       \param accepting_node : a node
+       \pre see run(ts, graph, accepting). waiting is empty
+       \post see run(ts, graph, accepting, accepting_node). The nodes have been visited following the policy of
+       waiting
+       \return REACHABLE if TS has an accepting run, UNREACHABLE otherwise
+       \note this allows waiting containers that are not default constructible (e.g. priority waiting containers)
+       */
+      std::tuple<enum tchecker::covreach::outcome_t, tchecker::covreach::stats_t>
+      run(TS & ts, GRAPH & graph, tchecker::covreach::accepting_condition_t<node_ptr_t> accepting, waiting_t & waiting,
+          node_ptr_t & accepting_node)
+      {
+        tchecker::covreach::builder_t<TS, ts_allocator_t> builder(ts, graph.ts_allocator());
         node_ptr_t node{nullptr}, next_node{nullptr}, covering_node{nullptr};
         std::vector<node_ptr_t> nodes, covered_nodes;
         auto covered_nodes_inserter = std::back_inserter(covered_nodes);
@@ -101,12 +185,15 @@ namespace tchecker {
           
           stats.increment_visited_nodes();
           
-          if (accepting(node))
+          if (accepting(node)) {
+            accepting_node = node;
             return std::make_tuple(tchecker::covreach::REACHABLE, stats);
+          }
           
           // expand node
           nodes.clear();
           expand_node(node, builder, graph, nodes);
+          node->make_expanded();
           
           // remove small nodes
           for (node_ptr_t & next_node : nodes) {
@@ -120,19 +207,28 @@ namespace tchecker {
               continue;
             }
             
-            waiting.insert(next_node);
+            // successors inherit the rank of node, and nodes that cover expanded nodes get a higher rank
+            unsigned rank = 0;
             
             covered_nodes.clear();
             graph.covered_nodes(next_node, covered_nodes_inserter);
             for (node_ptr_t & covered_node : covered_nodes) {
+              if (covered_node->is_expanded()) {
+                rank = std::max(rank, covered_node->rank() + 1);
+                stats.increment_expanded_covered_nodes();
+              }
               waiting.remove(covered_node);
               cover_node(covered_node, next_node, graph);
               covered_node->make_inactive();
               stats.increment_covered_nonleaf_nodes();
             }
+            
+            next_node->set_rank(rank);
+            waiting.insert(next_node);
           }
         }
         
+        accepting_node = nullptr;
         return std::make_tuple(tchecker::covreach::UNREACHABLE, stats);
       }
       
@@ -168,7 +264,9 @@ namespace tchecker {
        \param builder : a transition system builder
        \param graph : a graph
        \param nodes : a vector of nodes
-       \post the successor nodes of n provided by builder have been added to graph and to nodes
+       \post the successor nodes of n provided by builder have been added to graph and to nodes. Actual edges from
+       node to its successor nodes have been added to graph if edges are kept. node is the parent of its successor
+       nodes if parents are kept
        */
       void expand_node(node_ptr_t & node, tchecker::covreach::builder_t<TS, ts_allocator_t> & builder, GRAPH & graph,
                        std::vector<node_ptr_t> & nodes)
@@ -182,7 +280,10 @@ namespace tchecker {
           assert(next_node != node_ptr_t{nullptr});
           
           graph.add_node(next_node);
-          graph.add_edge(node, next_node, tchecker::covreach::ACTUAL_EDGE);
+          if (_keep_parents)
+            next_node->set_parent(node);
+          if (_keep_edges)
+            graph.add_edge(node, next_node, tchecker::covreach::ACTUAL_EDGE);
           
           nodes.push_back(next_node);
         }
@@ -198,10 +299,15 @@ namespace tchecker {
        */
       void cover_node(node_ptr_t & covered_node, node_ptr_t & covering_node, GRAPH & graph)
       {
-        graph.move_incoming_edges(covered_node, covering_node, tchecker::covreach::ABSTRACT_EDGE);
-        graph.remove_edges(covered_node);
+        if (_keep_edges) {
+          graph.move_incoming_edges(covered_node, covering_node, tchecker::covreach::ABSTRACT_EDGE);
+          graph.remove_edges(covered_node);
+        }
         graph.remove_node(covered_node);
       }
+    private:
+      bool _keep_edges;     /*!< Edges flag */
+      bool _keep_parents;   /*!< Parents flag */
     };
     
   } // end of namespace covreach
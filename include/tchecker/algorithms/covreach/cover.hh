@@ -9,6 +9,7 @@
 #define TCHECKER_ALGORITHMS_COVREACH_COVER_HH
 
 #include <cassert>
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 
@@ -105,6 +106,16 @@ namespace tchecker {
         {
           return (n1->zone() <= n2->zone());
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return inclusion signature of the zone in n (see tchecker::dbm::signature)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return n->zone().signature();
+        }
       };
       
       
@@ -172,6 +183,16 @@ namespace tchecker {
         {
           return n1->zone().alu_le(n2->zone(), _L.get(), _U.get());
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return 0 (no pruning: aLU-inclusion does not entail the ordering of inclusion signatures)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return 0;
+        }
       private:
         std::reference_wrapper<tchecker::clockbounds::map_t const> _L;  /*!< global L clock bounds map */
         std::reference_wrapper<tchecker::clockbounds::map_t const> _U;  /*!< global U clock bounds map */
@@ -282,6 +303,16 @@ namespace tchecker {
           tchecker::clockbounds::vloc_bounds(_local_lu_map.get(), n2->vloc(), *_L, *_U);
           return n1->zone().alu_le(n2->zone(), *_L, *_U);
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return 0 (no pruning: aLU-inclusion does not entail the ordering of inclusion signatures)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return 0;
+        }
       private:
         std::reference_wrapper<tchecker::clockbounds::local_lu_map_t const> _local_lu_map; /*!< Local LU clockbounds map */
         tchecker::clockbounds::map_t * _L;                                                 /*!< L clock bounds map */
@@ -353,6 +384,16 @@ namespace tchecker {
         {
           return n1->zone().am_le(n2->zone(), _M.get());
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return 0 (no pruning: aM-inclusion does not entail the ordering of inclusion signatures)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return 0;
+        }
       private:
         std::reference_wrapper<tchecker::clockbounds::map_t const> _M;  /*!< global M clock bounds map */
       };
@@ -453,6 +494,16 @@ namespace tchecker {
           tchecker::clockbounds::vloc_bounds(_local_m_map.get(), n2->vloc(), *_M);
           return n1->zone().am_le(n2->zone(), *_M);
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return 0 (no pruning: aM-inclusion does not entail the ordering of inclusion signatures)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return 0;
+        }
       private:
         std::reference_wrapper<tchecker::clockbounds::local_m_map_t const> _local_m_map;  /*!< Local M clockbounds map */
         tchecker::clockbounds::map_t * _M;                                                /*!< M clock bounds map */
@@ -520,6 +571,16 @@ namespace tchecker {
         {
           return (n1->sync_zone() <= n2->sync_zone());
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return inclusion signature of the zone in n (see tchecker::dbm::signature)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return n->sync_zone().signature();
+        }
       };
       
       
@@ -593,6 +654,17 @@ namespace tchecker {
                   && STATE_PREDICATE::operator()(n1, n2)
                   && ZONE_PREDICATE::operator()(n1, n2));
         }
+        
+        /*!
+         \brief Signature
+         \param n : a node
+         \return signature of n w.r.t. ZONE_PREDICATE
+         \note if (*this)(n1, n2) holds, then all the bits set in signature(n2) are also set in signature(n1)
+         */
+        std::uint64_t signature(NODE_PTR const & n) const
+        {
+          return ZONE_PREDICATE::signature(n);
+        }
       };
       
     } // end of namespace details
@@ -664,7 +736,72 @@ namespace tchecker {
     using cover_sync_inclusion_t
     = tchecker::covreach::details::cover_node_t
     <NODE_PTR, STATE_PREDICATE, tchecker::covreach::details::cover_sync_zone_inclusion_t<NODE_PTR>>;
-    
+
+
+
+
+    /*!
+     \class cover_node_signature_t
+     \brief Map : node -> signature w.r.t. a node covering
+     \tparam COVER_NODE : type of node covering (see tchecker::covreach::details::cover_node_t)
+     \note this map can be used as node-to-signature map in tchecker::graph::cover::graph_t
+     */
+    template <class COVER_NODE>
+    class cover_node_signature_t {
+    public:
+      /*!
+       \brief Type of pointer to node
+       */
+      using node_ptr_t = typename COVER_NODE::node_ptr_t;
+
+      /*!
+       \brief Constructor
+       \param cover_node : a node covering
+       \post this computes signatures w.r.t. a copy of cover_node
+       */
+      cover_node_signature_t(COVER_NODE const & cover_node) : _cover_node(cover_node)
+      {}
+
+      /*!
+       \brief Copy constructor
+       */
+      cover_node_signature_t(tchecker::covreach::cover_node_signature_t<COVER_NODE> const &) = default;
+
+      /*!
+       \brief Move constructor
+       */
+      cover_node_signature_t(tchecker::covreach::cover_node_signature_t<COVER_NODE> &&) = default;
+
+      /*!
+       \brief Destructor
+       */
+      ~cover_node_signature_t() = default;
+
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::cover_node_signature_t<COVER_NODE> &
+      operator= (tchecker::covreach::cover_node_signature_t<COVER_NODE> const &) = default;
+
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::cover_node_signature_t<COVER_NODE> &
+      operator= (tchecker::covreach::cover_node_signature_t<COVER_NODE> &&) = default;
+
+      /*!
+       \brief Signature
+       \param n : a node
+       \return signature of n w.r.t. the node covering
+       */
+      inline std::uint64_t operator() (node_ptr_t const & n) const
+      {
+        return _cover_node.signature(n);
+      }
+    private:
+      COVER_NODE _cover_node;   /*!< Node covering */
+    };
+
   } // end of namespace covreach
   
 } // end of namespace tchecker
@@ -264,11 +264,75 @@ namespace tchecker {
       
       /*!
        \brief Type of nodes
+       \note nodes have a parent node, that is only set when a trace is requested. The parent node is kept
+       alive by its children, even when it has been removed from the graph (e.g. covered node)
+       \note nodes have a rank, used by the ranking search order (see tchecker::covreach::ranking_priority_t), and
+       an expanded flag that is set once their successors have been computed
        */
       template <class STATE>
       class node_impl_t : public tchecker::covreach::node_t<STATE, edge_ptr_t<STATE>> {
       public:
         using tchecker::covreach::node_t<STATE, edge_ptr_t<STATE>>::node_t;
+        
+        /*!
+         \brief Accessor
+         \return parent node of this node, nullptr if this node has no parent
+         */
+        inline node_ptr_t<STATE> const & parent() const
+        {
+          return _parent;
+        }
+        
+        /*!
+         \brief Set parent node
+         \param parent : a node
+         \post parent is the parent node of this node
+         */
+        inline void set_parent(node_ptr_t<STATE> const & parent)
+        {
+          _parent = parent;
+        }
+        
+        /*!
+         \brief Accessor
+         \return rank of this node
+         */
+        inline unsigned rank() const
+        {
+          return _rank;
+        }
+        
+        /*!
+         \brief Set rank
+         \param rank : a rank
+         \post rank is the rank of this node
+         */
+        inline void set_rank(unsigned rank)
+        {
+          _rank = rank;
+        }
+        
+        /*!
+         \brief Accessor
+         \return true if this node has been expanded, false otherwise
+         */
+        inline bool is_expanded() const
+        {
+          return _expanded;
+        }
+        
+        /*!
+         \brief Set expanded flag
+         \post this node is expanded
+         */
+        inline void make_expanded()
+        {
+          _expanded = true;
+        }
+      protected:
+        node_ptr_t<STATE> _parent;   /*!< Parent node */
+        unsigned _rank{0};           /*!< Rank */
+        bool _expanded{false};       /*!< Expanded flag */
       };
       
       /*!
@@ -360,15 +424,29 @@ namespace tchecker {
      \tparam TS : type of transition system (see tchecker::ts::ts_t)
      \param TS_ALLOCATOR : type of allocator of transition system (see tchecker::ts::allocator_t), should be garbage collected,
      should allocates nodes
+     \tparam NODE_TO_KEY : type of map : node -> key (see tchecker::graph::cover::graph_t)
+     \tparam LE_NODE : type of less-or-equal predicate on nodes (see tchecker::graph::cover::graph_t)
+     \tparam NODE_TO_SIGNATURE : type of map : node -> signature (see tchecker::graph::cover::graph_t)
      */
-    template <class KEY, class TS, class TS_ALLOCATOR>
+    template <class KEY,
+    class TS,
+    class TS_ALLOCATOR,
+    class NODE_TO_KEY=tchecker::graph::cover::node_to_key_t<KEY, typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t>,
+    class LE_NODE=tchecker::graph::cover::node_binary_predicate_t<typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t>,
+    class NODE_TO_SIGNATURE=tchecker::graph::cover::node_to_signature_t<typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t>
+    >
     class graph_t
     : public tchecker::covreach::details::graph_types_t<TS>,
-    private tchecker::graph::cover::graph_t<typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t, KEY>,
+    private tchecker::graph::cover::graph_t<typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE>,
     private tchecker::graph::directed::graph_t
     <typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t,
     typename tchecker::covreach::details::graph_types_t<TS>::edge_ptr_t>
     {
+      /*!
+       \brief Type of cover graph
+       */
+      using cover_graph_t
+      = tchecker::graph::cover::graph_t<typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE>;
     public:
       /*!
        \brief Type of key
@@ -408,12 +486,17 @@ namespace tchecker {
       /*!
        \brief Type of map : node -> key
        */
-      using node_to_key_t = typename tchecker::graph::cover::node_to_key_t<key_t, node_ptr_t>;
+      using node_to_key_t = NODE_TO_KEY;
       
       /*!
        \brief Type of less-or-equal predicate on nodes
        */
-      using node_binary_predicate_t = typename tchecker::graph::cover::node_binary_predicate_t<node_ptr_t>;
+      using node_binary_predicate_t = LE_NODE;
+      
+      /*!
+       \brief Type of map : node -> signature
+       */
+      using node_to_signature_t = NODE_TO_SIGNATURE;
       
       // TS_ALLOCATOR should allocate nodes
       static_assert( std::is_same<typename TS_ALLOCATOR::state_t, node_t>::value, "" );
@@ -426,6 +509,8 @@ namespace tchecker {
        \param table_size : size of the nodes table (see tchecker::graph::cover_graph_t)
        \param node_to_key : a map that associates keys to nodes (see tchecker::graph::cover_graph_t)
        \param le_node : less-than-or-equal-to predicate on nodes
+       \param node_to_signature : a map that associates signatures to nodes, consistent with le_node
+       (see tchecker::graph::cover_graph_t)
        \post this owns a transition system allocator of type TS_ALLOCATOR built from args and an edge allocator built
        from block_size. The nodes of the graph are built directly using TS_ALLOCATOR. The allocators have been enrolled
        to gc. In order to answer node covering queries, nodes are stored in a table with table_size entries. Each entry
@@ -437,10 +522,12 @@ namespace tchecker {
               std::size_t block_size,
               std::size_t table_size,
               node_to_key_t node_to_key,
-              node_binary_predicate_t le_node)
-      : tchecker::graph::cover::graph_t<node_ptr_t, key_t>(table_size,
-                                                           std::forward<node_to_key_t>(node_to_key),
-                                                           std::forward<node_binary_predicate_t>(le_node)),
+              node_binary_predicate_t le_node,
+              node_to_signature_t node_to_signature = tchecker::graph::cover::empty_signature<node_ptr_t>)
+      : cover_graph_t(table_size,
+                      std::forward<node_to_key_t>(node_to_key),
+                      std::forward<node_binary_predicate_t>(le_node),
+                      std::forward<node_to_signature_t>(node_to_signature)),
       _ts_allocator(std::forward<std::tuple<ARGS...>>(ts_alloc_args)),
       _edge_allocator(block_size, tchecker::allocation_size_t<edge_t>::alloc_size())
       {
@@ -451,12 +538,12 @@ namespace tchecker {
       /*!
        \brief Copy constructor (deleted)
        */
-      graph_t(tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR> const &) = delete;
+      graph_t(tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> const &) = delete;
       
       /*!
        \brief Move constructor (deleted)
        */
-      graph_t(tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR> &&) = delete;
+      graph_t(tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &&) = delete;
       
       /*!
        \brief Destructor
@@ -470,14 +557,14 @@ namespace tchecker {
       /*!
        \brief Assignment operator (deleted)
        */
-      tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR> &
-      operator= (tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR> const &) = delete;
+      tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &
+      operator= (tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> const &) = delete;
       
       /*!
        \brief Move-assignment operator (deleted)
        */
-      tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR> &
-      operator= (tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR> &&) = delete;
+      tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &
+      operator= (tchecker::covreach::graph_t<KEY, TS, TS_ALLOCATOR, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &&) = delete;
       
       /*!
        \brief Clear
@@ -487,12 +574,9 @@ namespace tchecker {
        */
       void clear()
       {
-        using cover_graph_t
-        = tchecker::graph::cover::graph_t<typename tchecker::covreach::details::graph_types_t<TS>::node_ptr_t, KEY>;
-        
         tchecker::graph::directed::graph_t<node_ptr_t, edge_ptr_t>::clear(cover_graph_t::begin(), cover_graph_t::end());
         _root_nodes.clear();
-        tchecker::graph::cover::graph_t<node_ptr_t, key_t>::clear();
+        cover_graph_t::clear();
       }
       
       /*!
@@ -532,7 +616,7 @@ namespace tchecker {
        */
       void add_node(node_ptr_t const & n, bool root_node = false)
       {
-        tchecker::graph::cover::graph_t<node_ptr_t, key_t>::add_node(n);
+        cover_graph_t::add_node(n);
         if (root_node) {
           n->make_protected();
           _root_nodes.push_back(n);
@@ -564,7 +648,7 @@ namespace tchecker {
       void remove_node(node_ptr_t const & n)
       {
         assert( ! connected(n) );
-        tchecker::graph::cover::graph_t<node_ptr_t, key_t>::remove_node(n);
+        cover_graph_t::remove_node(n);
       }
       
       /*!
@@ -606,7 +690,7 @@ namespace tchecker {
        */
       bool is_covered(node_ptr_t const & n, node_ptr_t & covering_node) const
       {
-        return tchecker::graph::cover::graph_t<node_ptr_t, key_t>::is_covered(n, covering_node);
+        return cover_graph_t::is_covered(n, covering_node);
       }
       
       /*!
@@ -619,7 +703,7 @@ namespace tchecker {
       template <class INSERTER>
       void covered_nodes(node_ptr_t const & n, INSERTER & ins) const
       {
-        return tchecker::graph::cover::graph_t<node_ptr_t, key_t>::covered_nodes(n, ins);
+        return cover_graph_t::covered_nodes(n, ins);
       }
       
       /*!
@@ -705,17 +789,71 @@ namespace tchecker {
        */
       std::size_t nodes_count() const
       {
-        return tchecker::graph::cover::graph_t<node_ptr_t, key_t>::nodes_count();
+        return cover_graph_t::nodes_count();
+      }
+      
+      /*!
+       \brief Accessor
+       \return Memory used by the edges of this graph (in bytes)
+       */
+      std::size_t edges_memsize() const
+      {
+        return _edge_allocator.memsize();
+      }
+      
+      /*!
+       \brief Accessor
+       \return Size of the nodes table
+       */
+      std::size_t table_size() const
+      {
+        return cover_graph_t::table_size();
+      }
+      
+      /*!
+       \brief Accessor
+       \return Number of nodes in the biggest entry of the nodes table
+       */
+      std::size_t max_container_size() const
+      {
+        return cover_graph_t::max_container_size();
+      }
+      
+      /*!
+       \brief Accessor
+       \return Number of non-empty entries in the nodes table
+       */
+      std::size_t nonempty_containers_count() const
+      {
+        return cover_graph_t::nonempty_containers_count();
+      }
+      
+      /*!
+       \brief Accessor
+       \return Number of covering checks
+       */
+      unsigned long cover_checks() const
+      {
+        return cover_graph_t::cover_checks();
+      }
+      
+      /*!
+       \brief Accessor
+       \return Number of avoided covering checks
+       */
+      unsigned long avoided_cover_checks() const
+      {
+        return cover_graph_t::avoided_cover_checks();
       }
 
-      using const_iterator_t = typename tchecker::graph::cover::graph_t<node_ptr_t, key_t>::const_iterator_t;
+      using const_iterator_t = typename cover_graph_t::const_iterator_t;
 
       const_iterator_t begin () const {
-        return tchecker::graph::cover::graph_t<node_ptr_t, key_t>::begin ();
+        return cover_graph_t::begin ();
       }
 
       const_iterator_t end () const {
-        return tchecker::graph::cover::graph_t<node_ptr_t, key_t>::end ();
+        return cover_graph_t::end ();
       }
 
     private:
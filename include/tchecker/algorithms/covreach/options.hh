@@ -72,6 +72,10 @@ namespace tchecker {
       enum search_order_t {
         BFS,
         DFS,
+        BEST_FIRST,
+        DISTANCE,
+        RANDOM,
+        RANKING,
       };
       
       /*!
@@ -102,8 +106,17 @@ namespace tchecker {
       _os(&std::cout),
       _search_order(tchecker::covreach::options_t::DFS),
       _block_size(10000),
-      _nodes_table_size(65536),
-      _stats(0)
+      _nodes_table_size(0),
+      _native_code_dir(""),
+      _threads(1),
+      _stats(0),
+      _detailed_stats(0),
+      _share_components(0),
+      _share_zones(0),
+      _packed_intvars(0),
+      _flat_states(0),
+      _verdict_only(0),
+      _trace(0)
       {
         auto it = range.begin(), end = range.end();
         for ( ; it != end; ++it )
@@ -185,16 +198,70 @@ namespace tchecker {
       
       /*!
        \brief Accessor
-       \return nodes table size
+       \return nodes table size, 0 if the nodes table size should be estimated from the model
        */
       std::size_t nodes_table_size() const;
       
+      /*!
+       \brief Accessor
+       \return cache directory for native code, empty if bytecode should be interpreted
+       */
+      std::string const & native_code_dir() const;
+      
+      /*!
+       \brief Accessor
+       \return number of worker threads
+       */
+      std::size_t threads() const;
+      
       /*!
        \brief Accessor
        \return true if stats should be output, false otherwise
        */
       bool stats() const;
       
+      /*!
+       \brief Accessor
+       \return true if detailed stats (on internal data structures) should be output, false otherwise
+       */
+      bool detailed_stats() const;
+      
+      /*!
+       \brief Accessor
+       \return true if nodes should share equal tuples of locations and integer variables valuations, false otherwise
+       */
+      bool share_components() const;
+      
+      /*!
+       \brief Accessor
+       \return true if nodes should share equal zones, false otherwise
+       */
+      bool share_zones() const;
+      
+      /*!
+       \brief Accessor
+       \return true if integer variables valuations should be packed in nodes, false otherwise
+       */
+      bool packed_intvars() const;
+      
+      /*!
+       \brief Accessor
+       \return true if nodes should be allocated with their components in a single chunk, false otherwise
+       */
+      bool flat_states() const;
+      
+      /*!
+       \brief Accessor
+       \return true if only the verdict should be computed (no edge in the graph), false otherwise
+       */
+      bool verdict_only() const;
+      
+      /*!
+       \brief Accessor
+       \return true if a trace to the accepting node should be output, false otherwise
+       */
+      bool trace() const;
+      
       /*!
        \brief Check that mandatory options have been set
        \param log : a logging facility
@@ -205,7 +272,7 @@ namespace tchecker {
       /*!
        \brief Short options string (getopt_long format)
        */
-      static constexpr char const * const getopt_long_options = "c:f:hl:m:o:s:S";
+      static constexpr char const * const getopt_long_options = "c:f:hj:l:m:o:s:S";
       
       /*!
        \brief Long options (getopt_long format)
@@ -215,6 +282,7 @@ namespace tchecker {
         {"cover",        required_argument, 0, 'c'},
         {"format",       required_argument, 0, 'f'},
         {"help",         no_argument,       0, 'h'},
+        {"threads",      required_argument, 0, 'j'},
         {"labels",       required_argument, 0, 'l'},
         {"model",        required_argument, 0, 'm'},
         {"output",       required_argument, 0, 'o'},
@@ -222,6 +290,14 @@ namespace tchecker {
         {"stats",        no_argument,       0, 'S'},
         {"block-size",   required_argument, 0, 0},
         {"table-size",   required_argument, 0, 0},
+        {"detailed-stats", no_argument,     0, 0},
+        {"share-components", no_argument,   0, 0},
+        {"share-zones",    no_argument,     0, 0},
+        {"packed-intvars", no_argument,     0, 0},
+        {"flat-states",    no_argument,     0, 0},
+        {"native-code",    required_argument, 0, 0},
+        {"verdict-only",   no_argument,     0, 0},
+        {"trace",          no_argument,     0, 0},
         {0, 0, 0, 0}
       };
       
@@ -340,6 +416,24 @@ namespace tchecker {
        */
       void set_nodes_table_size(std::string const & value, tchecker::log_t & log);
       
+      /*!
+       \brief Set native code cache directory
+       \param value : option value
+       \param log : logging facility
+       \post native code cache directory has been set to value.
+       An error has been reported to log if value is not admissible.
+       */
+      void set_native_code_dir(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set number of worker threads
+       \param value : option value
+       \param log : logging facility
+       \post number of worker threads has been set to value.
+       An error has been reported to log if value is not admissible.
+       */
+      void set_threads(std::string const & value, tchecker::log_t & log);
+      
       /*!
        \brief Set stats flag
        \param value : option value
@@ -348,6 +442,62 @@ namespace tchecker {
        */
       void set_stats(std::string const & value, tchecker::log_t & log);
       
+      /*!
+       \brief Set detailed stats flag
+       \param value : option value
+       \param log : logging facility
+       \post stats flag and detailed stats flag have been set
+       */
+      void set_detailed_stats(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set sharing flag for tuples of locations and integer variables valuations
+       \param value : option value
+       \param log : logging facility
+       \post sharing flag has been set
+       */
+      void set_share_components(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set sharing flag for zones
+       \param value : option value
+       \param log : logging facility
+       \post zone sharing flag has been set
+       */
+      void set_share_zones(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set packing flag for integer variables valuations
+       \param value : option value
+       \param log : logging facility
+       \post packing flag has been set
+       */
+      void set_packed_intvars(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set flat layout flag for nodes
+       \param value : option value
+       \param log : logging facility
+       \post flat layout flag has been set
+       */
+      void set_flat_states(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set verdict-only flag
+       \param value : option value
+       \param log : logging facility
+       \post verdict-only flag has been set
+       */
+      void set_verdict_only(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set trace flag
+       \param value : option value
+       \param log : logging facility
+       \post trace flag has been set
+       */
+      void set_trace(std::string const & value, tchecker::log_t & log);
+      
       enum node_covering_t _node_covering;         /*!< Node covering */
       enum output_format_t _output_format;         /*!< Output format */
       std::vector<std::string> _accepting_labels;  /*!< Accepting labels */
@@ -355,8 +505,17 @@ namespace tchecker {
       std::ostream * _os;                          /*!< Output stream */
       enum search_order_t _search_order;           /*!< Search order */
       std::size_t _block_size;                     /*!< Size of allocation blocks */
-      std::size_t _nodes_table_size;               /*!< Size of nodes table */
+      std::size_t _nodes_table_size;               /*!< Size of nodes table (0: estimated from the model) */
+      std::string _native_code_dir;                /*!< Cache directory of native code (empty: no native code) */
+      std::size_t _threads;                        /*!< Number of worker threads */
       unsigned _stats : 1;                         /*!< Statistics */
+      unsigned _detailed_stats : 1;                /*!< Detailed statistics */
+      unsigned _share_components : 1;              /*!< Sharing of tuples of locations and integer valuations */
+      unsigned _share_zones : 1;                   /*!< Sharing of zones */
+      unsigned _packed_intvars : 1;                /*!< Packing of integer variables valuations */
+      unsigned _flat_states : 1;                   /*!< Flat layout of nodes */
+      unsigned _verdict_only : 1;                  /*!< Verdict only (no edge in the graph) */
+      unsigned _trace : 1;                         /*!< Trace to the accepting node */
     };
     
   } // end of namespace covreach
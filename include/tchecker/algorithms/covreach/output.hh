@@ -8,13 +8,17 @@
 #ifndef TCHECKER_ALGORITHMS_COVREACH_OUTPUT_HH
 #define TCHECKER_ALGORITHMS_COVREACH_OUTPUT_HH
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <stack>
+#include <stdexcept>
 #include <tuple>
 #include <unordered_set>
+#include <vector>
 
 #include "tchecker/algorithms/covreach/graph.hh"
+#include "tchecker/ts/builder.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/utils/ordering.hh"
 
@@ -195,6 +199,143 @@ namespace tchecker {
       NODE_OUTPUTTER _node_outputter;  /*!< Outputter of nodes */
     };
 
+
+
+
+    /*!
+     \class trace_outputter_t
+     \brief Output a symbolic run from a root node to a node, following parent nodes
+     \tparam NODE_OUTPUTTER : type of node outputter
+     \note the tuples of edges along the run are not stored: they are recovered by recomputing the successors
+     of each node on the run. Hence, the run only costs one pointer to the parent node in each node
+     */
+    template <class NODE_OUTPUTTER>
+    class trace_outputter_t {
+    public:
+      /*!
+       \brief Constructor
+       \param args : arguments to a constructor of NODE_OUTPUTTER
+       */
+      template <class ... ARGS>
+      explicit trace_outputter_t(std::tuple<ARGS...> args)
+      : _node_outputter(std::make_from_tuple<NODE_OUTPUTTER>(args))
+      {}
+
+      /*!
+       \brief Copy constructor
+       */
+      trace_outputter_t(tchecker::covreach::trace_outputter_t<NODE_OUTPUTTER> const &) = default;
+
+      /*!
+       \brief Move constructor
+       */
+      trace_outputter_t(tchecker::covreach::trace_outputter_t<NODE_OUTPUTTER> &&) = default;
+
+      /*!
+       \brief Destructor
+       */
+      ~trace_outputter_t() = default;
+
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::trace_outputter_t<NODE_OUTPUTTER> &
+      operator= (tchecker::covreach::trace_outputter_t<NODE_OUTPUTTER> const &) = default;
+
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::trace_outputter_t<NODE_OUTPUTTER> &
+      operator= (tchecker::covreach::trace_outputter_t<NODE_OUTPUTTER> &&) = default;
+
+      /*!
+       \brief Trace output
+       \tparam NODE_LT : type of total ordering on NODE_PTR, should be a total ordering on states (e.g. using
+       tchecker::lexical_cmp)
+       \tparam TS : type of transition system, should derive from tchecker::ts::ts_t
+       \tparam TS_ALLOCATOR : type of allocator of transition system, should allocate nodes
+       \tparam NODE_PTR : type of pointer to node, should derive from tchecker::covreach::details::node_impl_t
+       \tparam SYSTEM : type of system, should derive from tchecker::system_t
+       \param os : output stream
+       \param node : a node
+       \param ts : a transition system
+       \param ts_allocator : an allocator of states and transitions of ts
+       \param system : system of ts
+       \pre node and its ancestors have been computed from ts, and the parent of each node has been kept (see
+       tchecker::covreach::algorithm_t)
+       \post the run from a root node to node, obtained following parent nodes, has been output to os: each node
+       on the run is output as "i: node", and the tuple of edges from the i-th node to the (i+1)-th node is output
+       as "i -> i+1 <process@event,...>". The successors computed to recover the tuples of edges have been
+       allocated by ts_allocator
+       \return os after output
+       \throw std::runtime_error : if the tuple of edges from a node to the next node on the run cannot be found
+       */
+      template <class NODE_LT, class TS, class TS_ALLOCATOR, class NODE_PTR, class SYSTEM>
+      std::ostream & output(std::ostream & os, NODE_PTR const & node, TS & ts, TS_ALLOCATOR & ts_allocator,
+                            SYSTEM const & system)
+      {
+        std::vector<NODE_PTR> run;
+        for (NODE_PTR n = node; n != NODE_PTR{nullptr}; n = n->parent())
+          run.push_back(n);
+        std::reverse(run.begin(), run.end());
+
+        tchecker::ts::builder_t<TS, TS_ALLOCATOR> builder(ts, ts_allocator);
+
+        for (std::size_t i = 0; i < run.size(); ++i) {
+          if (i > 0) {
+            os << i - 1 << " -> " << i << " ";
+            output_vedge<NODE_LT>(os, run[i - 1], run[i], ts, builder, system);
+            os << std::endl;
+          }
+          os << i << ": ";
+          _node_outputter.output(os, *run[i]);
+          os << std::endl;
+        }
+
+        os.flush();
+
+        return os;
+      }
+    private:
+      /*!
+       \brief Output the tuple of edges from a node to a successor node
+       \post the first tuple of edges of src that yields a state equal to tgt has been output to os
+       \throw std::runtime_error : if no tuple of edges of src yields a state equal to tgt
+       */
+      template <class NODE_LT, class TS, class TS_ALLOCATOR, class NODE_PTR, class SYSTEM>
+      void output_vedge(std::ostream & os, NODE_PTR & src, NODE_PTR const & tgt, TS & ts,
+                        tchecker::ts::builder_t<TS, TS_ALLOCATOR> & builder, SYSTEM const & system)
+      {
+        NODE_LT node_lt;
+        typename TS_ALLOCATOR::state_ptr_t next_state{nullptr};
+        typename TS_ALLOCATOR::transition_ptr_t transition{nullptr};
+        tchecker::state_status_t status;
+
+        auto outgoing_range = ts.outgoing_edges(*src);
+        for (auto it = outgoing_range.begin(); ! it.at_end(); ++it) {
+          auto vedge = *it;
+          std::tie(next_state, transition, status) = builder.next_state(src, vedge, std::make_tuple(), std::make_tuple());
+          if ((status != tchecker::STATE_OK) || node_lt(next_state, tgt) || node_lt(tgt, next_state))
+            continue;
+
+          auto const & process_index = system.processes();
+          auto const & event_index = system.events();
+          os << "<";
+          for (auto edge_it = vedge.begin(); edge_it != vedge.end(); ++edge_it) {
+            if (edge_it != vedge.begin())
+              os << ",";
+            os << process_index.value((*edge_it)->pid()) << "@" << event_index.value((*edge_it)->event_id());
+          }
+          os << ">";
+          return;
+        }
+
+        throw std::runtime_error("no tuple of edges from a node to the next node on the trace");
+      }
+
+      NODE_OUTPUTTER _node_outputter;  /*!< Outputter of nodes */
+    };
+
   } // end of namespace covreach
 
 } // end of namespace tchecker
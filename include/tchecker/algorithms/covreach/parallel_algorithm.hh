@@ -0,0 +1,262 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COVREACH_PARALLEL_ALGORITHM_HH
+#define TCHECKER_ALGORITHMS_COVREACH_PARALLEL_ALGORITHM_HH
+
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/builder.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/algorithms/covreach/waiting.hh"
+#include "tchecker/graph/concurrent_cover_graph.hh"
+
+/*!
+ \file parallel_algorithm.hh
+ \brief Multi-threaded reachability algorithm with covering
+ */
+
+namespace tchecker {
+  
+  namespace covreach {
+    
+    /*!
+     \class parallel_algorithm_t
+     \brief Multi-threaded reachability algorithm with node covering
+     \tparam TS : type of transition system, should derive from tchecker::ts::ts_t
+     \tparam TS_ALLOCATOR : type of allocator of nodes and transitions (see tchecker::covreach::builder_t)
+     \tparam COVER_NODE : type of covering predicate on nodes, should be copy-constructible
+     \tparam NODE_TO_KEY : type of map : node -> key (see tchecker::graph::cover::concurrent_graph_t)
+     \tparam NODE_TO_SIGNATURE : type of map : node -> signature (see tchecker::graph::cover::concurrent_graph_t)
+     \note each worker thread has its own transition system and allocator (hence its own VM), as well as its own
+     copies of the covering predicate and of the accepting condition. Workers share the set of maximal nodes (a
+     tchecker::graph::cover::concurrent_graph_t). Each worker has its own queue of waiting nodes, and steals
+     nodes from the other workers when its queue is empty (see tchecker::covreach::work_stealing_waiting_t)
+     */
+    template <class TS,
+    class TS_ALLOCATOR,
+    class COVER_NODE,
+    class NODE_TO_KEY=tchecker::graph::cover::node_to_key_t<std::size_t, typename COVER_NODE::node_ptr_t>,
+    class NODE_TO_SIGNATURE=tchecker::graph::cover::node_to_signature_t<typename COVER_NODE::node_ptr_t>
+    >
+    class parallel_algorithm_t {
+      using ts_t = TS;
+      using ts_allocator_t = TS_ALLOCATOR;
+      using builder_t = tchecker::covreach::builder_t<TS, TS_ALLOCATOR>;
+      using transition_ptr_t = typename builder_t::transition_ptr_t;
+      using waiting_t = tchecker::covreach::work_stealing_waiting_t<typename builder_t::state_ptr_t>;
+    public:
+      /*!
+       \brief Type of pointers to node
+       */
+      using node_ptr_t = typename builder_t::state_ptr_t;
+      
+      /*!
+       \brief Type of graph
+       */
+      using graph_t = tchecker::graph::cover::concurrent_graph_t<node_ptr_t, std::size_t, NODE_TO_KEY, NODE_TO_SIGNATURE>;
+      
+      /*!
+       \brief Multi-threaded reachability algorithm with node covering
+       \param ts : transition systems, one per worker thread
+       \param ts_allocators : allocators, one per worker thread
+       \param graph : a graph
+       \param cover_node : a covering predicate on nodes
+       \param accepting : an accepting function over nodes
+       \param policy : policy on the queues of waiting nodes of the workers (DFS-like or BFS-like)
+       \pre ts and ts_allocators have the same positive size. accepting is monotonous w.r.t. cover_node (see
+       tchecker::covreach::algorithm_t::run)
+       \post this algorithm visits the transition system with ts.size() worker threads and stores the maximal
+       nodes in graph. No edge is computed. The algorithm stops when an accepting node has been found by some
+       worker, or when all the nodes have been visited
+       \return REACHABLE if the transition system has an accepting run, UNREACHABLE otherwise, and the sum of
+       the statistics of all workers
+       \throw std::invalid_argument : if the precondition on the sizes of ts and ts_allocators is violated
+       \throw any exception thrown by a worker (the other workers are stopped)
+       \note this algorithm may not terminate if graph is not finite
+       */
+      std::tuple<enum tchecker::covreach::outcome_t, tchecker::covreach::stats_t>
+      run(std::vector<std::unique_ptr<TS>> & ts,
+          std::vector<std::unique_ptr<TS_ALLOCATOR>> & ts_allocators,
+          graph_t & graph,
+          COVER_NODE const & cover_node,
+          tchecker::covreach::accepting_condition_t<node_ptr_t> accepting,
+          typename waiting_t::policy_t policy)
+      {
+        if (ts.empty() || (ts.size() != ts_allocators.size()))
+          throw std::invalid_argument("expecting one transition system and one allocator per worker");
+          
+        std::size_t const workers_count = ts.size();
+        waiting_t waiting(workers_count, policy);
+        std::atomic<bool> reachable(false);
+        std::vector<tchecker::covreach::stats_t> stats(workers_count);
+        std::vector<std::exception_ptr> exceptions(workers_count, nullptr);
+        
+        // initial nodes
+        std::vector<node_ptr_t> nodes;
+        expand_initial_nodes(*ts[0], *ts_allocators[0], graph, nodes);
+        for (node_ptr_t const & n : nodes)
+          waiting.insert(0, n);
+        nodes.clear();
+        
+        // explore waiting nodes
+        std::vector<std::thread> workers;
+        for (std::size_t i = 0; i < workers_count; ++i)
+          workers.emplace_back([&, i] () {
+            try {
+              work(i, *ts[i], *ts_allocators[i], graph, cover_node, accepting, waiting, reachable, stats[i]);
+            }
+            catch (...) {
+              exceptions[i] = std::current_exception();
+              waiting.stop();
+            }
+          });
+          
+        for (std::thread & worker : workers)
+          worker.join();
+          
+        waiting.clear();
+        
+        for (std::exception_ptr const & e : exceptions)
+          if (e != nullptr)
+            std::rethrow_exception(e);
+            
+        tchecker::covreach::stats_t total_stats;
+        for (tchecker::covreach::stats_t const & s : stats)
+          total_stats += s;
+          
+        return std::make_tuple((reachable ? tchecker::covreach::REACHABLE : tchecker::covreach::UNREACHABLE),
+                               total_stats);
+      }
+    private:
+      /*!
+       \brief Worker
+       \param worker : worker identifier
+       \param ts : a transition system
+       \param ts_allocator : an allocator
+       \param graph : a graph
+       \param cover_node : a covering predicate on nodes
+       \param accepting : an accepting function over nodes
+       \param waiting : waiting nodes
+       \param reachable : reachability flag
+       \param stats : statistics
+       \post this worker has expanded the nodes taken from waiting (from its own queue, or stolen from other
+       workers) until waiting has been stopped, or until the exploration is over. Successor nodes have been
+       inserted in the queue of this worker. reachable has been set to true and waiting has been stopped if an accepting node
+       has been found. stats have been updated
+       */
+      void work(std::size_t worker, TS & ts, TS_ALLOCATOR & ts_allocator, graph_t & graph,
+                COVER_NODE const & cover_node, tchecker::covreach::accepting_condition_t<node_ptr_t> accepting,
+                waiting_t & waiting, std::atomic<bool> & reachable, tchecker::covreach::stats_t & stats)
+      {
+        builder_t builder(ts, ts_allocator);
+        COVER_NODE le_node(cover_node);
+        node_ptr_t node{nullptr}, covering_node{nullptr};
+        std::vector<node_ptr_t> nodes, covered_nodes;
+        
+        while (waiting.take(worker, node)) {
+          stats.increment_visited_nodes();
+          
+          if (accepting(node)) {
+            reachable = true;
+            waiting.stop();
+            break;
+          }
+          
+          // expand node
+          nodes.clear();
+          expand_node(node, builder, nodes);
+          
+          // remove small nodes
+          for (node_ptr_t & next_node : nodes) {
+            if (! next_node->is_active())
+              continue;
+              
+            covered_nodes.clear();
+            if (! graph.add_node_if_not_covered(next_node, le_node, covering_node, covered_nodes)) {
+              next_node->make_inactive();
+              stats.increment_covered_leaf_nodes();
+              continue;
+            }
+            
+            waiting.insert(worker, next_node);
+            
+            for (node_ptr_t & covered_node : covered_nodes) {
+              waiting.remove(covered_node);
+              stats.increment_covered_nonleaf_nodes();
+            }
+          }
+          
+          waiting.done();
+        }
+        
+        node = nullptr;
+        covering_node = nullptr;
+      }
+      
+      
+      /*!
+       \brief Expand initial nodes
+       \param ts : a transition system
+       \param ts_allocator : an allocator
+       \param graph : a graph
+       \param nodes : a vector of nodes
+       \post the initial nodes of ts have been added to graph and to nodes
+       */
+      void expand_initial_nodes(TS & ts, TS_ALLOCATOR & ts_allocator, graph_t & graph, std::vector<node_ptr_t> & nodes)
+      {
+        builder_t builder(ts, ts_allocator);
+        node_ptr_t node{nullptr};
+        transition_ptr_t transition{nullptr};
+        
+        auto initial_range = builder.initial();
+        for (auto it = initial_range.begin(); ! it.at_end(); ++it) {
+          std::tie(node, transition) = *it;
+          assert(node != node_ptr_t{nullptr});
+          
+          graph.add_node(node);
+          
+          nodes.push_back(node);
+        }
+      }
+      
+      
+      /*!
+       \brief Expand node
+       \param node : a node
+       \param builder : a transition system builder
+       \param nodes : a vector of nodes
+       \post the successor nodes of n provided by builder have been added to nodes
+       */
+      void expand_node(node_ptr_t & node, builder_t & builder, std::vector<node_ptr_t> & nodes)
+      {
+        node_ptr_t next_node{nullptr};
+        transition_ptr_t transition{nullptr};
+        
+        auto outgoing_range = builder.outgoing(node);
+        for (auto it = outgoing_range.begin(); ! it.at_end(); ++it) {
+          std::tie(next_node, transition) = *it;
+          assert(next_node != node_ptr_t{nullptr});
+          
+          nodes.push_back(next_node);
+        }
+      }
+    };
+    
+  } // end of namespace covreach
+  
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COVREACH_PARALLEL_ALGORITHM_HH
@@ -0,0 +1,341 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COVREACH_PRIORITY_HH
+#define TCHECKER_ALGORITHMS_COVREACH_PRIORITY_HH
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/distances/distances.hh"
+#include "tchecker/fsm/details/system.hh"
+
+/*!
+ \file priority.hh
+ \brief Priorities of nodes for covering reachability algorithm (see tchecker::covreach::priority_waiting_t)
+ */
+
+namespace tchecker {
+  
+  namespace covreach {
+    
+    namespace details {
+      
+      /*!
+       \brief Set of labels
+       \tparam LABELS_RANGE : type of range of label names, should dereference to std::string
+       \param index : maps label names to label identifiers
+       \param labels : range of label names
+       \return the set of identifiers of labels
+       \pre index contains labels
+       */
+      template <class LABELS_RANGE>
+      boost::dynamic_bitset<> labels_set(tchecker::label_index_t const & index, LABELS_RANGE const & labels)
+      {
+        boost::dynamic_bitset<> set(index.size());
+        for (std::string const & label : labels)
+          set[index.key(label)] = 1;
+        return set;
+      }
+      
+    } // end of namespace details
+    
+    
+    
+    
+    /*!
+     \class accepting_processes_priority_t
+     \brief Priority of a node as the number of processes that are not in an accepting location
+     \tparam NODE_PTR : type of pointer to node
+     \note a location is accepting if it has an accepting label. Nodes with more processes in accepting locations
+     have smaller priority, hence they come first in a priority waiting container
+     */
+    template <class NODE_PTR>
+    class accepting_processes_priority_t {
+    public:
+      /*!
+       \brief Constructor
+       \tparam SYSTEM : type of system, should derive from tchecker::system_t
+       \tparam LABELS_RANGE : type of range of label names, should dereference to std::string
+       \param system : a system
+       \param index : maps label names to label identifiers
+       \param accepting_labels : range of label names
+       \pre index contains accepting_labels and the labels of system
+       */
+      template <class SYSTEM, class LABELS_RANGE>
+      accepting_processes_priority_t(SYSTEM const & system, tchecker::label_index_t const & index,
+                                     LABELS_RANGE const & accepting_labels)
+      : _accepting_locations(system.locations_count())
+      {
+        boost::dynamic_bitset<> labels = tchecker::covreach::details::labels_set(index, accepting_labels);
+        for (auto const * loc : system.locations())
+          for (tchecker::label_id_t id : loc->labels())
+            if (labels[id])
+              _accepting_locations[loc->id()] = 1;
+      }
+      
+      /*!
+       \brief Copy constructor
+       */
+      accepting_processes_priority_t(tchecker::covreach::accepting_processes_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      accepting_processes_priority_t(tchecker::covreach::accepting_processes_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~accepting_processes_priority_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::accepting_processes_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::accepting_processes_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::accepting_processes_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::accepting_processes_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Priority
+       \param node : a node
+       \return number of processes that are not in an accepting location in node
+       */
+      std::size_t operator() (NODE_PTR const & node) const
+      {
+        std::size_t count = 0;
+        for (auto const * loc : node->vloc())
+          if (! _accepting_locations[loc->id()])
+            ++count;
+        return count;
+      }
+    private:
+      boost::dynamic_bitset<> _accepting_locations;   /*!< Set of accepting locations */
+    };
+    
+    
+    
+    
+    /*!
+     \class random_priority_t
+     \brief Random priority of nodes
+     \tparam NODE_PTR : type of pointer to node
+     \note priorities are drawn from a pseudo-random generator with a fixed seed, hence runs are reproducible
+     */
+    template <class NODE_PTR>
+    class random_priority_t {
+    public:
+      /*!
+       \brief Constructor
+       \tparam SYSTEM : type of system
+       \tparam LABELS_RANGE : type of range of label names
+       \param system : a system (ignored)
+       \param index : maps label names to label identifiers (ignored)
+       \param accepting_labels : range of label names (ignored)
+       \note the parameters are those of the other priorities on nodes
+       */
+      template <class SYSTEM, class LABELS_RANGE>
+      random_priority_t(SYSTEM const & system, tchecker::label_index_t const & index,
+                        LABELS_RANGE const & accepting_labels)
+      {}
+      
+      /*!
+       \brief Copy constructor
+       */
+      random_priority_t(tchecker::covreach::random_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      random_priority_t(tchecker::covreach::random_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~random_priority_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::random_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::random_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::random_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::random_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Priority
+       \param node : a node
+       \return a pseudo-random priority
+       */
+      std::uint_fast32_t operator() (NODE_PTR const & node)
+      {
+        return _generator();
+      }
+    private:
+      std::minstd_rand _generator;   /*!< Pseudo-random generator */
+    };
+    
+    
+    
+    
+    /*!
+     \class distance_priority_t
+     \brief Priority of a node as its distance to the accepting labels (see tchecker::distances::labels_distances_t)
+     \tparam NODE_PTR : type of pointer to node
+     \note nodes closer to the accepting labels in the graphs of locations have smaller priority, hence they come
+     first in a priority waiting container. Nodes that cannot reach the accepting labels come last
+     */
+    template <class NODE_PTR>
+    class distance_priority_t {
+    public:
+      /*!
+       \brief Constructor
+       \tparam SYSTEM : type of system, should derive from tchecker::system_t
+       \tparam LABELS_RANGE : type of range of label names, should dereference to std::string
+       \param system : a system
+       \param index : maps label names to label identifiers
+       \param accepting_labels : range of label names
+       \pre index contains accepting_labels and the labels of system
+       */
+      template <class SYSTEM, class LABELS_RANGE>
+      distance_priority_t(SYSTEM const & system, tchecker::label_index_t const & index,
+                          LABELS_RANGE const & accepting_labels)
+      : _distances(system, tchecker::covreach::details::labels_set(index, accepting_labels))
+      {}
+      
+      /*!
+       \brief Copy constructor
+       */
+      distance_priority_t(tchecker::covreach::distance_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      distance_priority_t(tchecker::covreach::distance_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~distance_priority_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::distance_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::distance_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::distance_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::distance_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Priority
+       \param node : a node
+       \return distance from the tuple of locations in node to the accepting labels
+       */
+      tchecker::distances::distance_t operator() (NODE_PTR const & node) const
+      {
+        return _distances.distance(node->vloc());
+      }
+    private:
+      tchecker::distances::labels_distances_t _distances;   /*!< Distances to accepting labels */
+    };
+    
+    
+    
+    
+    /*!
+     \class ranking_priority_t
+     \brief Priority of a node from its rank
+     \tparam NODE_PTR : type of pointer to node
+     \note nodes with higher rank have smaller priority, hence they come first in a priority waiting container.
+     Nodes with the same rank come in insertion order. The rank of nodes is set by the covering reachability
+     algorithm (see tchecker::covreach::algorithm_t): successor nodes inherit the rank of their parent, and a
+     node that covers an already expanded node v gets a rank bigger than the rank of v. Hence, the subtrees of
+     covering nodes are explored first, in order to cover the nodes below expanded then covered nodes before they
+     get expanded in vain
+     */
+    template <class NODE_PTR>
+    class ranking_priority_t {
+    public:
+      /*!
+       \brief Constructor
+       \tparam SYSTEM : type of system
+       \tparam LABELS_RANGE : type of range of label names
+       \param system : a system (ignored)
+       \param index : maps label names to label identifiers (ignored)
+       \param accepting_labels : range of label names (ignored)
+       \note the parameters are those of the other priorities on nodes
+       */
+      template <class SYSTEM, class LABELS_RANGE>
+      ranking_priority_t(SYSTEM const & system, tchecker::label_index_t const & index,
+                         LABELS_RANGE const & accepting_labels)
+      : _inserted(0)
+      {}
+      
+      /*!
+       \brief Copy constructor
+       */
+      ranking_priority_t(tchecker::covreach::ranking_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      ranking_priority_t(tchecker::covreach::ranking_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~ranking_priority_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::covreach::ranking_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::ranking_priority_t<NODE_PTR> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::covreach::ranking_priority_t<NODE_PTR> &
+      operator= (tchecker::covreach::ranking_priority_t<NODE_PTR> &&) = default;
+      
+      /*!
+       \brief Priority
+       \param node : a node
+       \return pair (complement of the rank of node, number of nodes with priority computed before node)
+       */
+      std::pair<unsigned, unsigned long long> operator() (NODE_PTR const & node)
+      {
+        return std::make_pair(std::numeric_limits<unsigned>::max() - node->rank(), _inserted++);
+      }
+    private:
+      unsigned long long _inserted;   /*!< Number of nodes with computed priority */
+    };
+    
+  } // end of namespace covreach
+  
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COVREACH_PRIORITY_HH
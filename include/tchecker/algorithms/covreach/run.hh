@@ -8,20 +8,30 @@
 #ifndef TCHECKER_ALGORITHMS_COVREACH_RUN_HH
 #define TCHECKER_ALGORITHMS_COVREACH_RUN_HH
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 #include "tchecker/algorithms/covreach/accepting.hh"
 #include "tchecker/algorithms/covreach/algorithm.hh"
 #include "tchecker/algorithms/covreach/cover.hh"
 #include "tchecker/algorithms/covreach/graph.hh"
 #include "tchecker/algorithms/covreach/options.hh"
+#include "tchecker/algorithms/covreach/parallel_algorithm.hh"
 #include "tchecker/async_zg/async_zg_ta.hh"
 #include "tchecker/algorithms/covreach/output.hh"
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/algorithms/covreach/waiting.hh"
 #include "tchecker/graph/allocators.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/ts/allocators.hh"
 #include "tchecker/utils/gc.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/variables/intvars.hh"
 #include "tchecker/zg/zg_ta.hh"
 
 /*!
@@ -62,12 +72,17 @@ namespace tchecker {
             using transition_allocator_t = typename zone_semantics_t::template transition_singleton_allocator_t<transition_t>;
             using ts_allocator_t = tchecker::ts::allocator_t<node_allocator_t, transition_allocator_t>;
             
-            using graph_t = tchecker::covreach::graph_t<key_t, ts_t, ts_allocator_t>;
+            class node_to_key_t {
+            public:
+              inline key_t operator() (node_ptr_t const & node) const
+              {
+                return tchecker::ta::details::hash_value(*node);
+              }
+            };
             
-            static inline key_t node_to_key(node_ptr_t const & node)
-            {
-              return tchecker::ta::details::hash_value(*node);
-            }
+            template <class COVER_NODE>
+            using graph_t = tchecker::covreach::graph_t<key_t, ts_t, ts_allocator_t, node_to_key_t, COVER_NODE,
+            tchecker::covreach::cover_node_signature_t<COVER_NODE>>;
             
             class state_predicate_t {
             public:
@@ -141,12 +156,17 @@ namespace tchecker {
             using transition_allocator_t = typename zone_semantics_t::template transition_singleton_allocator_t<transition_t>;
             using ts_allocator_t = tchecker::ts::allocator_t<node_allocator_t, transition_allocator_t>;
             
-            using graph_t = tchecker::covreach::graph_t<key_t, ts_t, ts_allocator_t>;
+            class node_to_key_t {
+            public:
+              inline key_t operator() (node_ptr_t const & node) const
+              {
+                return tchecker::ta::details::hash_value(*node);
+              }
+            };
             
-            static inline key_t node_to_key(node_ptr_t const & node)
-            {
-              return tchecker::ta::details::hash_value(*node);
-            }
+            template <class COVER_NODE>
+            using graph_t = tchecker::covreach::graph_t<key_t, ts_t, ts_allocator_t, node_to_key_t, COVER_NODE,
+            tchecker::covreach::cover_node_signature_t<COVER_NODE>>;
             
             class state_predicate_t {
             public:
@@ -196,6 +216,329 @@ namespace tchecker {
       
       
       
+      /*!
+       \brief Upper bound on the initial size of the nodes table
+       \return the size of the biggest nodes table that fits in a small fraction of the physical memory, and that
+       can be indexed by tchecker::graph::cover::node_position_t
+       */
+      std::size_t nodes_table_size_bound();
+      
+      
+      /*!
+       \brief Initial size of the nodes table
+       \tparam MODEL : type of model
+       \param model : a model
+       \param options : covering reachability algorithm options
+       \return options.nodes_table_size() if it is not 0, otherwise an estimate of the number of discrete states in
+       model: the product of the number of locations of each process and of the domain size of each bounded integer
+       variable, capped by tchecker::covreach::details::nodes_table_size_bound()
+       \note the nodes table grows when needed, hence an under-approximation of the size is not harmful
+       */
+      template <class MODEL>
+      std::size_t nodes_table_size(MODEL const & model, tchecker::covreach::options_t const & options)
+      {
+        if (options.nodes_table_size() != 0)
+          return options.nodes_table_size();
+        
+        std::size_t const min_size = 64;
+        std::size_t const max_size = std::max(min_size, tchecker::covreach::details::nodes_table_size_bound());
+        std::size_t size = 1;
+        
+        auto multiply = [&] (std::size_t n) {
+          if ((n != 0) && (size > max_size / n))
+            size = max_size;
+          else
+            size *= n;
+        };
+        
+        auto const & system = model.system();
+        std::vector<std::size_t> locations_count(system.processes_count(), 0);
+        for (auto const * loc : system.locations())
+          ++ locations_count[loc->pid()];
+        for (std::size_t count : locations_count)
+          multiply(count);
+        
+        auto const & intvars = model.flattened_integer_variables();
+        for (tchecker::intvar_id_t id = 0; id < intvars.size(); ++id) {
+          tchecker::intvar_info_t const & info = intvars.info(id);
+          multiply(static_cast<std::size_t>(static_cast<long long>(info.max()) - static_cast<long long>(info.min()) + 1));
+        }
+        
+        return std::min(std::max(size, min_size), max_size);
+      }
+      
+      
+      /*!
+       \brief Output statistics on the nodes table
+       \tparam GRAPH : type of graph
+       \param os : output stream
+       \param initial_size : initial size of the nodes table
+       \param graph : a graph
+       \post the initial and final sizes of the nodes table of graph, the maximal and average numbers of nodes in
+       its non-empty entries, and the numbers of performed and avoided covering checks have been output to os
+       \return os after output
+       */
+      template <class GRAPH>
+      std::ostream & output_nodes_table_stats(std::ostream & os, std::size_t initial_size, GRAPH const & graph)
+      {
+        std::size_t const nonempty_count = graph.nonempty_containers_count();
+        os << "NODES_TABLE_INITIAL_SIZE " << initial_size << std::endl;
+        os << "NODES_TABLE_SIZE " << graph.table_size() << std::endl;
+        os << "NODES_TABLE_MAX_OCCUPANCY " << graph.max_container_size() << std::endl;
+        os << "NODES_TABLE_AVG_OCCUPANCY "
+        << (nonempty_count == 0 ? 0.0 : static_cast<double>(graph.nodes_count()) / nonempty_count) << std::endl;
+        os << "COVER_CHECKS " << graph.cover_checks() << std::endl;
+        os << "AVOIDED_COVER_CHECKS " << graph.avoided_cover_checks() << std::endl;
+        return os;
+      }
+      
+      
+      /*!
+       \brief Output statistics on garbage collection
+       \param os : output stream
+       \param gc : a garbage collector
+       \post the number of collections, the number of collected chunks, the time spent in collections and the
+       peak memory footprint of the pools enrolled to gc have been output to os
+       \return os after output
+       */
+      inline std::ostream & output_gc_stats(std::ostream & os, tchecker::gc_t const & gc)
+      {
+        os << "GC_COLLECTIONS " << gc.collections() << std::endl;
+        os << "GC_COLLECTED_CHUNKS " << gc.collected_chunks() << std::endl;
+        os << "GC_TIME " << gc.collection_time() << std::endl;
+        os << "POOLS_PEAK_MEMORY " << gc.peak_memsize() << std::endl;
+        return os;
+      }
+      
+      
+      /*!
+       \brief Output statistics on sharing of tuples of locations and integer variables valuations
+       \tparam TS_ALLOCATOR : type of transition system allocator
+       \param os : output stream
+       \param ts_allocators : transition system allocators
+       \post the number of shared tuples of locations and integer variables valuations, and the memory saved by
+       sharing, summed over ts_allocators, have been output to os
+       \return os after output
+       */
+      template <class TS_ALLOCATOR>
+      std::ostream & output_sharing_stats(std::ostream & os, std::vector<TS_ALLOCATOR const *> const & ts_allocators)
+      {
+        std::size_t shared_vlocs = 0, vloc_saved_memsize = 0;
+        std::size_t shared_intvars_vals = 0, intvars_val_saved_memsize = 0;
+        for (TS_ALLOCATOR const * ts_allocator : ts_allocators) {
+          auto const & state_allocator = ts_allocator->state_allocator();
+          shared_vlocs += state_allocator.shared_vlocs_count();
+          vloc_saved_memsize += state_allocator.vloc_saved_memsize();
+          shared_intvars_vals += state_allocator.shared_intvars_vals_count();
+          intvars_val_saved_memsize += state_allocator.intvars_val_saved_memsize();
+        }
+        os << "SHARED_VLOCS " << shared_vlocs << std::endl;
+        os << "VLOC_SAVED_MEMORY " << vloc_saved_memsize << std::endl;
+        os << "SHARED_INTVARS_VALS " << shared_intvars_vals << std::endl;
+        os << "INTVARS_VAL_SAVED_MEMORY " << intvars_val_saved_memsize << std::endl;
+        return os;
+      }
+      
+      
+      /*!
+       \brief Output statistics on sharing of zones
+       \tparam TS_ALLOCATOR : type of transition system allocator
+       \param os : output stream
+       \param ts_allocators : transition system allocators
+       \post the number of shared zones, the hit rate of the tables of shared zones, and the memory saved by
+       sharing, summed over ts_allocators, have been output to os
+       \return os after output
+       */
+      template <class TS_ALLOCATOR>
+      std::ostream & output_zone_sharing_stats(std::ostream & os, std::vector<TS_ALLOCATOR const *> const & ts_allocators)
+      {
+        std::size_t shared_zones = 0, lookups = 0, hits = 0, saved_memsize = 0;
+        for (TS_ALLOCATOR const * ts_allocator : ts_allocators) {
+          auto const & state_allocator = ts_allocator->state_allocator();
+          shared_zones += state_allocator.shared_zones_count();
+          lookups += state_allocator.zone_sharing_lookups();
+          hits += state_allocator.zone_sharing_hits();
+          saved_memsize += state_allocator.zone_saved_memsize();
+        }
+        os << "SHARED_ZONES " << shared_zones << std::endl;
+        os << "ZONE_SHARING_HIT_RATE " << (lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups) << std::endl;
+        os << "ZONE_SAVED_MEMORY " << saved_memsize << std::endl;
+        return os;
+      }
+      
+      
+      /*!
+       \brief Output statistics on packing of integer variables valuations
+       \tparam MODEL : type of model
+       \param os : output stream
+       \param model : a model
+       \post the size (in bytes) of integer variables valuations in states, with and without packing, as well as the
+       saving per state, have been output to os
+       \return os after output
+       */
+      template <class MODEL>
+      std::ostream & output_packing_stats(std::ostream & os, MODEL const & model)
+      {
+        using alloc_size_t = tchecker::allocation_size_t<tchecker::intvars_valuation_t>;
+        std::size_t const unpacked_size = alloc_size_t::alloc_size(model.flattened_integer_variables().flattened_size());
+        std::size_t const packed_size = alloc_size_t::alloc_size(model.integer_variables_packing().packed_size());
+        os << "INTVARS_VAL_SIZE " << unpacked_size << std::endl;
+        os << "PACKED_INTVARS_VAL_SIZE " << packed_size << std::endl;
+        os << "INTVARS_VAL_SAVED_MEMORY_PER_STATE " << (unpacked_size - packed_size) << std::endl;
+        return os;
+      }
+      
+      
+      /*!
+       \brief Build a waiting container
+       \tparam WAITING : type of waiting container
+       \tparam SYSTEM : type of system
+       \tparam LABELS_RANGE : type of range of label names
+       \param system : a system
+       \param label_index : maps label names to label identifiers
+       \param accepting_labels : range of accepting label names
+       \return an empty waiting container of type WAITING, default constructed if possible, and constructed from a
+       priority built from system, label_index and accepting_labels otherwise (see tchecker::covreach::priority_waiting_t)
+       */
+      template <class WAITING, class SYSTEM, class LABELS_RANGE>
+      WAITING make_waiting(SYSTEM const & system, tchecker::label_index_t const & label_index,
+                           LABELS_RANGE const & accepting_labels)
+      {
+        if constexpr (std::is_default_constructible<WAITING>::value)
+          return WAITING();
+        else
+          return WAITING(typename WAITING::priority_t(system, label_index, accepting_labels));
+      }
+      
+      
+      /*!
+       \brief Run multi-threaded covering reachability algorithm
+       \tparam COVER_NODE : type of covering predicate
+       \tparam ALGORITHM_MODEL : type of algorithm model
+       \param model : a model
+       \param options : covering reachability algorithm options
+       \param log : logging facility
+       \post covering reachability algorithm has been run on model with options.threads() worker threads, as
+       defined by ALGORITHM_MODEL and following options. Each worker explores its own waiting nodes in DFS or
+       BFS order, as selected by options.search_order(), and steals nodes from the other workers when it has no
+       waiting node. Every error and warning has been reported to log.
+       \note the graph is not output, as no edge is computed
+       */
+      template
+      <template <class NODE_PTR, class STATE_PREDICATE> class COVER_NODE,
+      class ALGORITHM_MODEL
+      >
+      void run_parallel(typename ALGORITHM_MODEL::model_t & model,
+                        tchecker::covreach::options_t const & options,
+                        tchecker::log_t & log)
+      {
+        using model_t = typename ALGORITHM_MODEL::model_t;
+        using ts_t = typename ALGORITHM_MODEL::ts_t;
+        using ts_allocator_t = typename ALGORITHM_MODEL::ts_allocator_t;
+        using node_ptr_t = typename ALGORITHM_MODEL::node_ptr_t;
+        using state_predicate_t = typename ALGORITHM_MODEL::state_predicate_t;
+        using cover_node_t = COVER_NODE<node_ptr_t, state_predicate_t>;
+        using node_to_key_t = typename ALGORITHM_MODEL::node_to_key_t;
+        using node_to_signature_t = tchecker::covreach::cover_node_signature_t<cover_node_t>;
+        using algorithm_t
+        = tchecker::covreach::parallel_algorithm_t<ts_t, ts_allocator_t, cover_node_t, node_to_key_t, node_to_signature_t>;
+        using graph_t = typename algorithm_t::graph_t;
+        using waiting_t = tchecker::covreach::work_stealing_waiting_t<node_ptr_t>;
+        
+        if (options.output_format() == tchecker::covreach::options_t::DOT) {
+          log.error("Graph output is not supported with more than one thread (command line option -j)");
+          return;
+        }
+        
+        if (options.trace()) {
+          log.error("Trace output is not supported with more than one thread (command line option -j)");
+          return;
+        }
+        
+        if ((options.search_order() != tchecker::covreach::options_t::BFS) &&
+            (options.search_order() != tchecker::covreach::options_t::DFS)) {
+          log.error("Only BFS and DFS search orders are supported with more than one thread (command line option -s)");
+          return;
+        }
+        
+        cover_node_t cover_node(ALGORITHM_MODEL::state_predicate_args(model), ALGORITHM_MODEL::zone_predicate_args(model));
+        
+        tchecker::label_index_t label_index(model.system().labels());
+        for (std::string const & label : options.accepting_labels()) {
+          if (label_index.find_value(label) == label_index.end_value_map())
+            label_index.add(label);
+        }
+        
+        tchecker::covreach::accepting_labels_t<node_ptr_t> accepting_labels(label_index, options.accepting_labels());
+        
+        tchecker::gc_t gc;
+        
+        std::vector<std::unique_ptr<ts_t>> ts;
+        std::vector<std::unique_ptr<ts_allocator_t>> ts_allocators;
+        for (std::size_t i = 0; i < options.threads(); ++i) {
+          ts.push_back(std::make_unique<ts_t>(model));
+          ts_allocators.push_back(std::make_unique<ts_allocator_t>
+                                  (gc,
+                                   std::tuple<model_t &, std::size_t, bool, bool, bool>(model, options.block_size(),
+                                                                                        options.share_components(),
+                                                                                        options.share_zones(),
+                                                                                        options.flat_states()),
+                                   std::make_tuple()));
+        }
+        
+        std::size_t const table_size = tchecker::covreach::details::nodes_table_size(model, options);
+        graph_t graph(table_size, node_to_key_t(), node_to_signature_t(cover_node));
+        
+        auto cleanup = [&] () {
+          gc.stop();
+          graph.clear();
+          for (auto & ts_allocator : ts_allocators)
+            ts_allocator->free_all();
+        };
+        
+        gc.start();
+        
+        enum tchecker::covreach::outcome_t outcome;
+        tchecker::covreach::stats_t stats;
+        algorithm_t algorithm;
+        
+        typename waiting_t::policy_t policy =
+        (options.search_order() == tchecker::covreach::options_t::BFS ? waiting_t::FIFO : waiting_t::LIFO);
+        
+        try {
+          std::tie(outcome, stats) = algorithm.run(ts, ts_allocators, graph, cover_node, accepting_labels, policy);
+        }
+        catch (...) {
+          cleanup();
+          throw;
+        }
+        
+        gc.stop();
+        
+        std::cout << "REACHABLE " << (outcome == tchecker::covreach::REACHABLE ? "true" : "false") << std::endl;
+        
+        if (options.stats()) {
+          std::cout << "STORED_NODES " << graph.nodes_count() << std::endl;
+          std::vector<ts_allocator_t const *> allocators;
+          for (auto const & ts_allocator : ts_allocators)
+            allocators.push_back(ts_allocator.get());
+          if (options.packed_intvars())
+            tchecker::covreach::details::output_packing_stats(std::cout, model);
+          if (options.share_components())
+            tchecker::covreach::details::output_sharing_stats(std::cout, allocators);
+          if (options.share_zones())
+            tchecker::covreach::details::output_zone_sharing_stats(std::cout, allocators);
+          if (options.detailed_stats()) {
+            tchecker::covreach::details::output_nodes_table_stats(std::cout, table_size, graph);
+            tchecker::covreach::details::output_gc_stats(std::cout, gc);
+          }
+          std::cout << stats << std::endl;
+        }
+        
+        cleanup();
+      }
+      
+      
       /*!
        \brief Run covering reachability algorithm
        \tparam ALGORITHM_MODEL : type of algorithm model
@@ -206,7 +549,7 @@ namespace tchecker {
        \param log : logging facility
        \post covering reachability algorithm has been run on a model of sysdecl as defined by
        ALGORITHM_MODEL and following options and the exploreation policy implented by WAITING.
-       The graph has been output using GRAPH_OUPUTTER
+       The graph has been output using GRAPH_OUPUTTER. If requested, a run to the accepting node has been output.
        Every error and warning has been reported to log.
        */
       template
@@ -221,12 +564,50 @@ namespace tchecker {
       {
         using model_t = typename ALGORITHM_MODEL::model_t;
         using ts_t = typename ALGORITHM_MODEL::ts_t;
-        using graph_t = typename ALGORITHM_MODEL::graph_t;
         using node_ptr_t = typename ALGORITHM_MODEL::node_ptr_t;
         using state_predicate_t = typename ALGORITHM_MODEL::state_predicate_t;
         using cover_node_t = COVER_NODE<node_ptr_t, state_predicate_t>;
+        using graph_t = typename ALGORITHM_MODEL::template graph_t<cover_node_t>;
         
         model_t model(sysdecl, log);
+        
+        if (options.verdict_only() && (options.output_format() == tchecker::covreach::options_t::DOT)) {
+          log.error("Graph output is not supported in verdict-only mode (command line option --verdict-only)");
+          return;
+        }
+        
+        if (options.packed_intvars()) {
+          if (options.output_format() == tchecker::covreach::options_t::DOT) {
+            log.error("Graph output is not supported with packed integer variables (command line option --packed-intvars)");
+            return;
+          }
+          if (options.trace()) {
+            log.error("Trace output is not supported with packed integer variables (command line option --packed-intvars)");
+            return;
+          }
+          model.pack_integer_variables(true);
+        }
+        
+        if ( ! options.native_code_dir().empty() ) {
+          try {
+            model.compile_native_code(options.native_code_dir());
+          }
+          catch (std::exception const & e) {
+            log.error("Native code (command line option --native-code)", e.what());
+            return;
+          }
+        }
+        
+        if (options.flat_states() && (options.share_components() || options.share_zones())) {
+          log.error("Sharing of components is not supported with flat nodes (command line option --flat-states)");
+          return;
+        }
+        
+        if (options.threads() > 1) {
+          tchecker::covreach::details::run_parallel<COVER_NODE, ALGORITHM_MODEL>(model, options, log);
+          return;
+        }
+        
         ts_t ts(model);
         cover_node_t cover_node(ALGORITHM_MODEL::state_predicate_args(model), ALGORITHM_MODEL::zone_predicate_args(model));
         
@@ -240,34 +621,64 @@ namespace tchecker {
         
         tchecker::gc_t gc;
         
+        std::size_t const table_size = tchecker::covreach::details::nodes_table_size(model, options);
         graph_t graph(gc,
-                      std::tuple<tchecker::gc_t &, std::tuple<model_t &, std::size_t>, std::tuple<>>
-                      (gc, std::tuple<model_t &, std::size_t>(model, options.block_size()), std::make_tuple()),
+                      std::tuple<tchecker::gc_t &, std::tuple<model_t &, std::size_t, bool, bool, bool>, std::tuple<>>
+                      (gc,
+                       std::tuple<model_t &, std::size_t, bool, bool, bool>(model, options.block_size(),
+                                                                            options.share_components(),
+                                                                            options.share_zones(),
+                                                                            options.flat_states()),
+                       std::make_tuple()),
                       options.block_size(),
-                      options.nodes_table_size(),
-                      ALGORITHM_MODEL::node_to_key,
-                      cover_node);
+                      table_size,
+                      typename ALGORITHM_MODEL::node_to_key_t(),
+                      cover_node,
+                      tchecker::covreach::cover_node_signature_t<cover_node_t>(cover_node));
         
         gc.start();
         
         enum tchecker::covreach::outcome_t outcome;
         tchecker::covreach::stats_t stats;
-        tchecker::covreach::algorithm_t<ts_t, graph_t, WAITING> algorithm;
+        tchecker::covreach::algorithm_t<ts_t, graph_t, WAITING> algorithm(! options.verdict_only(), options.trace());
+        node_ptr_t accepting_node{nullptr};
         
+        auto const start_time = std::chrono::steady_clock::now();
         try {
-          std::tie(outcome, stats) = algorithm.run(ts, graph, accepting_labels);
+          auto waiting = tchecker::covreach::details::make_waiting<WAITING<node_ptr_t>>(model.system(), label_index,
+                                                                                        options.accepting_labels());
+          std::tie(outcome, stats) = algorithm.run(ts, graph, accepting_labels, waiting, accepting_node);
         }
         catch (...) {
+          accepting_node = nullptr;
           gc.stop();
           graph.clear();
           graph.free_all();
           throw;
         }
         
+        std::chrono::duration<double> const running_time = std::chrono::steady_clock::now() - start_time;
+        
+        gc.stop();
+        
         std::cout << "REACHABLE " << (outcome == tchecker::covreach::REACHABLE ? "true" : "false") << std::endl;
         
         if (options.stats()) {
           std::cout << "STORED_NODES " << graph.nodes_count() << std::endl;
+          std::vector<typename graph_t::ts_allocator_t const *> allocators{&graph.ts_allocator()};
+          if (options.packed_intvars())
+            tchecker::covreach::details::output_packing_stats(std::cout, model);
+          if (options.share_components())
+            tchecker::covreach::details::output_sharing_stats(std::cout, allocators);
+          if (options.share_zones())
+            tchecker::covreach::details::output_zone_sharing_stats(std::cout, allocators);
+          if (options.detailed_stats()) {
+            tchecker::covreach::details::output_nodes_table_stats(std::cout, table_size, graph);
+            tchecker::covreach::details::output_gc_stats(std::cout, gc);
+            std::cout << "EDGES_MEMORY " << graph.edges_memsize() << std::endl;
+            std::cout << "EXPANDED_COVERED_NODES " << stats.expanded_covered_nodes() << std::endl;
+            std::cout << "RUNNING_TIME " << running_time.count() << std::endl;
+          }
           std::cout << stats << std::endl;
         }
         
@@ -279,7 +690,23 @@ namespace tchecker {
           (options.output_stream(), graph, model.system().name());
         }
         
-        gc.stop();
+        if (options.trace() && (outcome == tchecker::covreach::REACHABLE)) {
+          tchecker::covreach::trace_outputter_t<typename ALGORITHM_MODEL::node_outputter_t>
+          trace_outputter(ALGORITHM_MODEL::node_outputter_args(model));
+          
+          try {
+            trace_outputter.template output<typename ALGORITHM_MODEL::node_lt_t>
+            (options.output_stream(), accepting_node, ts, graph.ts_allocator(), model.system());
+          }
+          catch (...) {
+            accepting_node = nullptr;
+            graph.clear();
+            graph.free_all();
+            throw;
+          }
+        }
+        
+        accepting_node = nullptr;
         graph.clear();
         graph.free_all();
       }
@@ -307,7 +734,9 @@ namespace tchecker {
                         tchecker::covreach::options_t const & options,
                         tchecker::log_t & log)
       {
-        if (options.node_covering() == tchecker::covreach::options_t::INCLUSION)
+        if (options.flat_states())
+          log.error("Flat nodes are not supported by asynchronous zone graphs (command line option --flat-states)");
+        else if (options.node_covering() == tchecker::covreach::options_t::INCLUSION)
           tchecker::covreach::details::run<tchecker::covreach::cover_sync_inclusion_t, ALGORITHM_MODEL, GRAPH_OUTPUTTER, WAITING>
           (sysdecl, options, log);
         else
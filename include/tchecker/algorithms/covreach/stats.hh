@@ -73,6 +73,13 @@ namespace tchecker {
        */
       unsigned long covered_nonleaf_nodes() const;
       
+      /*!
+       \brief Accessor
+       \return the number of covered non-leaf nodes that had already been expanded
+       \note these nodes have been expanded in vain
+       */
+      unsigned long expanded_covered_nodes() const;
+      
       /*!
        \brief Increment counter of visited nodes
        \post the number of visited nodes has increased by 1
@@ -90,10 +97,26 @@ namespace tchecker {
        \post the number of covered non-leaf nodes has increased by 1
        */
       void increment_covered_nonleaf_nodes();
+      
+      /*!
+       \brief Increment counter of expanded then covered nodes
+       \post the number of expanded then covered nodes has increased by 1
+       */
+      void increment_expanded_covered_nodes();
+      
+      /*!
+       \brief Accumulate statistics
+       \param stats : statistics
+       \post all counters in stats have been added to the counters of this
+       \return this after accumulation
+       \note used to merge the statistics of several worker threads
+       */
+      tchecker::covreach::stats_t & operator+= (tchecker::covreach::stats_t const & stats);
     private:
       unsigned long _visited_nodes;          /*!< Number of visited nodes */
       unsigned long _covered_leaf_nodes;     /*!< Number of covered leaf nodes */
       unsigned long _covered_nonleaf_nodes;  /*!< Number of covered non-leaf nodes */
+      unsigned long _expanded_covered_nodes; /*!< Number of expanded then covered nodes */
     };
     
     
@@ -105,6 +128,7 @@ namespace tchecker {
      \param s : stats
      \post s has been output to os
      \return os after output
+     \note the number of expanded then covered nodes is not output (it is only output with detailed statistics)
      */
     std::ostream & operator<< (std::ostream & os, tchecker::covreach::stats_t const & stats);
     
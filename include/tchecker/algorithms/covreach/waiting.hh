@@ -8,6 +8,9 @@
 #ifndef TCHECKER_ALGORITHMS_COVREACH_WAITING_HH
 #define TCHECKER_ALGORITHMS_COVREACH_WAITING_HH
 
+#include <atomic>
+
+#include "tchecker/algorithms/covreach/priority.hh"
 #include "tchecker/utils/waiting.hh"
 
 /*!
@@ -25,6 +28,7 @@ namespace tchecker {
        \class active_node_t
        \brief Node with active flag
        \note allows to remove nodes efficiently from a waiting nodes container
+       \note the active flag can be read and cleared concurrently by several threads
        */
       class active_node_t {
       public:
@@ -32,18 +36,20 @@ namespace tchecker {
          \brief Constructor
          \post this node is active
          */
-        active_node_t() : _active(1)
+        active_node_t() : _active(true)
         {}
         
         /*!
          \brief Copy constructor
          */
-        active_node_t(tchecker::covreach::details::active_node_t const &) = default;
+        active_node_t(tchecker::covreach::details::active_node_t const & n) : _active(n.is_active())
+        {}
         
         /*!
          \brief Move constructor
          */
-        active_node_t(tchecker::covreach::details::active_node_t &&) = default;
+        active_node_t(tchecker::covreach::details::active_node_t && n) : _active(n.is_active())
+        {}
         
         /*!
          \brief Destructor
@@ -53,12 +59,20 @@ namespace tchecker {
         /*!
          \brief Assignment operator
          */
-        tchecker::covreach::details::active_node_t & operator= (tchecker::covreach::details::active_node_t const &) = default;
+        tchecker::covreach::details::active_node_t & operator= (tchecker::covreach::details::active_node_t const & n)
+        {
+          _active.store(n.is_active(), std::memory_order_relaxed);
+          return *this;
+        }
         
         /*!
          \brief Move-assignment operator
          */
-        tchecker::covreach::details::active_node_t & operator= (tchecker::covreach::details::active_node_t &&) = default;
+        tchecker::covreach::details::active_node_t & operator= (tchecker::covreach::details::active_node_t && n)
+        {
+          _active.store(n.is_active(), std::memory_order_relaxed);
+          return *this;
+        }
         
         /*!
          \brief Accessor
@@ -66,7 +80,7 @@ namespace tchecker {
          */
         bool is_active() const
         {
-          return (_active == 1);
+          return _active.load(std::memory_order_relaxed);
         }
         
         /*!
@@ -75,10 +89,10 @@ namespace tchecker {
          */
         void make_inactive()
         {
-          _active = 0;
+          _active.store(false, std::memory_order_relaxed);
         }
       private:
-        unsigned char _active : 1;    /*!< Active node flag */
+        std::atomic<bool> _active;    /*!< Active node flag */
       };
       
       
@@ -178,6 +192,122 @@ namespace tchecker {
     template <class NODE_PTR>
     using lifo_waiting_t = tchecker::covreach::details::active_waiting_t<tchecker::lifo_waiting_t<NODE_PTR>>;
     
+    
+    /*!
+     \class priority_waiting_t
+     \brief Priority waiting container (see tchecker::priority_waiting_t)
+     \tparam NODE_PTR : type of pointers to node, should derive from tchecker::covreach::details::active_node_t
+     \tparam PRIORITY : type of priority on nodes
+     \note this container filters active nodes: removed nodes are deleted lazily, when they reach the top of the
+     heap
+     */
+    template <class NODE_PTR, class PRIORITY>
+    class priority_waiting_t : public tchecker::filter_waiting_t<tchecker::priority_waiting_t<NODE_PTR, PRIORITY>> {
+    public:
+      /*!
+       \brief Type of pointers to node
+       */
+      using node_ptr_t = NODE_PTR;
+      
+      /*!
+       \brief Constructor
+       \param priority : priority on nodes
+       */
+      explicit priority_waiting_t(PRIORITY const & priority)
+      : tchecker::filter_waiting_t<tchecker::priority_waiting_t<NODE_PTR, PRIORITY>>
+      (tchecker::covreach::details::active_node_filter<NODE_PTR>, priority)
+      {}
+      
+      /*!
+       \brief Remove node
+       \param n : a node
+       \post n is inactive
+       \note see tchecker::covreach::details::active_waiting_t::remove
+       */
+      void remove(node_ptr_t const & n)
+      {
+        n->make_inactive();
+      }
+    };
+    
+    
+    /*!
+     \brief Best-first waiting container: nodes with more processes in accepting locations come first
+     \note this container filters active nodes
+     */
+    template <class NODE_PTR>
+    using accepting_processes_waiting_t
+    = tchecker::covreach::priority_waiting_t<NODE_PTR, tchecker::covreach::accepting_processes_priority_t<NODE_PTR>>;
+    
+    
+    /*!
+     \brief Distance waiting container: nodes closer to the accepting labels in the graphs of locations come first
+     \note this container filters active nodes
+     */
+    template <class NODE_PTR>
+    using distance_waiting_t
+    = tchecker::covreach::priority_waiting_t<NODE_PTR, tchecker::covreach::distance_priority_t<NODE_PTR>>;
+    
+    
+    /*!
+     \brief Ranking waiting container: nodes with higher rank come first, then in insertion order (see
+     tchecker::covreach::ranking_priority_t)
+     \note this container filters active nodes
+     */
+    template <class NODE_PTR>
+    using ranking_waiting_t
+    = tchecker::covreach::priority_waiting_t<NODE_PTR, tchecker::covreach::ranking_priority_t<NODE_PTR>>;
+    
+    
+    /*!
+     \brief Random waiting container
+     \note this container filters active nodes
+     */
+    template <class NODE_PTR>
+    using random_waiting_t = tchecker::covreach::priority_waiting_t<NODE_PTR, tchecker::covreach::random_priority_t<NODE_PTR>>;
+
+    
+    /*!
+     \class work_stealing_waiting_t
+     \brief Work-stealing waiting container shared by several workers (see tchecker::work_stealing_waiting_t)
+     \tparam NODE_PTR : type of pointers to node, should derive from tchecker::covreach::details::active_node_t
+     \note this container filters active nodes
+     */
+    template <class NODE_PTR>
+    class work_stealing_waiting_t : public tchecker::work_stealing_waiting_t<NODE_PTR> {
+    public:
+      /*!
+       \brief Type of pointers to node
+       */
+      using node_ptr_t = NODE_PTR;
+      
+      /*!
+       \brief Type of policy
+       */
+      using policy_t = typename tchecker::work_stealing_waiting_t<NODE_PTR>::policy_t;
+      
+      /*!
+       \brief Constructor
+       \param workers : number of workers
+       \param policy : policy on local queues
+       \throw std::invalid_argument : if workers is 0
+       */
+      work_stealing_waiting_t(std::size_t workers, policy_t policy)
+      : tchecker::work_stealing_waiting_t<NODE_PTR>(workers, policy, tchecker::covreach::details::active_node_filter<NODE_PTR>)
+      {}
+      
+      /*!
+       \brief Remove node
+       \param n : a node
+       \post n is inactive
+       \note see tchecker::covreach::details::active_waiting_t::remove
+       */
+      void remove(node_ptr_t const & n)
+      {
+        n->make_inactive();
+      }
+    };
+    
   } // end of namespace covreach
   
 } // end of namespace tchecker
@@ -90,7 +90,9 @@ namespace tchecker {
       _explored_model(tchecker::explore::options_t::UNKNOWN),
       _os(&std::cout),
       _search_order(tchecker::explore::options_t::DFS),
-      _block_size(10000)
+      _block_size(10000),
+      _share_components(false),
+      _share_zones(false)
       {
         auto it = range.begin(), end = range.end();
         for ( ; it != end; ++it )
@@ -153,6 +155,18 @@ namespace tchecker {
        */
       std::size_t block_size() const;
       
+      /*!
+       \brief Accessor
+       \return true if nodes should share equal tuples of locations and integer variables valuations, false otherwise
+       */
+      bool share_components() const;
+      
+      /*!
+       \brief Accessor
+       \return true if nodes should share equal zones, false otherwise
+       */
+      bool share_zones() const;
+      
       /*!
        \brief Check that mandatory options have been set
        \param log : a logging facility
@@ -176,6 +190,8 @@ namespace tchecker {
         {"output",       required_argument, 0, 'o'},
         {"search-order", required_argument, 0, 's'},
         {"block-size",   required_argument, 0, 0},
+        {"share-components", no_argument,   0, 0},
+        {"share-zones",  no_argument,       0, 0},
         {0, 0, 0, 0}
       };
       
@@ -264,11 +280,29 @@ namespace tchecker {
        */
       void set_block_size(std::string const & value, tchecker::log_t & log);
       
+      /*!
+       \brief Set sharing flag for tuples of locations and integer variables valuations
+       \param value : option value
+       \param log : logging facility
+       \post sharing flag has been set
+       */
+      void set_share_components(std::string const & value, tchecker::log_t & log);
+      
+      /*!
+       \brief Set sharing flag for zones
+       \param value : option value
+       \param log : logging facility
+       \post zone sharing flag has been set
+       */
+      void set_share_zones(std::string const & value, tchecker::log_t & log);
+      
       enum output_format_t _output_format;    /*!< Output format */
       enum explored_model_t _explored_model;  /*!< Explored model */
       std::ostream * _os;                     /*!< Output stream */
       enum search_order_t _search_order;      /*!< Search order */
       std::size_t _block_size;                /*!< Size of allocation blocks */
+      bool _share_components;                 /*!< Sharing of tuples of locations and integer valuations */
+      bool _share_zones;                      /*!< Sharing of zones */
     };
     
   } // end of namespace explore
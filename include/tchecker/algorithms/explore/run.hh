@@ -8,6 +8,8 @@
 #ifndef TCHECKER_ALGORITHMS_EXPLORE_RUN_HH
 #define TCHECKER_ALGORITHMS_EXPLORE_RUN_HH
 
+#include <functional>
+
 #include "tchecker/algorithms/explore/algorithm.hh"
 #include "tchecker/algorithms/explore/graph.hh"
 #include "tchecker/algorithms/explore/options.hh"
@@ -50,6 +52,9 @@ namespace tchecker {
           using edge_allocator_t = tchecker::fsm::transition_singleton_allocator_t<edge_t>;
           using graph_allocator_t = tchecker::graph::graph_allocator_t<node_allocator_t, edge_allocator_t>;
           
+          static std::tuple<tchecker::explore::details::fsm::explored_model_t::model_t &, std::size_t, bool>
+          node_allocator_args(tchecker::explore::details::fsm::explored_model_t::model_t & model,
+                              tchecker::explore::options_t const & options);
           static std::tuple<tchecker::intvar_index_t const &>
           node_outputter_args(tchecker::explore::details::fsm::explored_model_t::model_t const & model);
           static std::tuple<> edge_outputter_args(tchecker::explore::details::fsm::explored_model_t::model_t const & model);
@@ -78,6 +83,9 @@ namespace tchecker {
           using edge_allocator_t = tchecker::ta::transition_singleton_allocator_t<edge_t>;
           using graph_allocator_t = tchecker::graph::graph_allocator_t<node_allocator_t, edge_allocator_t>;
           
+          static std::tuple<tchecker::explore::details::ta::explored_model_t::model_t &, std::size_t, bool>
+          node_allocator_args(tchecker::explore::details::ta::explored_model_t::model_t & model,
+                              tchecker::explore::options_t const & options);
           static std::tuple<tchecker::intvar_index_t const &>
           node_outputter_args(tchecker::explore::details::ta::explored_model_t::model_t const & model);
           static std::tuple<tchecker::clock_index_t const &>
@@ -111,6 +119,14 @@ namespace tchecker {
             using edge_allocator_t = typename zone_semantics_t::template transition_singleton_allocator_t<edge_t>;
             using graph_allocator_t = tchecker::graph::graph_allocator_t<node_allocator_t, edge_allocator_t>;
             
+            static std::tuple<model_t &, std::size_t, bool, bool>
+            node_allocator_args(tchecker::explore::details::zg::ta::explored_model_t<ZONE_SEMANTICS>::model_t & model,
+                                tchecker::explore::options_t const & options)
+            {
+              return std::tuple<model_t &, std::size_t, bool, bool>
+              (model, options.block_size(), options.share_components(), options.share_zones());
+            }
+            
             static std::tuple<tchecker::intvar_index_t const &, tchecker::clock_index_t const &>
             node_outputter_args(tchecker::explore::details::zg::ta::explored_model_t<ZONE_SEMANTICS>::model_t const & model)
             {
@@ -154,6 +170,14 @@ namespace tchecker {
             using edge_allocator_t = typename zone_semantics_t::template transition_singleton_allocator_t<edge_t>;
             using graph_allocator_t = tchecker::graph::graph_allocator_t<node_allocator_t, edge_allocator_t>;
             
+            static std::tuple<model_t &, std::size_t, bool, bool>
+            node_allocator_args(tchecker::explore::details::async_zg::ta::explored_model_t<ZONE_SEMANTICS>::model_t & model,
+                                tchecker::explore::options_t const & options)
+            {
+              return std::tuple<model_t &, std::size_t, bool, bool>
+              (model, options.block_size(), options.share_components(), options.share_zones());
+            }
+            
             static std::tuple<tchecker::intvar_index_t const &, tchecker::clock_index_t const &, tchecker::clock_index_t const &>
             node_outputter_args(tchecker::explore::details::async_zg::ta::explored_model_t<ZONE_SEMANTICS>::model_t const & model)
             {
@@ -218,8 +242,7 @@ namespace tchecker {
         tchecker::gc_t gc;
         
         graph_t graph(model.system().name(),
-                      std::tuple<tchecker::gc_t &, std::tuple<model_t &, std::size_t>, std::tuple<>>
-                      (gc, std::tuple<model_t &, std::size_t>(model, options.block_size()), std::make_tuple()),
+                      std::make_tuple(std::ref(gc), EXPLORED_MODEL::node_allocator_args(model, options), std::make_tuple()),
                       options.output_stream(),
                       EXPLORED_MODEL::node_outputter_args(model),
                       EXPLORED_MODEL::edge_outputter_args(model));
@@ -8,6 +8,8 @@
 #ifndef TCHECKER_ASYNC_ZG_TA_HH
 #define TCHECKER_ASYNC_ZG_TA_HH
 
+#include <stdexcept>
+
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/ta/ta.hh"
@@ -151,14 +153,24 @@ namespace tchecker {
          \brief Constructor
          \param model : a model
          \param alloc_nb : number of objects in an allocation block
+         \param share_components : sharing flag for tuples of locations and integer variables valuations
+         \param share_zones : sharing flag for zones
+         \param flat_layout : flag for allocation of states with their components in a single chunk
+         \throw std::invalid_argument : if flat_layout is true (not supported for asynchronous zone graphs)
          */
-        state_pool_allocator_t(tchecker::async_zg::ta::model_t & model, std::size_t alloc_nb)
+        state_pool_allocator_t(tchecker::async_zg::ta::model_t & model, std::size_t alloc_nb, bool share_components = false,
+                               bool share_zones = false, bool flat_layout = false)
         : tchecker::async_zg::details::state_pool_allocator_t<STATE>
         (alloc_nb,
          alloc_nb, model.system().processes_count(),
-         alloc_nb, model.flattened_integer_variables().flattened_size(),
-         alloc_nb, model.flattened_offset_clock_variables().flattened_size(), model.flattened_clock_variables().flattened_size())
-        {}
+         alloc_nb, model.intvars_valuation_size(),
+         alloc_nb, model.flattened_offset_clock_variables().flattened_size(), model.flattened_clock_variables().flattened_size(),
+         share_components,
+         share_zones)
+        {
+          if (flat_layout)
+            throw std::invalid_argument("flat layout of states is not supported by asynchronous zone graphs");
+        }
       };
       
       /*!
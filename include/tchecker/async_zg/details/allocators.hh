@@ -29,6 +29,8 @@ namespace tchecker {
        \tparam INTVARS_VAL : type of integer variables valuations
        \tparam OFFSET_ZONE : type of offset zones
        \tparam SYNC_ZONE : type of synchronized zones
+       \note When zone sharing is enabled, states with equal offset zones (resp. synchronized zones) share the same
+       offset zone (resp. synchronized zone), see share()
        */
       template
       <class STATE,
@@ -85,6 +87,8 @@ namespace tchecker {
          \param zone_alloc_nb : number of offset/sync zones allocated in one block
          \param offset_zone_dimension : dimension of allocated offset zones
          \param sync_zone_dimension : dimension of allocated synchronized zones
+         \param share_components : sharing flag for tuples of locations and integer variables valuations
+         \param share_zones : sharing flag for offset zones and synchronized zones
          */
         state_pool_allocator_t(std::size_t state_alloc_nb,
                                std::size_t vloc_alloc_nb,
@@ -93,16 +97,25 @@ namespace tchecker {
                                std::size_t intvars_val_capacity,
                                std::size_t zone_alloc_nb,
                                tchecker::clock_id_t offset_zone_dimension,
-                               tchecker::clock_id_t sync_zone_dimension)
+                               tchecker::clock_id_t sync_zone_dimension,
+                               bool share_components = false,
+                               bool share_zones = false)
         : tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>(state_alloc_nb,
                                                                                   vloc_alloc_nb,
                                                                                   vloc_capacity,
                                                                                   intvars_val_alloc_nb,
-                                                                                  intvars_val_capacity),
+                                                                                  intvars_val_capacity,
+                                                                                  share_components),
         _offset_zone_dimension(offset_zone_dimension),
         _offset_zone_pool(zone_alloc_nb, tchecker::allocation_size_t<OFFSET_ZONE>::alloc_size(_offset_zone_dimension)),
         _sync_zone_dimension(sync_zone_dimension),
-        _sync_zone_pool(zone_alloc_nb, tchecker::allocation_size_t<SYNC_ZONE>::alloc_size(_sync_zone_dimension))
+        _sync_zone_pool(zone_alloc_nb, tchecker::allocation_size_t<SYNC_ZONE>::alloc_size(_sync_zone_dimension)),
+        _share_zones(share_zones),
+        _shared_offset_zones(_offset_zone_pool),
+        _shared_sync_zones(_sync_zone_pool),
+        _zone_sharing_lookups(0),
+        _offset_zone_sharing_hits(0),
+        _sync_zone_sharing_hits(0)
         {}
         
         /*!
@@ -165,6 +178,67 @@ namespace tchecker {
           (state, args..., _offset_zone_pool.construct(state.offset_zone()), _sync_zone_pool.construct(state.sync_zone()));
         }
         
+        /*!
+         \brief Share components of a state
+         \param state : a state
+         \pre state has been constructed by this allocator, and it will not be modified anymore
+         \post the tuple of locations and the integer variables valuation of state have been shared (see
+         tchecker::fsm::details::state_pool_allocator_t::share). If zone sharing is enabled, the offset zone and the
+         synchronized zone of state have been replaced by equal shared zones if any, and they have been made shared
+         otherwise
+         */
+        void share(STATE & state)
+        {
+          tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::share(state);
+          if (! _share_zones)
+            return;
+          _zone_sharing_lookups += 2;
+          _offset_zone_sharing_hits += (_shared_offset_zones.share(state.offset_zone_ptr()) ? 1 : 0);
+          _sync_zone_sharing_hits += (_shared_sync_zones.share(state.sync_zone_ptr()) ? 1 : 0);
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of shared offset zones and synchronized zones
+         */
+        inline std::size_t shared_zones_count() const
+        {
+          return _shared_offset_zones.size() + _shared_sync_zones.size();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of offset zones and synchronized zones looked up in the tables of shared zones
+         */
+        inline std::size_t zone_sharing_lookups() const
+        {
+          return _zone_sharing_lookups;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of offset zones and synchronized zones that have been replaced by an equal shared zone
+         */
+        inline std::size_t zone_sharing_hits() const
+        {
+          return _offset_zone_sharing_hits + _sync_zone_sharing_hits;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Memory saved by sharing offset zones and synchronized zones
+         */
+        inline std::size_t zone_saved_memsize() const
+        {
+          return _offset_zone_sharing_hits * tchecker::allocation_size_t<OFFSET_ZONE>::alloc_size(_offset_zone_dimension)
+          + _sync_zone_sharing_hits * tchecker::allocation_size_t<SYNC_ZONE>::alloc_size(_sync_zone_dimension);
+        }
+        
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::shared_vlocs_count;
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::vloc_saved_memsize;
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::shared_intvars_vals_count;
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::intvars_val_saved_memsize;
+        
         /*!
          \brief Destruct state
          \param p : pointer to state
@@ -211,6 +285,8 @@ namespace tchecker {
          */
         void destruct_all()
         {
+          _shared_offset_zones.clear();
+          _shared_sync_zones.clear();
           tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::destruct_all();
           _offset_zone_pool.destruct_all();
           _sync_zone_pool.destruct_all();
@@ -223,6 +299,8 @@ namespace tchecker {
          */
         void free_all()
         {
+          _shared_offset_zones.clear();
+          _shared_sync_zones.clear();
           tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::free_all();
           _offset_zone_pool.free_all();
           _sync_zone_pool.free_all();
@@ -252,10 +330,16 @@ namespace tchecker {
           _sync_zone_pool.enroll(gc);
         }
       protected:
-        tchecker::clock_id_t _offset_zone_dimension;      /*!< Dimension of allocated offset zones */
-        tchecker::pool_t<OFFSET_ZONE> _offset_zone_pool;  /*!< Pool of offset zones */
-        tchecker::clock_id_t _sync_zone_dimension;        /*!< Dimension of allocated synchronized zones */
-        tchecker::pool_t<SYNC_ZONE> _sync_zone_pool;      /*!< Pool of synchronized zones */
+        tchecker::clock_id_t _offset_zone_dimension;                                     /*!< Dimension of allocated offset zones */
+        tchecker::pool_t<OFFSET_ZONE> _offset_zone_pool;                                 /*!< Pool of offset zones */
+        tchecker::clock_id_t _sync_zone_dimension;                                       /*!< Dimension of allocated synchronized zones */
+        tchecker::pool_t<SYNC_ZONE> _sync_zone_pool;                                     /*!< Pool of synchronized zones */
+        bool _share_zones;                                                               /*!< Zone sharing flag */
+        tchecker::fsm::details::shared_components_t<OFFSET_ZONE> _shared_offset_zones;   /*!< Shared offset zones */
+        tchecker::fsm::details::shared_components_t<SYNC_ZONE> _shared_sync_zones;       /*!< Shared synchronized zones */
+        std::size_t _zone_sharing_lookups;                                               /*!< Number of lookups in shared zones */
+        std::size_t _offset_zone_sharing_hits;                                           /*!< Number of offset zones replaced by a shared one */
+        std::size_t _sync_zone_sharing_hits;                                             /*!< Number of synchronized zones replaced by a shared one */
       };
       
       
@@ -115,7 +115,7 @@ namespace tchecker {
          */
         virtual tchecker::range_t<typename ASYNC_ZG::outgoing_edges_iterator_t> outgoing_edges(STATE const & s)
         {
-          return _async_zg.outgoing_edges(s.vloc());
+          return _async_zg.outgoing_edges(s.vloc(), s.intvars_valuation());
         }
         
         /*!
@@ -191,11 +191,25 @@ namespace tchecker {
          \param vloc : tuple of locations
          \return range of outgoing synchronized and asynchronous edges from vloc
          */
-        inline tchecker::range_t<outgoing_edges_iterator_t> outgoing_edges(vloc_t const & vloc) const
+        inline tchecker::range_t<outgoing_edges_iterator_t> outgoing_edges(vloc_t const & vloc)
         {
           return _ta.outgoing_edges(vloc);
         }
         
+        /*!
+         \brief Accessor
+         \param vloc : tuple of locations
+         \param intvars_val : valuation of integer variables
+         \return range of outgoing synchronized and asynchronous edges from vloc, pre-filtered w.r.t.
+         integer guards on intvars_val (see tchecker::fsm::details::fsm_t::outgoing_edges)
+         \note the returned range is invalidated by the next call to this method
+         */
+        inline tchecker::range_t<outgoing_edges_iterator_t> outgoing_edges(vloc_t const & vloc,
+                                                                           intvars_valuation_t const & intvars_val)
+        {
+          return _ta.outgoing_edges(vloc, intvars_val);
+        }
+        
         /*!
          \brief Dereference type for iterator over outgoing edges
          */
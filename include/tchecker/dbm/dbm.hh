@@ -8,6 +8,7 @@
 #ifndef TCHECKER_DBM_DBM_HH
 #define TCHECKER_DBM_DBM_HH
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
 
@@ -519,9 +520,24 @@ namespace tchecker {
      dbm is a dim*dim array of difference bounds
      dim >= 1 (checked by assertion)
      \return hash code of dbm
+     \note the hash code does not depend on the implementation (vectorized or not) selected at runtime
      */
     std::size_t hash(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
     
+    /*!
+     \brief Inclusion signature
+     \param dbm : a dbm
+     \param dim : dimension of dbm
+     \pre dbm is not nullptr (checked by assertion)
+     dbm is a dim*dim array of difference bounds
+     dim >= 1 (checked by assertion)
+     \return a 64-bit signature of dbm. Bit k is set if some bound DBM[i,j] with i != j and (i*dim+j) % 64 == k
+     is tighter than a fixed threshold: DBM[0,j] < (<=,0) and DBM[i,j] < (<,inf) for i > 0
+     \note if dbm1 <= dbm2 (see tchecker::dbm::is_le), then all the bits set in signature(dbm2) are also set in
+     signature(dbm1). Signatures thus allow to discard most non-inclusions without comparing the dbms
+     */
+    std::uint64_t signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+    
     /*!
      \brief Output a DBM as a matrix
      \param os : output stream
@@ -0,0 +1,188 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DISTANCES_HH
+#define TCHECKER_DISTANCES_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+
+/*!
+ \file distances.hh
+ \brief Distances to labelled locations in a system
+ */
+
+namespace tchecker {
+  
+  namespace distances {
+    
+    /*!
+     \brief Type of distances (number of edges)
+     */
+    using distance_t = std::uint32_t;
+    
+    /*!
+     \brief Infinite distance
+     */
+    tchecker::distances::distance_t const INF_DISTANCE = std::numeric_limits<tchecker::distances::distance_t>::max();
+    
+    
+    
+    
+    /*!
+     \class labels_distances_t
+     \brief Distances from tuples of locations to a set of labels
+     \note for each label l in the set, and each location loc, the distance from loc to l is the length of a
+     shortest path from loc to a location with label l in the graph of the process of loc. This distance is
+     computed by a backward breadth-first search from the locations with label l. The distance from a tuple of
+     locations vloc to the set of labels is the sum, over all labels l, of the minimal distance from a location in
+     vloc to l. Only the processes that have a location with label l are considered for label l.
+     \note synchronizations, guards and invariants are ignored, hence distances are lower bounds on the number of
+     steps of each process. In particular, no location with label l is reachable from a tuple of locations at
+     infinite distance to l
+     */
+    class labels_distances_t {
+    public:
+      /*!
+       \brief Constructor
+       \tparam SYSTEM : type of system, should derive from tchecker::system_t
+       \param system : a system
+       \param labels : a set of label identifiers
+       \post this contains the distances from the locations of system to labels
+       */
+      template <class SYSTEM>
+      labels_distances_t(SYSTEM const & system, boost::dynamic_bitset<> const & labels)
+      : _locations_count(system.locations_count())
+      {
+        std::vector<std::size_t> rank(labels.size(), labels.size());
+        std::size_t labels_count = 0;
+        for (std::size_t id = labels.find_first(); id != boost::dynamic_bitset<>::npos; id = labels.find_next(id))
+          rank[id] = labels_count++;
+        
+        std::vector<std::vector<tchecker::loc_id_t>> targets(labels_count);
+        _processes.resize(labels_count);
+        for (auto const * loc : system.locations())
+          for (tchecker::label_id_t id : loc->labels()) {
+            if ((id >= labels.size()) || ! labels[id])
+              continue;
+            targets[rank[id]].push_back(loc->id());
+            std::vector<tchecker::process_id_t> & processes = _processes[rank[id]];
+            if (std::find(processes.begin(), processes.end(), loc->pid()) == processes.end())
+              processes.push_back(loc->pid());
+          }
+        
+        std::vector<std::vector<tchecker::loc_id_t>> predecessors(_locations_count);
+        for (auto const * edge : system.edges())
+          predecessors[edge->tgt()->id()].push_back(edge->src()->id());
+        
+        compute(predecessors, targets);
+      }
+      
+      /*!
+       \brief Copy constructor
+       */
+      labels_distances_t(tchecker::distances::labels_distances_t const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      labels_distances_t(tchecker::distances::labels_distances_t &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~labels_distances_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::distances::labels_distances_t & operator= (tchecker::distances::labels_distances_t const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::distances::labels_distances_t & operator= (tchecker::distances::labels_distances_t &&) = default;
+      
+      /*!
+       \brief Accessor
+       \return number of labels
+       */
+      inline std::size_t labels_count() const
+      {
+        return _processes.size();
+      }
+      
+      /*!
+       \brief Accessor
+       \param pid : process identifier
+       \return true if process pid has a location with one of the labels, false otherwise
+       \note the locations of the other processes are ignored when computing distances
+       */
+      bool contributes(tchecker::process_id_t pid) const;
+      
+      /*!
+       \brief Accessor
+       \param rank : rank of a label, in increasing order of label identifiers
+       \param id : location identifier
+       \return distance from location id to the label of rank rank
+       \pre rank < labels_count() and id is a location identifier in the system (checked by assertion)
+       */
+      inline tchecker::distances::distance_t distance(std::size_t rank, tchecker::loc_id_t id) const
+      {
+        assert(rank < labels_count());
+        assert(id < _locations_count);
+        return _distances[rank * _locations_count + id];
+      }
+      
+      /*!
+       \brief Accessor
+       \tparam VLOC : type of tuple of locations, should be tchecker::vloc_t
+       \param vloc : tuple of locations
+       \return distance from vloc to the labels, INF_DISTANCE if some label is not reachable from vloc
+       \note the value is 0 if there is no label
+       */
+      template <class VLOC>
+      tchecker::distances::distance_t distance(VLOC const & vloc) const
+      {
+        tchecker::distances::distance_t d = 0;
+        for (std::size_t rank = 0; rank < _processes.size(); ++rank) {
+          tchecker::distances::distance_t min = tchecker::distances::INF_DISTANCE;
+          for (tchecker::process_id_t pid : _processes[rank])
+            min = std::min(min, distance(rank, vloc[pid]->id()));
+          if (min == tchecker::distances::INF_DISTANCE)
+            return tchecker::distances::INF_DISTANCE;
+          d += min;
+        }
+        return d;
+      }
+    private:
+      /*!
+       \brief Compute distances
+       \param predecessors : map from location identifiers to the identifiers of their predecessor locations
+       \param targets : map from label ranks to the identifiers of their locations
+       \post _distances has been computed by backward breadth-first search from targets
+       */
+      void compute(std::vector<std::vector<tchecker::loc_id_t>> const & predecessors,
+                   std::vector<std::vector<tchecker::loc_id_t>> const & targets);
+      
+      tchecker::loc_id_t _locations_count;                              /*!< Number of locations */
+      std::vector<std::vector<tchecker::process_id_t>> _processes;      /*!< Map : label rank -> contributing processes */
+      std::vector<tchecker::distances::distance_t> _distances;          /*!< Map : (label rank, loc ID) -> distance */
+    };
+    
+  } // end of namespace distances
+  
+} // end of namespace tchecker
+
+#endif // TCHECKER_DISTANCES_HH
@@ -0,0 +1,530 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_FLAT_SYSTEM_OUTGOING_EDGES_CACHE_HH
+#define TCHECKER_FLAT_SYSTEM_OUTGOING_EDGES_CACHE_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/flat_system/synchronizer.hh"
+#include "tchecker/flat_system/vloc.hh"
+#include "tchecker/utils/iterator.hh"
+
+/*!
+ \file outgoing_edges_cache.hh
+ \brief Cache of outgoing edges from tuples of locations
+ */
+
+namespace tchecker {
+  
+  namespace details {
+    
+    /*!
+     \class outgoing_vedges_t
+     \brief Outgoing tuples of edges from a tuple of locations, stored contiguously
+     \tparam EDGE : type of edges
+     */
+    template <class EDGE>
+    class outgoing_vedges_t {
+    public:
+      /*!
+       \brief Constructor
+       \post this is empty
+       */
+      outgoing_vedges_t() : _offsets(1, 0)
+      {}
+      
+      /*!
+       \brief Copy constructor
+       */
+      outgoing_vedges_t(tchecker::details::outgoing_vedges_t<EDGE> const &) = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      outgoing_vedges_t(tchecker::details::outgoing_vedges_t<EDGE> &&) = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~outgoing_vedges_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::details::outgoing_vedges_t<EDGE> & operator= (tchecker::details::outgoing_vedges_t<EDGE> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::details::outgoing_vedges_t<EDGE> & operator= (tchecker::details::outgoing_vedges_t<EDGE> &&) = default;
+      
+      /*!
+       \brief Clear
+       \post this is empty
+       \note memory is kept for later use
+       */
+      void clear()
+      {
+        _edges.clear();
+        _offsets.resize(1);
+      }
+      
+      /*!
+       \brief Add a tuple of edges
+       \param vedge : range of edges
+       \post the edges in vedge have been added to this as a tuple of edges
+       */
+      template <class VEDGE>
+      void add(VEDGE && vedge)
+      {
+        for (EDGE const * edge : vedge)
+          _edges.push_back(edge);
+        _offsets.push_back(_edges.size());
+      }
+      
+      /*!
+       \brief Accessor
+       \return number of tuples of edges
+       */
+      inline std::size_t size() const
+      {
+        return _offsets.size() - 1;
+      }
+      
+      /*!
+       \brief Accessor
+       \param i : index of a tuple of edges
+       \pre i < size() (checked by assertion)
+       \return pointer to the first edge in the i-th tuple of edges
+       */
+      inline EDGE const * const * begin(std::size_t i) const
+      {
+        assert(i < size());
+        return _edges.data() + _offsets[i];
+      }
+      
+      /*!
+       \brief Accessor
+       \param i : index of a tuple of edges
+       \pre i < size() (checked by assertion)
+       \return past-the-end pointer of the i-th tuple of edges
+       */
+      inline EDGE const * const * end(std::size_t i) const
+      {
+        assert(i < size());
+        return _edges.data() + _offsets[i + 1];
+      }
+    private:
+      std::vector<EDGE const *> _edges;       /*!< Edges of all tuples, in order */
+      std::vector<std::size_t> _offsets;      /*!< Offset of each tuple in _edges, followed by _edges.size() */
+    };
+    
+    
+    
+    
+    /*!
+     \class outgoing_edges_cache_iterator_t
+     \brief Iterator over tuples of edges in a cache entry
+     \tparam EDGE : type of edges
+     \tparam VEDGE_ITERATOR : type of iterator over a tuple of edges, should be an instance of
+     tchecker::vedge_iterator_t<EDGE, ...>
+     \note if a filter is given, the tuples of edges that contain an edge that does not pass
+     the filter are skipped
+     */
+    template <class EDGE, class VEDGE_ITERATOR>
+    class outgoing_edges_cache_iterator_t {
+    public:
+      /*!
+       \brief Constructor
+       \param vedges : tuples of edges
+       \param i : index of a tuple of edges in vedges
+       \param filter : filter on edges (nullptr if no filtering)
+       \note this keeps a pointer to vedges and to filter
+       */
+      outgoing_edges_cache_iterator_t(tchecker::details::outgoing_vedges_t<EDGE> const & vedges,
+                                      std::size_t i,
+                                      tchecker::details::edges_filter_t<EDGE> const * filter = nullptr)
+      : _vedges(&vedges), _i(i), _filter(filter)
+      {
+        skip_filtered_vedges();
+      }
+      
+      /*!
+       \brief Copy constructor
+       */
+      outgoing_edges_cache_iterator_t(tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> const &)
+      = default;
+      
+      /*!
+       \brief Move constructor
+       */
+      outgoing_edges_cache_iterator_t(tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> &&)
+      = default;
+      
+      /*!
+       \brief Destructor
+       */
+      ~outgoing_edges_cache_iterator_t() = default;
+      
+      /*!
+       \brief Assignment operator
+       */
+      tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> &
+      operator= (tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> const &) = default;
+      
+      /*!
+       \brief Move-assignment operator
+       */
+      tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> &
+      operator= (tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> &&) = default;
+      
+      /*!
+       \brief Equality check
+       \param it : iterator
+       \return true if this and it point to the same tuple of edges, false otherwise
+       */
+      bool operator== (tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> const & it) const
+      {
+        return ((_vedges == it._vedges) && (_i == it._i));
+      }
+      
+      /*!
+       \brief Disequality check
+       \param it : iterator
+       \return false if this and it point to the same tuple of edges, true otherwise
+       */
+      bool operator!= (tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> const & it) const
+      {
+        return !(*this == it);
+      }
+      
+      /*!
+       \brief Accessor
+       \return true if this is at the end of the range, false otherwise
+       */
+      inline bool at_end() const
+      {
+        return (_i >= _vedges->size());
+      }
+      
+      /*!
+       \brief Accessor
+       \pre not at_end() (checked by assertion)
+       \return Range of iterator over tuple of edges pointed by this
+       */
+      tchecker::range_t<VEDGE_ITERATOR> operator* () const
+      {
+        assert( ! at_end() );
+        return tchecker::make_range(VEDGE_ITERATOR(_vedges->begin(_i)), VEDGE_ITERATOR(_vedges->end(_i)));
+      }
+      
+      /*!
+       \brief Move to next
+       \pre not at_end() (checked by assertion)
+       \post this points to next tuple of edges (if any)
+       \return this after increment
+       */
+      tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR> & operator++ ()
+      {
+        assert( ! at_end() );
+        ++ _i;
+        skip_filtered_vedges();
+        return *this;
+      }
+    private:
+      /*!
+       \brief Skip filtered tuples of edges
+       \post either at_end(), or all the edges in the tuple pointed by this pass the filter
+       */
+      void skip_filtered_vedges()
+      {
+        if (_filter == nullptr)
+          return;
+        for ( ; ! at_end(); ++ _i) {
+          EDGE const * const * it = _vedges->begin(_i), * const * end = _vedges->end(_i);
+          while ((it != end) && _filter->enabled(*it))
+            ++ it;
+          if (it == end)
+            return;
+        }
+      }
+      
+      tchecker::details::outgoing_vedges_t<EDGE> const * _vedges;    /*!< Tuples of edges */
+      std::size_t _i;                                                 /*!< Index of current tuple of edges */
+      tchecker::details::edges_filter_t<EDGE> const * _filter;       /*!< Filter on edges (may be nullptr) */
+    };
+  
+  } // end of namespace details
+  
+  
+  
+  
+  /*!
+   \class outgoing_edges_cache_t
+   \brief Cache of outgoing tuples of edges from tuples of locations
+   \tparam SYSTEM : type of system, must inherit from tchecker::system_t
+   \tparam VLOC : type of tuple of locations, should be an instance of tchecker::vloc_t
+   \note the outgoing tuples of edges from a tuple of locations only depend on the tuple
+   of locations. They are computed by a tchecker::synchronizer_t the first time they are
+   required, and they are then stored in the cache. The cache keeps at most capacity tuples
+   of locations, and evicts the least recently used one when full
+   */
+  template <class SYSTEM, class VLOC>
+  class outgoing_edges_cache_t {
+  public:
+    /*!
+     \brief Type of edges
+     */
+    using edge_t = typename SYSTEM::edge_t;
+    
+    /*!
+     \brief Type of iterator over a tuple of edges
+     \note same as for tchecker::synchronizer_t
+     */
+    using vedge_iterator_t = typename tchecker::synchronizer_t<SYSTEM>::template iterator_t<VLOC>::vedge_iterator_t;
+    
+    /*!
+     \brief Type of iterator over outgoing tuples of edges
+     */
+    using iterator_t = tchecker::details::outgoing_edges_cache_iterator_t<edge_t, vedge_iterator_t>;
+    
+    /*!
+     \brief Constructor
+     \param system : system of processes
+     \param synchronizer : synchronizer for system
+     \param capacity : maximal number of tuples of locations in the cache
+     \pre capacity > 0
+     \throw std::invalid_argument : if capacity is 0
+     \note this keeps references to system and synchronizer
+     */
+    outgoing_edges_cache_t(SYSTEM const & system,
+                           tchecker::synchronizer_t<SYSTEM> const & synchronizer,
+                           std::size_t capacity)
+    : _system(system), _synchronizer(synchronizer), _capacity(capacity)
+    {
+      if (_capacity == 0)
+        throw std::invalid_argument("Cache of outgoing edges should have a positive capacity");
+    }
+    
+    /*!
+     \brief Copy constructor
+     \param cache : a cache
+     \post this is an empty cache with the same system, synchronizer and capacity as cache
+     */
+    outgoing_edges_cache_t(tchecker::outgoing_edges_cache_t<SYSTEM, VLOC> const & cache)
+    : _system(cache._system), _synchronizer(cache._synchronizer), _capacity(cache._capacity)
+    {}
+    
+    /*!
+     \brief Move constructor
+     */
+    outgoing_edges_cache_t(tchecker::outgoing_edges_cache_t<SYSTEM, VLOC> &&) = default;
+    
+    /*!
+     \brief Destructor
+     */
+    ~outgoing_edges_cache_t() = default;
+    
+    /*!
+     \brief Assignment operator (deleted)
+     */
+    tchecker::outgoing_edges_cache_t<SYSTEM, VLOC> &
+    operator= (tchecker::outgoing_edges_cache_t<SYSTEM, VLOC> const &) = delete;
+    
+    /*!
+     \brief Move-assignment operator (deleted)
+     */
+    tchecker::outgoing_edges_cache_t<SYSTEM, VLOC> &
+    operator= (tchecker::outgoing_edges_cache_t<SYSTEM, VLOC> &&) = delete;
+    
+    /*!
+     \brief Accessor
+     \param vloc : tuple of locations
+     \param filter : filter on edges (nullptr if no filtering)
+     \return range of synchronous and asynchronous outgoing edges from vloc, in the same order as
+     tchecker::synchronizer_t::outgoing_edges, where tuples of edges that contain an edge that does
+     not pass filter are skipped
+     \note the returned range is invalidated when vloc is evicted from the cache, hence it is valid
+     until the next call to outgoing_edges if capacity is 1, and for at least capacity - 1 subsequent
+     calls otherwise. The returned range keeps a pointer to filter
+     */
+    tchecker::range_t<iterator_t> outgoing_edges(VLOC const & vloc,
+                                                 tchecker::details::edges_filter_t<edge_t> const * filter = nullptr)
+    {
+      tchecker::details::outgoing_vedges_t<edge_t> const & vedges = lookup(vloc);
+      return tchecker::make_range(iterator_t(vedges, 0, filter), iterator_t(vedges, vedges.size()));
+    }
+    
+    /*!
+     \brief Fill the cache with all tuples of locations in the system
+     \param max_size : maximal number of tuples of locations
+     \post if the number of tuples of locations in the system does not exceed max_size nor the
+     capacity, then the outgoing edges of all tuples of locations have been stored in the cache, and
+     further calls to outgoing_edges do not use the synchronizer
+     \return true if the cache has been filled, false otherwise (the cache is left unchanged)
+     */
+    bool prebuild(std::size_t max_size)
+    {
+      max_size = std::min(max_size, _capacity);
+      
+      tchecker::process_id_t const processes_count = _system.processes_count();
+      std::vector<std::vector<typename VLOC::loc_t *>> locations(processes_count);
+      for (typename VLOC::loc_t * loc : _system.locations())
+        locations[loc->pid()].push_back(loc);
+      
+      std::size_t count = 1;
+      for (auto const & process_locations : locations) {
+        if (process_locations.empty())
+          return true;
+        if (process_locations.size() > max_size / count)
+          return false;
+        count *= process_locations.size();
+      }
+      
+      VLOC * vloc = tchecker::vloc_allocate_and_construct<typename VLOC::loc_t>(processes_count, processes_count);
+      std::vector<std::size_t> index(processes_count, 0);
+      for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid)
+        (*vloc)[pid] = locations[pid][0];
+      
+      for (std::size_t n = 0; n < count; ++n) {
+        lookup(*vloc);
+        // next tuple of locations
+        for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid) {
+          if (++ index[pid] < locations[pid].size()) {
+            (*vloc)[pid] = locations[pid][index[pid]];
+            break;
+          }
+          index[pid] = 0;
+          (*vloc)[pid] = locations[pid][0];
+        }
+      }
+      
+      tchecker::vloc_destruct_and_deallocate(vloc);
+      return true;
+    }
+    
+    /*!
+     \brief Accessor
+     \return number of tuples of locations in the cache
+     */
+    inline std::size_t size() const
+    {
+      return _entries.size();
+    }
+    
+    /*!
+     \brief Accessor
+     \return maximal number of tuples of locations in the cache
+     */
+    inline std::size_t capacity() const
+    {
+      return _capacity;
+    }
+  private:
+    /*!
+     \brief Type of keys: identifiers of locations in a tuple of locations
+     */
+    using key_t = std::vector<tchecker::loc_id_t>;
+    
+    /*!
+     \brief Type of cache entries
+     */
+    struct entry_t {
+      key_t _key;                                         /*!< Key */
+      tchecker::details::outgoing_vedges_t<edge_t> _vedges;  /*!< Outgoing tuples of edges */
+    };
+    
+    /*!
+     \brief Type of hash function on keys
+     */
+    struct key_hash_t {
+      std::size_t operator() (key_t const & key) const
+      {
+        return boost::hash_range(key.begin(), key.end());
+      }
+    };
+    
+    /*!
+     \brief Lookup
+     \param vloc : tuple of locations
+     \post the entry for vloc is the most recently used one in the cache. It has been computed if
+     vloc was not in the cache, and the least recently used entry has been evicted if the cache was
+     full
+     \return outgoing tuples of edges from vloc
+     */
+    tchecker::details::outgoing_vedges_t<edge_t> const & lookup(VLOC const & vloc)
+    {
+      _key.clear();
+      for (typename VLOC::loc_t const * loc : vloc)
+        _key.push_back(loc->id());
+      
+      auto it = _index.find(_key);
+      if (it != _index.end()) {
+        if (it->second != _entries.begin())
+          _entries.splice(_entries.begin(), _entries, it->second);
+        return _entries.front()._vedges;
+      }
+      
+      if (_entries.size() < _capacity)
+        _entries.emplace_front();
+      else {
+        _index.erase(_entries.back()._key);
+        _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+      }
+      
+      entry_t & entry = _entries.front();
+      entry._key = _key;
+      entry._vedges.clear();
+      auto range = _synchronizer.outgoing_edges(vloc);
+      for (auto vit = range.begin(); ! vit.at_end(); ++vit)
+        entry._vedges.add(*vit);
+      _index.emplace(entry._key, _entries.begin());
+      
+      return entry._vedges;
+    }
+    
+    SYSTEM const & _system;                                       /*!< System of processes */
+    tchecker::synchronizer_t<SYSTEM> const & _synchronizer;       /*!< Synchronizer */
+    std::size_t const _capacity;                                  /*!< Maximal number of entries */
+    std::list<entry_t> _entries;                                  /*!< Entries, most recently used first */
+    std::unordered_map<key_t, typename std::list<entry_t>::iterator, key_hash_t> _index;  /*!< Key -> entry */
+    key_t _key;                                                   /*!< Scratch key */
+  };
+
+} // end of namespace tchecker
+
+
+
+
+/*!
+ \brief Iterator traits for tchecker::details::outgoing_edges_cache_iterator_t
+ */
+template <class EDGE, class VEDGE_ITERATOR>
+struct std::iterator_traits<tchecker::details::outgoing_edges_cache_iterator_t<EDGE, VEDGE_ITERATOR>> {
+  using difference_type = nullptr_t;
+  
+  using value_type = tchecker::range_t<VEDGE_ITERATOR>;
+  
+  using pointer = value_type *;
+  
+  using reference = value_type &;
+  
+  using iterator_category = std::forward_iterator_tag;
+};
+
+#endif // TCHECKER_FLAT_SYSTEM_OUTGOING_EDGES_CACHE_HH
@@ -165,6 +165,94 @@ namespace tchecker {
     
     
     
+    /*!
+     \class edges_filter_t
+     \brief Filter on edges, applied to the edges of each process before synchronization
+     \tparam EDGE : type of edges
+     \note the filtered edges are stored in the filter, hence ranges of edges returned by
+     a filter are only valid until the filter is applied again at the same position
+     */
+    template <class EDGE>
+    class edges_filter_t {
+    public:
+      /*!
+       \brief Type of predicate on edges
+       */
+      using predicate_t = std::function<bool(EDGE const *)>;
+      
+      /*!
+       \brief Type of iterator over filtered edges
+       */
+      using const_iterator_t = typename std::vector<EDGE const *>::const_iterator;
+      
+      /*!
+       \brief Constructor
+       \param enabled : predicate on edges
+       \post this filter keeps the edges that satisfy enabled
+       */
+      explicit edges_filter_t(predicate_t const & enabled) : _enabled(enabled)
+      {}
+      
+      /*!
+       \brief Copy constructor (deleted)
+       */
+      edges_filter_t(tchecker::details::edges_filter_t<EDGE> const &) = delete;
+      
+      /*!
+       \brief Move constructor (deleted)
+       */
+      edges_filter_t(tchecker::details::edges_filter_t<EDGE> &&) = delete;
+      
+      /*!
+       \brief Destructor
+       */
+      ~edges_filter_t() = default;
+      
+      /*!
+       \brief Assignment operator (deleted)
+       */
+      tchecker::details::edges_filter_t<EDGE> & operator= (tchecker::details::edges_filter_t<EDGE> const &) = delete;
+      
+      /*!
+       \brief Move-assignment operator (deleted)
+       */
+      tchecker::details::edges_filter_t<EDGE> & operator= (tchecker::details::edges_filter_t<EDGE> &&) = delete;
+      
+      /*!
+       \brief Accessor
+       \param edge : an edge
+       \return true if edge passes the filter, false otherwise
+       */
+      inline bool enabled(EDGE const * edge) const
+      {
+        return _enabled(edge);
+      }
+      
+      /*!
+       \brief Filter edges
+       \param k : position of edges (i.e. index of the process in the synchronization)
+       \param edges : range of edges
+       \return range of edges in edges that pass the filter
+       \note the returned range is invalidated by the next call to filter with the same position k
+       */
+      tchecker::range_t<const_iterator_t> filter(std::size_t k, tchecker::range_t<const_iterator_t> const & edges)
+      {
+        if (k >= _edges.size())
+          _edges.resize(k + 1);
+        std::vector<EDGE const *> & filtered = _edges[k];
+        filtered.clear();
+        for (EDGE const * edge : edges)
+          if (_enabled(edge))
+            filtered.push_back(edge);
+        return tchecker::make_range(filtered.cbegin(), filtered.cend());
+      }
+    private:
+      predicate_t _enabled;                          /*!< Predicate on edges */
+      std::vector<std::vector<EDGE const *>> _edges; /*!< Filtered edges, by position */
+    };
+    
+    
+    
     /*!
      \class synchronous_edges_iterator_t
      \brief Iterator over synchronous edges from a tuple of locations
@@ -181,17 +269,22 @@ namespace tchecker {
        \param loc_event_edges : map location ID * event ID -> edges
        \param sync_begin : iterator on first synchronization
        \param sync_end : past-the-end iterator on synchronizations
-       \note this keeps a pointer to vloc and a pointer to loc_event_edges
+       \param filter : filter on edges (nullptr if no filtering)
+       \note this keeps a pointer to vloc, a pointer to loc_event_edges and a pointer to filter
+       \note if filter is not nullptr, the edges of each process are filtered before their
+       cartesian product is formed
        */
       synchronous_edges_iterator_t
       (VLOC const & vloc,
        loc_edge_range_t<VLOC> (*loc_event_edges) (typename VLOC::loc_t const *, tchecker::event_id_t),
        SYNC_ITERATOR const & sync_begin,
-       SYNC_ITERATOR const & sync_end)
+       SYNC_ITERATOR const & sync_end,
+       tchecker::details::edges_filter_t<EDGE> * filter = nullptr)
       : _vloc(&vloc),
       _loc_event_edges(loc_event_edges),
       _sync_it(sync_begin),
-      _sync_end(sync_end)
+      _sync_end(sync_end),
+      _filter(filter)
       {
         advance_while_empty_cartesian_product();
       }
@@ -314,13 +407,22 @@ namespace tchecker {
       {
         while (!at_end() && _cartesian_it.at_end()) {
           _cartesian_it.clear();
+          std::size_t k = 0;
           auto constraints = _sync_it->synchronization_constraints();
           for (auto const & constr : constraints) {
             auto edges = _loc_event_edges((*_vloc)[constr.pid()], constr.event_id());
             if ((constr.strength() == tchecker::SYNC_WEAK) && (edges.begin() == edges.end()))
               continue;
-            _cartesian_it.push_back(edges);
+            if (_filter == nullptr)
+              _cartesian_it.push_back(edges);
+            else {
+              _cartesian_it.push_back(_filter->filter(k++, edges));
+              if (_cartesian_it.at_end())  // no need to filter the other processes
+                break;
+            }
           }
+          if (_cartesian_it.at_end())
+            ++ _sync_it;
         }
       }
       
@@ -331,6 +433,7 @@ namespace tchecker {
       SYNC_ITERATOR _sync_it;                                                   /*!< Iterator on first synchronization */
       SYNC_ITERATOR _sync_end;                                                  /*!< Past-the-end iterator on synchronizations */
       tchecker::cartesian_iterator_t<loc_edge_iterator_t<VLOC>> _cartesian_it;  /*!< Cartesian iterator */
+      tchecker::details::edges_filter_t<EDGE> * _filter;                        /*!< Filter on edges (may be nullptr) */
     };
     
     
@@ -397,10 +500,16 @@ namespace tchecker {
        \brief Constructor
        \param sync_it : iterator over synchronous edges
        \param async_it : iterator over asynchronous edges
+       \param filter : filter on asynchronous edges (nullptr if no filtering)
+       \note this keeps a pointer to filter
        */
-      synchronizer_iterator_t(sync_edges_iterator_t const & sync_it, async_edges_iterator_t const & async_it)
-      : _sync_it(sync_it), _async_it(async_it)
-      {}
+      synchronizer_iterator_t(sync_edges_iterator_t const & sync_it,
+                              async_edges_iterator_t const & async_it,
+                              tchecker::details::edges_filter_t<typename SYSTEM::edge_t> const * filter = nullptr)
+      : _sync_it(sync_it), _async_it(async_it), _filter(filter)
+      {
+        skip_filtered_async_edges();
+      }
       
       /*!
        \brief Copy constructor
@@ -501,11 +610,26 @@ namespace tchecker {
           ++ _sync_it;
         else
           ++ _async_it;
+        skip_filtered_async_edges();
         return *this;
       }
     private:
-      sync_edges_iterator_t _sync_it;   /*!< Iterator on synchronous edges */
-      async_edges_iterator_t _async_it; /*!< Iterator on asynchronous edges */
+      /*!
+       \brief Skip filtered asynchronous edges
+       \post if synchronous edges are at end, then either asynchronous edges are at end, or
+       the current asynchronous edge passes the filter
+       */
+      void skip_filtered_async_edges()
+      {
+        if ((_filter == nullptr) || ! _sync_it.at_end())
+          return;
+        while (! _async_it.at_end() && ! _filter->enabled(&**_async_it))
+          ++ _async_it;
+      }
+      
+      sync_edges_iterator_t _sync_it;                                         /*!< Iterator on synchronous edges */
+      async_edges_iterator_t _async_it;                                       /*!< Iterator on asynchronous edges */
+      tchecker::details::edges_filter_t<typename SYSTEM::edge_t> const * _filter;  /*!< Filter on edges (may be nullptr) */
     };
     
     
@@ -622,6 +746,29 @@ namespace tchecker {
       return edges(vloc, loc_outgoing_event<VLOC>, loc_event_outgoing_edges<VLOC>, _asynchronous_outgoing_edges_map);
     }
     
+    /*!
+     \brief Accessor
+     \param vloc : tuple of locations
+     \param filter : filter on edges
+     \return range of synchronous and asynchronous outgoing edges from vloc, that only involve edges that
+     pass filter
+     \note edges are filtered before synchronization, hence edges that do not pass filter never enter
+     the cartesian product of synchronized edges
+     \note the returned range keeps a pointer to filter, and it is invalidated by the next call with the
+     same filter
+     \note Using method at_end() is more efficient than checking equality of
+     iterators for returned range
+     \note operator++ invalidates the ranges returned by operator* of iterators
+     for returned range
+     */
+    template <class VLOC>
+    tchecker::range_t<iterator_t<VLOC>>
+    outgoing_edges(VLOC const & vloc, tchecker::details::edges_filter_t<typename SYSTEM::edge_t> & filter) const
+    {
+      return edges(vloc, loc_outgoing_event<VLOC>, loc_event_outgoing_edges<VLOC>, _asynchronous_outgoing_edges_map,
+                   &filter);
+    }
+    
     
     /*!
      \brief Accessor
@@ -735,8 +882,9 @@ namespace tchecker {
      \param vloc : tuple of locations
      \param loc_has_event : map location * event ID -> bool
      \param loc_event_edges : map location * event ID -> edges
+     \param filter : filter on edges (nullptr if no filtering)
      \return Range of enabled synchronous edges in vloc w.r.t. loc_has_event
-     ans loc_event_edges
+     ans loc_event_edges, that only involve edges that pass filter
      \note Using method at_end() is more efficient than checking equality of
      iterators for returned range
      */
@@ -744,15 +892,16 @@ namespace tchecker {
     tchecker::range_t<synchronous_edges_iterator_t<VLOC>> synchronous_edges
     (VLOC const & vloc,
      bool (*loc_has_event) (typename VLOC::loc_t const *, tchecker::event_id_t),
-     tchecker::details::loc_edge_range_t<VLOC> (*loc_event_edges) (typename VLOC::loc_t const *, tchecker::event_id_t)) const
+     tchecker::details::loc_edge_range_t<VLOC> (*loc_event_edges) (typename VLOC::loc_t const *, tchecker::event_id_t),
+     tchecker::details::edges_filter_t<typename SYSTEM::edge_t> * filter) const
     {
       auto syncs = _system.synchronizations();
       
       auto enabled_syncs = filter_enabled_syncs<VLOC>(vloc, syncs.begin(), syncs.end(), loc_has_event);
       
       synchronous_edges_iterator_t<VLOC>
-      begin(vloc, loc_event_edges, enabled_syncs.begin(), enabled_syncs.end()),
-      end(vloc, loc_event_edges, enabled_syncs.end(), enabled_syncs.end());
+      begin(vloc, loc_event_edges, enabled_syncs.begin(), enabled_syncs.end(), filter),
+      end(vloc, loc_event_edges, enabled_syncs.end(), enabled_syncs.end(), filter);
       
       return tchecker::make_range(begin, end);
     }
@@ -795,8 +944,9 @@ namespace tchecker {
      \param loc_has_event : map location * event ID -> bool
      \param loc_event_edges : map location * event ID -> eges
      \param loc_edges_map : map location ID -> edges
+     \param filter : filter on edges (nullptr if no filtering)
      \return range of enabled vedges on vloc according to loc_has_event,
-     loc_event_edges and loc_edges_map
+     loc_event_edges and loc_edges_map, that only involve edges that pass filter
      \note Using method at_end() is more efficient than checking equality of
      iterators for returned range
      */
@@ -805,13 +955,16 @@ namespace tchecker {
     edges(VLOC const & vloc,
           bool (*loc_has_event) (typename VLOC::loc_t const *, tchecker::event_id_t),
           tchecker::details::loc_edge_range_t<VLOC> (*loc_event_edges) (typename VLOC::loc_t const *, tchecker::event_id_t),
-          tchecker::details::location_edges_map_t<typename SYSTEM::edge_t> const & loc_edges_map) const
+          tchecker::details::location_edges_map_t<typename SYSTEM::edge_t> const & loc_edges_map,
+          tchecker::details::edges_filter_t<typename SYSTEM::edge_t> * filter = nullptr) const
     {
-      auto sync_edges = synchronous_edges<VLOC>(vloc, loc_has_event, loc_event_edges);
+      auto sync_edges = synchronous_edges<VLOC>(vloc, loc_has_event, loc_event_edges, filter);
       
       auto async_edges = asynchronous_edges<VLOC>(vloc, loc_edges_map);
       
-      iterator_t<VLOC> begin(sync_edges.begin(), async_edges.begin()), end(sync_edges.end(), async_edges.end());
+      iterator_t<VLOC>
+      begin(sync_edges.begin(), async_edges.begin(), filter),
+      end(sync_edges.end(), async_edges.end(), filter);
       
       return tchecker::make_range(begin, end);
     }
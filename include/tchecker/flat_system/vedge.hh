@@ -24,7 +24,8 @@ namespace tchecker {
    \tparam EDGE_ITERATOR : type of edge iterator, must be default constructible
    and must dereference to EDGE
    \note Iterator can be built either from a pointer to EDGE (vedge made of a
-   single edge) or from an iterator on EDGE (vedge made of many edges)
+   single edge), from an iterator on EDGE (vedge made of many edges), or from a
+   pointer in an array of pointers to EDGE (vedge stored contiguously)
    */
   template <class EDGE, class EDGE_ITERATOR>
   class vedge_iterator_t {
@@ -37,7 +38,8 @@ namespace tchecker {
      \throw std::invalid_argument : if edge is nullptr
      */
     explicit vedge_iterator_t(EDGE const * edge)
-    : _edge(edge)
+    : _edge(edge),
+    _edges(nullptr)
     {
       if (edge == nullptr)
         throw std::invalid_argument("nullptr edge");
@@ -50,9 +52,25 @@ namespace tchecker {
      */
     vedge_iterator_t(EDGE_ITERATOR const & it)
     : _edge(nullptr),
+    _edges(nullptr),
     _it(it)
     {}
     
+    /*!
+     \brief Constructor
+     \param edges : pointer in an array of edges
+     \pre edges != nullptr
+     \post this is an iterator on the array of edges, starting from edges
+     \throw std::invalid_argument : if edges is nullptr
+     */
+    explicit vedge_iterator_t(EDGE const * const * edges)
+    : _edge(nullptr),
+    _edges(edges)
+    {
+      if (edges == nullptr)
+        throw std::invalid_argument("nullptr edges");
+    }
+    
     /*!
      \brief Copy constructor
      \post this is a copy of it
@@ -96,7 +114,7 @@ namespace tchecker {
     bool operator==
     (tchecker::vedge_iterator_t<EDGE, EDGE_ITERATOR> const & it) const
     {
-      return ((_edge == it._edge) && (_it == it._it));
+      return ((_edge == it._edge) && (_edges == it._edges) && (_it == it._it));
     }
     
     /*!
@@ -116,9 +134,11 @@ namespace tchecker {
      */
     EDGE const * operator* ()
     {
-      if (_edge == nullptr)
-        return *_it;
-      return _edge;
+      if (_edge != nullptr)
+        return _edge;
+      if (_edges != nullptr)
+        return *_edges;
+      return *_it;
     }
     
     /*!
@@ -129,15 +149,18 @@ namespace tchecker {
      */
     tchecker::vedge_iterator_t<EDGE, EDGE_ITERATOR> & operator++ ()
     {
-      if (_edge == nullptr)
-        ++_it;
-      else
+      if (_edge != nullptr)
         ++ _edge;
+      else if (_edges != nullptr)
+        ++ _edges;
+      else
+        ++_it;
       return *this;
     }
   private:
-    EDGE const * _edge;   /*!< Single edge in vedge (if not nullptr) */
-    EDGE_ITERATOR _it;    /*!< Iterator (if _edge is nullptr) */
+    EDGE const * _edge;            /*!< Single edge in vedge (if not nullptr) */
+    EDGE const * const * _edges;   /*!< Array of edges in vedge (if not nullptr) */
+    EDGE_ITERATOR _it;             /*!< Iterator (if _edge and _edges are nullptr) */
   };
   
 } // end of namespace tchecker
@@ -8,6 +8,9 @@
 #ifndef TCHECKER_FSM_DETAILS_ALLOCATORS_HH
 #define TCHECKER_FSM_DETAILS_ALLOCATORS_HH
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "tchecker/fsm/details/transition.hh"
 #include "tchecker/ts/allocators.hh"
 #include "tchecker/utils/gc.hh"
@@ -25,12 +28,137 @@ namespace tchecker {
     
     namespace details {
       
+      /*!
+       \class shared_components_t
+       \brief Hash table of shared components of states (tuples of locations, integer variables valuations, etc)
+       \tparam T : type of components, should be allocated from a tchecker::pool_t<T>
+       \note The table keeps a reference to its components. Components that are only referenced by the table are
+       removed from the table, and destructed, when the table grows beyond twice its size after the last removal
+       */
+      template <class T>
+      class shared_components_t {
+      public:
+        /*!
+         \brief Constructor
+         \param pool : pool of components
+         \post this table is empty and keeps a reference on pool
+         */
+        explicit shared_components_t(tchecker::pool_t<T> & pool) : _pool(pool), _prune_size(MIN_PRUNE_SIZE)
+        {}
+        
+        /*!
+         \brief Copy constructor (deleted)
+         */
+        shared_components_t(tchecker::fsm::details::shared_components_t<T> const &) = delete;
+        
+        /*!
+         \brief Move constructor (deleted)
+         */
+        shared_components_t(tchecker::fsm::details::shared_components_t<T> &&) = delete;
+        
+        /*!
+         \brief Destructor
+         */
+        ~shared_components_t() = default;
+        
+        /*!
+         \brief Assignment operator (deleted)
+         */
+        tchecker::fsm::details::shared_components_t<T> &
+        operator= (tchecker::fsm::details::shared_components_t<T> const &) = delete;
+        
+        /*!
+         \brief Move-assignment operator (deleted)
+         */
+        tchecker::fsm::details::shared_components_t<T> &
+        operator= (tchecker::fsm::details::shared_components_t<T> &&) = delete;
+        
+        /*!
+         \brief Share a component
+         \param p : pointer to a component
+         \pre p has been allocated from the pool of this table, and *p will not be modified anymore
+         \post p points to the component in this table that is equal to *p. The component initially pointed by p
+         has been added to this table if there was no equal component, and it has been destructed if p was the only
+         pointer to it otherwise
+         \return true if p has been replaced by an equal shared component, false otherwise
+         */
+        bool share(tchecker::intrusive_shared_ptr_t<T> & p)
+        {
+          auto it = _table.find(p);
+          if (it == _table.end()) {
+            _table.insert(p);
+            if (_table.size() >= _prune_size)
+              prune();
+            return false;
+          }
+          if (it->ptr() == p.ptr())
+            return false;
+          
+          tchecker::intrusive_shared_ptr_t<T> copy(p);
+          p = *it;
+          _pool.destruct(copy);
+          return true;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of shared components
+         */
+        inline std::size_t size() const
+        {
+          return _table.size();
+        }
+        
+        /*!
+         \brief Clear
+         \post this table is empty. No component has been destructed
+         */
+        void clear()
+        {
+          _table.clear();
+          _prune_size = MIN_PRUNE_SIZE;
+        }
+      private:
+        /*!
+         \brief Remove components that are not used anymore
+         \post all components that were only referenced by this table have been removed from this table and
+         destructed
+         */
+        void prune()
+        {
+          for (auto it = _table.begin(); it != _table.end(); ) {
+            if ((*it)->refcount() == 1) {
+              tchecker::intrusive_shared_ptr_t<T> p(*it);
+              it = _table.erase(it);
+              _pool.destruct(p);
+            }
+            else
+              ++it;
+          }
+          _prune_size = std::max(MIN_PRUNE_SIZE, 2 * _table.size());
+        }
+        
+        static constexpr std::size_t MIN_PRUNE_SIZE = 1024;  /*!< Minimal size before pruning the table */
+        
+        std::unordered_set<tchecker::intrusive_shared_ptr_t<T>,
+        tchecker::intrusive_shared_ptr_delegate_hash_t,
+        tchecker::intrusive_shared_ptr_delegate_equal_to_t> _table;   /*!< Shared components */
+        tchecker::pool_t<T> & _pool;                                      /*!< Pool of components */
+        std::size_t _prune_size;                                          /*!< Size of the table triggering pruning */
+      };
+      
+      
+      
+      
       /*!
        \class state_pool_allocator_t
        \brief Pool allocator for FSM states
        \tparam STATE : type of state, should inherit from tchecker::fsm::details::state_t
        \tparam VLOC : type of tuple of locations
        \tparam INTVARS_VAL : type of integer variables valuations
+       \note When sharing is enabled, states with equal tuples of locations (resp. integer variables valuations)
+       share the same tuple of locations (resp. integer variables valuation), see share(). Shared components are
+       stored in hash tables (see tchecker::fsm::details::shared_components_t)
        */
       template <class STATE, class VLOC=typename STATE::vloc_t, class INTVARS_VAL=typename STATE::intvars_valuation_t>
       class state_pool_allocator_t : protected tchecker::ts::state_pool_allocator_t<STATE> {
@@ -67,14 +195,21 @@ namespace tchecker {
          \param vloc_capacity : capacity of allocated tuples of locations
          \param intvars_val_alloc_nb : number of integer variables valuations allocated in one block
          \param intvars_val_capacity : capacity of allocated integer variables valuations
+         \param share_components : sharing flag for tuples of locations and integer variables valuations
          */
         state_pool_allocator_t(std::size_t state_alloc_nb, std::size_t vloc_alloc_nb, std::size_t vloc_capacity,
-                               std::size_t intvars_val_alloc_nb, std::size_t intvars_val_capacity)
+                               std::size_t intvars_val_alloc_nb, std::size_t intvars_val_capacity,
+                               bool share_components = false)
         : tchecker::ts::state_pool_allocator_t<STATE>(state_alloc_nb),
         _vloc_capacity(vloc_capacity),
         _intvars_val_capacity(intvars_val_capacity),
         _vloc_pool(vloc_alloc_nb, tchecker::allocation_size_t<VLOC>::alloc_size(_vloc_capacity)),
-        _intvars_val_pool(intvars_val_alloc_nb, tchecker::allocation_size_t<INTVARS_VAL>::alloc_size(_intvars_val_capacity))
+        _intvars_val_pool(intvars_val_alloc_nb, tchecker::allocation_size_t<INTVARS_VAL>::alloc_size(_intvars_val_capacity)),
+        _share_components(share_components),
+        _shared_vlocs(_vloc_pool),
+        _shared_intvars_vals(_intvars_val_pool),
+        _vloc_sharing_count(0),
+        _intvars_val_sharing_count(0)
         {}
         
         /*!
@@ -138,6 +273,61 @@ namespace tchecker {
                                                                  _intvars_val_pool.construct(state.intvars_valuation()));
         }
         
+        /*!
+         \brief Share components of a state
+         \param state : a state
+         \pre state has been constructed by this allocator, and its tuple of locations and integer variables
+         valuation will not be modified anymore
+         \post if sharing is enabled, the tuple of locations (resp. integer variables valuation) of state has been
+         replaced by an equal shared one if any, and it has been made shared otherwise. The replaced components have
+         been destructed if state was the only one pointing to them. Does nothing if sharing is disabled
+         */
+        void share(STATE & state)
+        {
+          if (! _share_components)
+            return;
+          _vloc_sharing_count += (_shared_vlocs.share(state.vloc_ptr()) ? 1 : 0);
+          _intvars_val_sharing_count += (_shared_intvars_vals.share(state.intvars_val_ptr()) ? 1 : 0);
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of shared tuples of locations
+         */
+        inline std::size_t shared_vlocs_count() const
+        {
+          return _shared_vlocs.size();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Memory saved by sharing tuples of locations (i.e. number of copies replaced by a shared tuple of
+         locations, times the allocation size of tuples of locations)
+         */
+        inline std::size_t vloc_saved_memsize() const
+        {
+          return _vloc_sharing_count * tchecker::allocation_size_t<VLOC>::alloc_size(_vloc_capacity);
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of shared integer variables valuations
+         */
+        inline std::size_t shared_intvars_vals_count() const
+        {
+          return _shared_intvars_vals.size();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Memory saved by sharing integer variables valuations (i.e. number of copies replaced by a shared
+         valuation, times the allocation size of integer variables valuations)
+         */
+        inline std::size_t intvars_val_saved_memsize() const
+        {
+          return _intvars_val_sharing_count * tchecker::allocation_size_t<INTVARS_VAL>::alloc_size(_intvars_val_capacity);
+        }
+        
         /*!
          \brief Destruct state
          \param p : pointer to state
@@ -183,6 +373,7 @@ namespace tchecker {
          */
         void destruct_all()
         {
+          clear_shared_components();
           tchecker::ts::state_pool_allocator_t<STATE>::destruct_all();
           _vloc_pool.destruct_all();
           _intvars_val_pool.destruct_all();
@@ -195,6 +386,7 @@ namespace tchecker {
          */
         void free_all()
         {
+          clear_shared_components();
           tchecker::ts::state_pool_allocator_t<STATE>::free_all();
           _vloc_pool.free_all();
           _intvars_val_pool.free_all();
@@ -224,10 +416,25 @@ namespace tchecker {
           _intvars_val_pool.enroll(gc);
         }
       protected:
-        std::size_t _vloc_capacity;                        /*!< Capacity of tuples of locations */
-        std::size_t _intvars_val_capacity;                 /*!< Capacity of integer variables valuations */
-        tchecker::pool_t<VLOC> _vloc_pool;                 /*!< Pool of tuples of locations */
-        tchecker::pool_t<INTVARS_VAL> _intvars_val_pool;   /*!< Pool of integer variables valuations */
+        /*!
+         \brief Clear shared components
+         \post The hash tables of shared components are empty
+         */
+        void clear_shared_components()
+        {
+          _shared_vlocs.clear();
+          _shared_intvars_vals.clear();
+        }
+        
+        std::size_t _vloc_capacity;                                                      /*!< Capacity of tuples of locations */
+        std::size_t _intvars_val_capacity;                                               /*!< Capacity of integer variables valuations */
+        tchecker::pool_t<VLOC> _vloc_pool;                                               /*!< Pool of tuples of locations */
+        tchecker::pool_t<INTVARS_VAL> _intvars_val_pool;                                 /*!< Pool of integer variables valuations */
+        bool _share_components;                                                          /*!< Sharing flag */
+        tchecker::fsm::details::shared_components_t<VLOC> _shared_vlocs;                 /*!< Shared tuples of locations */
+        tchecker::fsm::details::shared_components_t<INTVARS_VAL> _shared_intvars_vals;   /*!< Shared integer variables valuations */
+        std::size_t _vloc_sharing_count;                                                 /*!< Number of shared tuples of locations copies */
+        std::size_t _intvars_val_sharing_count;                                          /*!< Number of shared valuations copies */
       };
       
       
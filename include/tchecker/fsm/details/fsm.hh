@@ -8,9 +8,16 @@
 #ifndef TCHECKER_FSM_DETAILS_FSM_HH
 #define TCHECKER_FSM_DETAILS_FSM_HH
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/flat_system/flat_system.hh"
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/native.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -27,6 +34,12 @@ namespace tchecker {
       /*!
        \class fsm_t
        \brief Finite state machine details
+       \note if the model has packed integer variables (see tchecker::fsm::details::model_t::pack_integer_variables),
+       valuations in states are packed. They are unpacked to an internal valuation for bytecode interpretation, and
+       packed back into states
+       \note outgoing edges can be pre-filtered w.r.t. a valuation of integer variables: edges with a guard that
+       does not involve clocks are discarded before synchronization when their guard does not hold. Verdicts are
+       cached for each edge, indexed by the values of the integer variables read by its guard
        */
       template <class MODEL, class VLOC, class INTVARS_VAL>
       class fsm_t : protected tchecker::flat_system::flat_system_t<MODEL, VLOC> {
@@ -53,18 +66,40 @@ namespace tchecker {
          */
         explicit fsm_t(MODEL & model)
         : tchecker::flat_system::flat_system_t<MODEL, VLOC>(model),
-        _vm(model.flattened_integer_variables().size(), model.flattened_clock_variables().size())
+        _vm(model.flattened_integer_variables().size(), model.flattened_clock_variables().size(), model.vm_stack_size()),
+        _unpacked_intvars_val(allocate_unpacked_intvars_val(model)),
+        _filter_intvars_val(allocate_filter_intvars_val(model)),
+        _edges_filter([this] (edge_t const * edge) { return integer_guard_enabled(edge); }),
+        _guards_verdicts(model.system().edges_count())
         {}
         
         /*!
          \brief Copy constructor
+         \param fsm : a finite state machine
+         \post this is a copy of fsm, with its own internal valuations and its own cache of guards verdicts
          */
-        fsm_t(tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL> const &) = default;
+        fsm_t(tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL> const & fsm)
+        : tchecker::flat_system::flat_system_t<MODEL, VLOC>(fsm),
+        _vm(fsm._vm),
+        _unpacked_intvars_val(allocate_unpacked_intvars_val(fsm._model)),
+        _filter_intvars_val(allocate_filter_intvars_val(fsm._model)),
+        _edges_filter([this] (edge_t const * edge) { return integer_guard_enabled(edge); }),
+        _guards_verdicts(fsm._model.system().edges_count())
+        {}
         
         /*!
          \brief Move constructor
+         \param fsm : a finite state machine
+         \post fsm has been moved to this
          */
-        fsm_t(tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL> &&) = default;
+        fsm_t(tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL> && fsm)
+        : tchecker::flat_system::flat_system_t<MODEL, VLOC>(std::move(fsm)),
+        _vm(std::move(fsm._vm)),
+        _unpacked_intvars_val(std::move(fsm._unpacked_intvars_val)),
+        _filter_intvars_val(std::move(fsm._filter_intvars_val)),
+        _edges_filter([this] (edge_t const * edge) { return integer_guard_enabled(edge); }),
+        _guards_verdicts(std::move(fsm._guards_verdicts))
+        {}
         
         /*!
          \brief Destructor
@@ -126,27 +161,13 @@ namespace tchecker {
                                                  initial_iterator_value_t const & initial_range,
                                                  tchecker::clock_constraint_container_t & invariant)
         {
-          if (! _vm.compatible(intvars_val))
-            throw std::invalid_argument("Incompatible variables and valuation");
-          
-          // intialize vloc
-          auto status = tchecker::flat_system::flat_system_t<MODEL, VLOC>::initialize(vloc, initial_range);
-          if (status != tchecker::STATE_OK)
-            return status;
-          
-          // initialize intvars_val
-          auto const & intvars = this->_model.flattened_integer_variables();
-          for (auto const & p : intvars.index()) {
-            tchecker::intvar_id_t id = p.first;
-            intvars_val[id] = intvars.info(id).initial_value();
-          }
-          
-          // check invariant
-          for (typename VLOC::loc_t const * loc : vloc)
-            if (check_location_invariant(loc, intvars_val, invariant) != 1)
-              return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
+          if (! this->_model.packed_integer_variables())
+            return initialize_unpacked(vloc, intvars_val, initial_range, invariant);
           
-          return tchecker::STATE_OK;
+          auto status = initialize_unpacked(vloc, *_unpacked_intvars_val, initial_range, invariant);
+          if (status == tchecker::STATE_OK)
+            this->_model.integer_variables_packing().pack(*_unpacked_intvars_val, intvars_val);
+          return status;
         }
         
         /*!
@@ -165,6 +186,24 @@ namespace tchecker {
           return tchecker::flat_system::flat_system_t<MODEL, VLOC>::outgoing_edges(vloc);
         }
         
+        /*!
+         \brief Accessor
+         \param vloc : tuple of locations
+         \param intvars_val : valuation of bounded integer variables
+         \pre intvars_val size is compatible with the model's bounded integer variables
+         \return range of outgoing synchronized and asynchronous edges from vloc, where edges with a guard that
+         does not involve clocks, and that does not hold on intvars_val, have been filtered out before synchronization
+         \note the returned range is invalidated by the next call to this method
+         \note edges with a guard that cannot be evaluated on intvars_val (e.g. out-of-bounds array access) are
+         kept, hence the failure is reported by next()
+         \throw std::invalid_argument : if the precondition is violated
+         */
+        tchecker::range_t<outgoing_edges_iterator_t> outgoing_edges(VLOC const & vloc, INTVARS_VAL const & intvars_val)
+        {
+          load_filter_intvars_val(intvars_val);
+          return this->_model.synchronizer().outgoing_edges(vloc, _edges_filter);
+        }
+        
         /*!
          \brief Type of iterator over a synchronized outgoing edge
          \note type dereferenced by outgoing_edges_iterator_t, corresponds to tchecker::vedge_iterator_t
@@ -220,6 +259,87 @@ namespace tchecker {
                                            tchecker::clock_constraint_container_t & guard,
                                            tchecker::clock_reset_container_t & clkreset,
                                            tchecker::clock_constraint_container_t & tgt_invariant)
+        {
+          if (! this->_model.packed_integer_variables())
+            return next_unpacked(vloc, intvars_val, vedge, src_invariant, guard, clkreset, tgt_invariant);
+          
+          tchecker::intvars_packing_t const & packing = this->_model.integer_variables_packing();
+          packing.unpack(intvars_val, *_unpacked_intvars_val);
+          auto status = next_unpacked(vloc, *_unpacked_intvars_val, vedge, src_invariant, guard, clkreset, tgt_invariant);
+          if (status == tchecker::STATE_OK)
+            packing.pack(*_unpacked_intvars_val, intvars_val);
+          return status;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Underlying model
+         */
+        inline constexpr model_t const & model() const
+        {
+          return tchecker::flat_system::flat_system_t<MODEL, VLOC>::model();
+        }
+      protected:
+        /*!
+         \brief Initialize state with unpacked valuation
+         \param vloc : tuple of locations
+         \param intvars_val : valuation of bounded integer variables (unpacked)
+         \param initial_range : range of initial locations
+         \param invariant : container for invariant clock constraints
+         \pre see initialize()
+         \post see initialize()
+         \return see initialize()
+         \throw see initialize()
+         */
+        enum tchecker::state_status_t initialize_unpacked(VLOC & vloc,
+                                                          tchecker::intvars_valuation_t & intvars_val,
+                                                          initial_iterator_value_t const & initial_range,
+                                                          tchecker::clock_constraint_container_t & invariant)
+        {
+          if (! _vm.compatible(intvars_val))
+            throw std::invalid_argument("Incompatible variables and valuation");
+          
+          // intialize vloc
+          auto status = tchecker::flat_system::flat_system_t<MODEL, VLOC>::initialize(vloc, initial_range);
+          if (status != tchecker::STATE_OK)
+            return status;
+          
+          // initialize intvars_val
+          auto const & intvars = this->_model.flattened_integer_variables();
+          for (auto const & p : intvars.index()) {
+            tchecker::intvar_id_t id = p.first;
+            intvars_val[id] = intvars.info(id).initial_value();
+          }
+          
+          // check invariant
+          for (typename VLOC::loc_t const * loc : vloc)
+            if (check_location_invariant(loc, intvars_val, invariant) != 1)
+              return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
+          
+          return tchecker::STATE_OK;
+        }
+        
+        /*!
+         \brief Compute next state with unpacked valuation
+         \param vloc : tuple of locations
+         \param intvars_val : integer variables valuation (unpacked)
+         \param vedge : range of edges in a vedge
+         \param src_invariant : container for clock constraints in the invariant of vloc before it is updated
+         \param guard : container for clock constraints in vedge guard
+         \param clkreset : container for clock resets in vedge statement
+         \param tgt_invariant : container for clock constraints in the invariant of vloc after it is updated
+         \pre see next()
+         \post see next()
+         \return see next()
+         \throw see next()
+         */
+        enum tchecker::state_status_t next_unpacked(VLOC & vloc,
+                                                    tchecker::intvars_valuation_t & intvars_val,
+                                                    outgoing_edges_iterator_value_t const & vedge,
+                                                    tchecker::clock_constraint_container_t & src_invariant,
+                                                    tchecker::clock_constraint_container_t & guard,
+                                                    tchecker::clock_reset_container_t & clkreset,
+                                                    tchecker::clock_constraint_container_t & tgt_invariant)
         {
           if (! _vm.compatible(intvars_val))
             throw std::invalid_argument("Incompatible variables and valuation");
@@ -254,14 +374,171 @@ namespace tchecker {
         }
         
         /*!
-         \brief Accessor
-         \return Underlying model
+         \brief Type of edges
          */
-        inline constexpr model_t const & model() const
+        using edge_t = typename MODEL::system_t::edge_t;
+        
+        /*!
+         \brief Maximal number of verdicts cached for an edge
+         */
+        static constexpr std::size_t GUARD_VERDICTS_MAX = 4096;
+        
+        /*!
+         \brief Set the valuation used by the pre-filter on integer guards
+         \param intvars_val : valuation of bounded integer variables
+         \pre intvars_val size is compatible with the model's bounded integer variables
+         \post _edges_filter filters edges w.r.t. intvars_val
+         \throw std::invalid_argument : if the precondition is violated
+         */
+        void load_filter_intvars_val(INTVARS_VAL const & intvars_val)
         {
-          return tchecker::flat_system::flat_system_t<MODEL, VLOC>::model();
+          if (this->_model.packed_integer_variables())
+            this->_model.integer_variables_packing().unpack(intvars_val, *_filter_intvars_val);
+          else {
+            std::size_t const size = _filter_intvars_val->size();
+            if (intvars_val.size() < size)
+              throw std::invalid_argument("Incompatible variables and valuation");
+            std::copy(intvars_val.ptr(), intvars_val.ptr() + size, _filter_intvars_val->ptr());
+          }
         }
-      protected:
+        
+        /*!
+         \brief Cached verdicts for an edge guard
+         \note verdicts are indexed by the values of the integer variables read by the guard, in mixed radix
+         w.r.t. their domains. The table of verdicts is allocated at first use. There is no cache if the guard
+         involves clocks, or if the variables read by the guard have too many valuations
+         */
+        struct guard_verdicts_t {
+          /*!
+           \brief Verdict
+           */
+          enum verdict_t : std::uint8_t {
+            UNKNOWN = 0,
+            DISABLED,
+            ENABLED,
+          };
+          
+          bool _initialized = false;                  /*!< Strides and size computed */
+          std::size_t _size = 0;                      /*!< Number of verdicts (0: no cache) */
+          std::vector<std::size_t> _strides;          /*!< Strides of integer variables read by the guard */
+          std::vector<std::uint8_t> _verdicts;        /*!< Cached verdicts */
+        };
+        
+        /*!
+         \brief Pre-filter edges on integer guards
+         \param edge : an edge
+         \pre outgoing_edges(vloc, intvars_val) has been called, and _filter_intvars_val is intvars_val unpacked
+         \return false if the guard of edge does not involve clocks and does not hold on _filter_intvars_val,
+         true otherwise
+         */
+        bool integer_guard_enabled(edge_t const * edge)
+        {
+          tchecker::edge_id_t const edge_id = edge->id();
+          if (! this->_model.integer_guard(edge_id))
+            return true;
+          
+          guard_verdicts_t & verdicts = _guards_verdicts[edge_id];
+          if (! verdicts._initialized)
+            initialize_guard_verdicts(edge_id, verdicts);
+          if (verdicts._size == 0)
+            return evaluate_integer_guard(edge);
+          
+          // index of the valuation of the variables read by the guard
+          std::vector<tchecker::intvar_id_t> const & intvars = this->_model.guard_integer_variables(edge_id);
+          auto const & flat_intvars = this->_model.flattened_integer_variables();
+          std::size_t index = 0;
+          for (std::size_t i = 0; i < intvars.size(); ++i) {
+            tchecker::integer_t const value = (*_filter_intvars_val)[intvars[i]];
+            tchecker::intvar_info_t const & info = flat_intvars.info(intvars[i]);
+            if ((value < info.min()) || (value > info.max()))
+              return evaluate_integer_guard(edge);
+            index += static_cast<std::size_t>(value - info.min()) * verdicts._strides[i];
+          }
+          assert(index < verdicts._size);
+          
+          std::uint8_t & verdict = verdicts._verdicts[index];
+          if (verdict == guard_verdicts_t::UNKNOWN)
+            verdict = (evaluate_integer_guard(edge) ? guard_verdicts_t::ENABLED : guard_verdicts_t::DISABLED);
+          return (verdict == guard_verdicts_t::ENABLED);
+        }
+        
+        /*!
+         \brief Initialize cached verdicts of an edge guard
+         \param edge_id : edge ID
+         \param verdicts : cached verdicts
+         \post verdicts has been initialized for the guard of edge_id, with no cache if the integer variables
+         read by the guard have more than GUARD_VERDICTS_MAX valuations
+         */
+        void initialize_guard_verdicts(tchecker::edge_id_t edge_id, guard_verdicts_t & verdicts) const
+        {
+          verdicts._initialized = true;
+          std::vector<tchecker::intvar_id_t> const & intvars = this->_model.guard_integer_variables(edge_id);
+          auto const & flat_intvars = this->_model.flattened_integer_variables();
+          
+          std::size_t size = 1;
+          verdicts._strides.resize(intvars.size());
+          for (std::size_t i = 0; i < intvars.size(); ++i) {
+            tchecker::intvar_info_t const & info = flat_intvars.info(intvars[i]);
+            std::size_t const domain_size = static_cast<std::size_t>(static_cast<std::int64_t>(info.max())
+                                                                     - static_cast<std::int64_t>(info.min()) + 1);
+            verdicts._strides[i] = size;
+            if (domain_size > GUARD_VERDICTS_MAX / size)
+              return;  // no cache
+            size *= domain_size;
+          }
+          
+          verdicts._size = size;
+          verdicts._verdicts.assign(size, guard_verdicts_t::UNKNOWN);
+        }
+        
+        /*!
+         \brief Evaluate integer guard
+         \param edge : an edge
+         \pre the guard of edge does not involve clocks
+         \return true if the guard of edge holds on _filter_intvars_val, or if it cannot be evaluated, false otherwise
+         */
+        bool evaluate_integer_guard(edge_t const * edge)
+        {
+          try {
+            _filter_clkconstr.clear();
+            return (check_edge_guard(edge, *_filter_intvars_val, _filter_clkconstr) == 1);
+          }
+          catch (...) {
+            return true;  // failure is reported by next()
+          }
+        }
+        
+        /*!
+         \brief Allocate internal valuation for pre-filtering edges
+         \param model : a model
+         \return a valuation of the flattened integer variables in model
+         */
+        static std::unique_ptr<tchecker::intvars_valuation_t, void(*)(tchecker::intvars_valuation_t *)>
+        allocate_filter_intvars_val(MODEL const & model)
+        {
+          std::size_t const size = model.flattened_integer_variables().flattened_size();
+          return std::unique_ptr<tchecker::intvars_valuation_t, void(*)(tchecker::intvars_valuation_t *)>
+          (tchecker::intvars_valuation_allocate_and_construct(size, size), tchecker::intvars_valuation_destruct_and_deallocate);
+        }
+        
+        /*!
+         \brief Allocate internal valuation
+         \param model : a model
+         \return a valuation of the flattened integer variables in model if model has packed integer variables,
+         nullptr otherwise
+         */
+        static std::unique_ptr<tchecker::intvars_valuation_t, void(*)(tchecker::intvars_valuation_t *)>
+        allocate_unpacked_intvars_val(MODEL const & model)
+        {
+          tchecker::intvars_valuation_t * v = nullptr;
+          if (model.packed_integer_variables()) {
+            std::size_t const size = model.flattened_integer_variables().flattened_size();
+            v = tchecker::intvars_valuation_allocate_and_construct(size, size);
+          }
+          return std::unique_ptr<tchecker::intvars_valuation_t, void(*)(tchecker::intvars_valuation_t *)>
+          (v, tchecker::intvars_valuation_destruct_and_deallocate);
+        }
+        
         /*!
          \brief Check location invariant
          \param loc : a location
@@ -274,10 +551,13 @@ namespace tchecker {
          throws
          */
         inline tchecker::integer_t check_location_invariant(typename VLOC::loc_t const * loc,
-                                                            INTVARS_VAL & intvars_val,
+                                                            tchecker::intvars_valuation_t & intvars_val,
                                                             tchecker::clock_constraint_container_t & invariant)
         {
           try {
+            tchecker::native_code_t::function_t const f = this->_model.invariant_native(loc->id());
+            if (f != nullptr)
+              return tchecker::native_code_t::run(f, intvars_val, invariant, _throw_clkreset);
             return _vm.run(this->_model.invariant_bytecode(loc->id()), intvars_val, invariant, _throw_clkreset);
           }
           catch (std::exception const & e) {
@@ -300,10 +580,13 @@ namespace tchecker {
          throws
          */
         inline tchecker::integer_t check_edge_guard(typename MODEL::system_t::edge_t const * edge,
-                                                    INTVARS_VAL & intvars_val,
+                                                    tchecker::intvars_valuation_t & intvars_val,
                                                     tchecker::clock_constraint_container_t & guard)
         {
           try {
+            tchecker::native_code_t::function_t const f = this->_model.guard_native(edge->id());
+            if (f != nullptr)
+              return tchecker::native_code_t::run(f, intvars_val, guard, _throw_clkreset);
             return _vm.run(this->_model.guard_bytecode(edge->id()), intvars_val, guard, _throw_clkreset);
           }
           catch (std::exception const & e) {
@@ -326,10 +609,13 @@ namespace tchecker {
          throws
          */
         inline tchecker::integer_t apply_edge_statement(typename MODEL::system_t::edge_t const * edge,
-                                                        INTVARS_VAL & intvars_val,
+                                                        tchecker::intvars_valuation_t & intvars_val,
                                                         tchecker::clock_reset_container_t & clkreset)
         {
           try {
+            tchecker::native_code_t::function_t const f = this->_model.statement_native(edge->id());
+            if (f != nullptr)
+              return tchecker::native_code_t::run(f, intvars_val, _throw_clkconstr, clkreset);
             return _vm.run(this->_model.statement_bytecode(edge->id()), intvars_val, _throw_clkconstr, clkreset);
           }
           catch (std::exception const & e) {
@@ -358,6 +644,13 @@ namespace tchecker {
         tchecker::vm_t _vm;                                                           /*!< Bytecode interpreter */
         throw_container_t<tchecker::clock_constraint_container_t> _throw_clkconstr;  /*!< Throw clock constraint container */
         throw_container_t<tchecker::clock_reset_container_t> _throw_clkreset;        /*!< Throw clock reset container */
+        std::unique_ptr<tchecker::intvars_valuation_t, void(*)(tchecker::intvars_valuation_t *)>
+        _unpacked_intvars_val;                                                        /*!< Unpacked valuation (packed models) */
+        std::unique_ptr<tchecker::intvars_valuation_t, void(*)(tchecker::intvars_valuation_t *)>
+        _filter_intvars_val;                                                          /*!< Valuation for pre-filtering edges */
+        tchecker::clock_constraint_container_t _filter_clkconstr;                     /*!< Clock constraints (pre-filtering) */
+        tchecker::details::edges_filter_t<edge_t> _edges_filter;                      /*!< Pre-filter on integer guards */
+        std::vector<guard_verdicts_t> _guards_verdicts;                               /*!< Cached guards verdicts (by edge ID) */
       };
       
     } // end of namespace details
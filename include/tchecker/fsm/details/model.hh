@@ -8,8 +8,13 @@
 #ifndef TCHECKER_FSM_DETAILS_MODEL_HH
 #define TCHECKER_FSM_DETAILS_MODEL_HH
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
+#include "tchecker/expression/static_analysis.hh"
 #include "tchecker/expression/typechecking.hh"
 #include "tchecker/expression/typed_expression.hh"
 #include "tchecker/flat_system/model.hh"
@@ -18,7 +23,9 @@
 #include "tchecker/statement/typed_statement.hh"
 #include "tchecker/utils/iterator.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/variables/intvars.hh"
 #include "tchecker/vm/compilers.hh"
+#include "tchecker/vm/native.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -49,7 +56,14 @@ namespace tchecker {
          \post this is a copy of model
          */
         model_t(tchecker::fsm::details::model_t<SYSTEM, VARIABLES> const & model)
-        : tchecker::flat_system::model_t<SYSTEM>(model), VARIABLES(*this)
+        : tchecker::flat_system::model_t<SYSTEM>(model), VARIABLES(*this),
+        _intvars_packing(model._intvars_packing),
+        _packed_intvars(model._packed_intvars),
+        _vm_stack_size(0),
+        _native_code(model._native_code),
+        _invariants_native(model._invariants_native),
+        _guards_native(model._guards_native),
+        _statements_native(model._statements_native)
         {
           tchecker::log_t log;  // log with no output (log needed by compile, but no output expected)
           compile(*this->_system, log);
@@ -81,6 +95,12 @@ namespace tchecker {
             free_memory();
             
             tchecker::flat_system::model_t<SYSTEM>::operator=(model);
+            _intvars_packing = model._intvars_packing;
+            _packed_intvars = model._packed_intvars;
+            _native_code = model._native_code;
+            _invariants_native = model._invariants_native;
+            _guards_native = model._guards_native;
+            _statements_native = model._statements_native;
             
             tchecker::log_t log;  // log with no output (log needed by compile, but no output expected)
             compile(*this->_system, log);
@@ -160,6 +180,33 @@ namespace tchecker {
           return _guards_bytecode[edge_id];
         }
         
+        /*!
+         \brief Accessor
+         \param edge_id : edge ID
+         \pre edge_id is less than the number of edges in the model (checked
+         by assertion)
+         \return true if the guard of edge edge_id does not involve clocks, false otherwise
+         */
+        inline bool integer_guard(tchecker::edge_id_t edge_id) const
+        {
+          assert(edge_id < _integer_guards.size());
+          return _integer_guards[edge_id];
+        }
+        
+        /*!
+         \brief Accessor
+         \param edge_id : edge ID
+         \pre edge_id is less than the number of edges in the model (checked
+         by assertion)
+         \return IDs of the flattened integer variables that may be read by the guard of edge
+         edge_id, in increasing order
+         */
+        inline std::vector<tchecker::intvar_id_t> const & guard_integer_variables(tchecker::edge_id_t edge_id) const
+        {
+          assert(edge_id < _guards_intvars.size());
+          return _guards_intvars[edge_id];
+        }
+        
         /*!
          \brief Accessor
          \param edge_id : edge ID
@@ -173,6 +220,86 @@ namespace tchecker {
           return _statements_bytecode[edge_id];
         }
         
+        /*!
+         \brief Compile bytecode to native code
+         \param cache_dir : directory of cached native code
+         \post invariants, guards and statements bytecode has been compiled to native code
+         (see tchecker::native_code_t), which is used instead of bytecode from now on
+         \throw std::runtime_error : if native code cannot be generated or loaded
+         \note copies of this model share its native code
+         */
+        void compile_native_code(std::string const & cache_dir)
+        {
+          std::vector<tchecker::bytecode_t const *> bytecodes;
+          bytecodes.insert(bytecodes.end(), _invariants_bytecode.begin(), _invariants_bytecode.end());
+          bytecodes.insert(bytecodes.end(), _guards_bytecode.begin(), _guards_bytecode.end());
+          bytecodes.insert(bytecodes.end(), _statements_bytecode.begin(), _statements_bytecode.end());
+          
+          _native_code = std::make_shared<tchecker::native_code_t const>(bytecodes, cache_dir);
+          
+          std::size_t i = 0;
+          _invariants_native.resize(_invariants_bytecode.size());
+          for (tchecker::native_code_t::function_t & f : _invariants_native)
+            f = _native_code->function(i++);
+          _guards_native.resize(_guards_bytecode.size());
+          for (tchecker::native_code_t::function_t & f : _guards_native)
+            f = _native_code->function(i++);
+          _statements_native.resize(_statements_bytecode.size());
+          for (tchecker::native_code_t::function_t & f : _statements_native)
+            f = _native_code->function(i++);
+        }
+        
+        /*!
+         \brief Accessor
+         \return true if bytecode has been compiled to native code, false otherwise
+         */
+        inline bool native_code() const
+        {
+          return (_native_code.get() != nullptr);
+        }
+        
+        /*!
+         \brief Accessor
+         \param loc_id : location ID
+         \pre loc_id is less than the number of locations in the model (checked
+         by assertion)
+         \return native code for the invariant of location loc_id, nullptr if bytecode
+         has not been compiled to native code
+         */
+        inline tchecker::native_code_t::function_t invariant_native(tchecker::loc_id_t loc_id) const
+        {
+          assert(loc_id < _invariants_bytecode.size());
+          return (_invariants_native.empty() ? nullptr : _invariants_native[loc_id]);
+        }
+        
+        /*!
+         \brief Accessor
+         \param edge_id : edge ID
+         \pre edge_id is less than the number of edges in the model (checked
+         by assertion)
+         \return native code for the guard of edge edge_id, nullptr if bytecode
+         has not been compiled to native code
+         */
+        inline tchecker::native_code_t::function_t guard_native(tchecker::edge_id_t edge_id) const
+        {
+          assert(edge_id < _guards_bytecode.size());
+          return (_guards_native.empty() ? nullptr : _guards_native[edge_id]);
+        }
+        
+        /*!
+         \brief Accessor
+         \param edge_id : edge ID
+         \pre edge_id is less than the number of edges in the model (checked
+         by assertion)
+         \return native code for the statement of edge edge_id, nullptr if bytecode
+         has not been compiled to native code
+         */
+        inline tchecker::native_code_t::function_t statement_native(tchecker::edge_id_t edge_id) const
+        {
+          assert(edge_id < _statements_bytecode.size());
+          return (_statements_native.empty() ? nullptr : _statements_native[edge_id]);
+        }
+        
         /*!
          \brief Accessor
          \return System bounded integer variables
@@ -191,6 +318,54 @@ namespace tchecker {
           return VARIABLES::flattened_integer_variables(*this->_system);
         }
         
+        /*!
+         \brief Select representation of integer variables valuations in states
+         \param packed : packed representation if true, one integer per flat variable otherwise
+         \post valuations of integer variables are stored using the layout of integer_variables_packing() if packed
+         is true, and unpacked otherwise
+         \note shall be called before any state of this model is allocated
+         */
+        inline void pack_integer_variables(bool packed)
+        {
+          _packed_intvars = packed;
+        }
+        
+        /*!
+         \brief Accessor
+         \return true if valuations of integer variables in states are packed, false otherwise
+         */
+        inline constexpr bool packed_integer_variables() const
+        {
+          return _packed_intvars;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Packed layout of valuations of flattened bounded integer variables
+         */
+        inline constexpr tchecker::intvars_packing_t const & integer_variables_packing() const
+        {
+          return _intvars_packing;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Size of valuations of integer variables in states (packed or not)
+         */
+        inline std::size_t intvars_valuation_size() const
+        {
+          return (_packed_intvars ? _intvars_packing.packed_size() : flattened_integer_variables().flattened_size());
+        }
+        
+        /*!
+         \brief Accessor
+         \return Size of the VM stack needed to interpret the bytecode of this model
+         */
+        inline constexpr std::size_t vm_stack_size() const
+        {
+          return _vm_stack_size;
+        }
+        
         /*!
          \brief Accessor
          \return System clock variables
@@ -221,7 +396,10 @@ namespace tchecker {
         template <class ... ARGS>
         explicit model_t(SYSTEM * system, tchecker::log_t & log, ARGS && ... args)
         : tchecker::flat_system::model_t<SYSTEM>(system),
-        VARIABLES(args...)
+        VARIABLES(args...),
+        _intvars_packing(VARIABLES::flattened_integer_variables(*system)),
+        _packed_intvars(false),
+        _vm_stack_size(0)
         {
           if (tchecker::fsm::details::has_guarded_weakly_synchronized_event(*system))
             throw std::runtime_error("Weakly synchronized event shall not be guarded");
@@ -236,11 +414,12 @@ namespace tchecker {
          \brief Compile system bytecode
          \param system : a system
          \param log : logging facility
-         \post system's bytcode has been generated. All warnings and errors have
+         \post system's bytcode has been generated and checked. All warnings and errors have
          been reported to log
          */
         void compile(SYSTEM const & system, tchecker::log_t & log)
         {
+          _vm_stack_size = 0;
           compile_invariants(system, log);
           compile_guards(system, log);
           compile_statements(system, log);
@@ -270,6 +449,7 @@ namespace tchecker {
                                                      "Attribute invariant: " + loc->invariant().to_string());
             try {
               _invariants_bytecode[loc->id()] = tchecker::compile(*_typed_invariants[loc->id()]);
+              check_bytecode(_invariants_bytecode[loc->id()]);
             }
             catch (std::exception const & e)
             {
@@ -284,6 +464,8 @@ namespace tchecker {
          \param log : logging facility
          \post system's typed guards and guards bytecode has been
          generated in _typed_guards and _guards_bytecode respectively.
+         Guards that do not involve clocks have been flagged in _integer_guards,
+         and the integer variables read by guards have been stored in _guards_intvars.
          All warnings and errors have been reported to log
          */
         void compile_guards(SYSTEM const & system, tchecker::log_t & log)
@@ -295,12 +477,22 @@ namespace tchecker {
           
           _guards_bytecode.resize(system.edges_count());
           _typed_guards.resize(system.edges_count());
+          _integer_guards.assign(system.edges_count(), false);
+          _guards_intvars.assign(system.edges_count(), std::vector<tchecker::intvar_id_t>());
           
           tchecker::range_t<typename SYSTEM::const_edge_iterator_t> edges = system.edges();
           for (typename SYSTEM::edge_t const * edge : edges) {
             _typed_guards[edge->id()] = typecheck(edge->guard(), log, "Attribute provided: " + edge->guard().to_string());
             try {
               _guards_bytecode[edge->id()] = tchecker::compile(*_typed_guards[edge->id()]);
+              check_bytecode(_guards_bytecode[edge->id()]);
+              
+              std::unordered_set<tchecker::clock_id_t> clocks;
+              std::unordered_set<tchecker::intvar_id_t> intvars;
+              tchecker::extract_variables(*_typed_guards[edge->id()], clocks, intvars);
+              _integer_guards[edge->id()] = clocks.empty();
+              _guards_intvars[edge->id()].assign(intvars.begin(), intvars.end());
+              std::sort(_guards_intvars[edge->id()].begin(), _guards_intvars[edge->id()].end());
             }
             catch (std::exception const & e)
             {
@@ -332,6 +524,7 @@ namespace tchecker {
             _typed_statements[edge->id()] = typecheck(edge->statement(), log, "Attribute do: " + edge->statement().to_string());
             try {
               _statements_bytecode[edge->id()] = tchecker::compile(*_typed_statements[edge->id()]);
+              check_bytecode(_statements_bytecode[edge->id()]);
             }
             catch (std::exception const & e)
             {
@@ -340,6 +533,21 @@ namespace tchecker {
           }
         }
         
+        /*!
+         \brief Check bytecode
+         \param bytecode : bytecode
+         \post bytecode has been checked w.r.t. the flattened variables of this model (see tchecker::check_bytecode),
+         and the size of the VM stack has been updated
+         \throw std::invalid_argument : if bytecode does not pass tchecker::check_bytecode
+         */
+        void check_bytecode(tchecker::bytecode_t const * bytecode)
+        {
+          std::size_t const stack_size = tchecker::check_bytecode(bytecode,
+                                                                  flattened_integer_variables().size(),
+                                                                  flattened_clock_variables().size());
+          _vm_stack_size = std::max(_vm_stack_size, stack_size);
+        }
+        
         /*!
          \brief Typecheck an expression
          \param expr : expression
@@ -394,6 +602,8 @@ namespace tchecker {
           for (tchecker::bytecode_t * b : _guards_bytecode)
             delete[] b;
           _guards_bytecode.clear();
+          _integer_guards.clear();
+          _guards_intvars.clear();
           for (tchecker::bytecode_t * b : _statements_bytecode)
             delete[] b;
           _statements_bytecode.clear();
@@ -405,6 +615,15 @@ namespace tchecker {
         std::vector<tchecker::bytecode_t *> _invariants_bytecode;       /*!< Bytecode for locations invariants */
         std::vector<tchecker::bytecode_t *> _guards_bytecode;           /*!< Bytecode for edges guards */
         std::vector<tchecker::bytecode_t *> _statements_bytecode;       /*!< Bytecode for edges statements */
+        std::vector<bool> _integer_guards;                              /*!< Edges guards that do not involve clocks */
+        std::vector<std::vector<tchecker::intvar_id_t>> _guards_intvars;  /*!< Integer variables read by edges guards */
+        tchecker::intvars_packing_t _intvars_packing;                   /*!< Packed layout of integer variables */
+        bool _packed_intvars;                                           /*!< Packed integer variables in states */
+        std::size_t _vm_stack_size;                                     /*!< Size of VM stack for bytecode */
+        std::shared_ptr<tchecker::native_code_t const> _native_code;    /*!< Native code (if any) */
+        std::vector<tchecker::native_code_t::function_t> _invariants_native;  /*!< Native code for invariants */
+        std::vector<tchecker::native_code_t::function_t> _guards_native;      /*!< Native code for guards */
+        std::vector<tchecker::native_code_t::function_t> _statements_native;  /*!< Native code for statements */
       };
       
     } // end of namespace details
@@ -108,7 +108,7 @@ namespace tchecker {
          */
         virtual tchecker::range_t<typename FSM::outgoing_edges_iterator_t> outgoing_edges(STATE const & s)
         {
-          return _fsm.outgoing_edges(s.vloc());
+          return _fsm.outgoing_edges(s.vloc(), s.intvars_valuation());
         }
         
         /*!
@@ -196,12 +196,14 @@ namespace tchecker {
        \brief Constructor
        \param model : a model
        \param alloc_nb : number of objects in an allocation block
+       \param share_components : sharing flag for tuples of locations and integer variables valuations
        */
-      state_pool_allocator_t(tchecker::fsm::model_t & model, std::size_t alloc_nb)
+      state_pool_allocator_t(tchecker::fsm::model_t & model, std::size_t alloc_nb, bool share_components = false)
       : tchecker::fsm::details::state_pool_allocator_t<STATE>
       (alloc_nb,
        alloc_nb, model.system().processes_count(),
-       alloc_nb, model.flattened_integer_variables().flattened_size())
+       alloc_nb, model.intvars_valuation_size(),
+       share_components)
       {}
     };
     
@@ -217,6 +217,27 @@ namespace tchecker {
         return std::apply(&tchecker::graph::graph_allocator_t<NODE_ALLOCATOR, EDGE_ALLOCATOR>::_allocate_edge<EARGS...>,
                           std::tuple_cat(std::make_tuple(this), eargs));
       }
+      
+      /*!
+       \brief Share components of a node
+       \param node : a node
+       \pre node has been allocated by this allocator, and is not nullptr. The node pointed by node will not be
+       modified anymore
+       \post the components of the node pointed by node are shared with other nodes (see NODE_ALLOCATOR::share())
+       */
+      inline void share_node(node_ptr_t & node)
+      {
+        _node_allocator.share(*node);
+      }
+      
+      /*!
+       \brief Accessor
+       \return Node allocator
+       */
+      inline NODE_ALLOCATOR const & node_allocator() const
+      {
+        return _node_allocator;
+      }
     protected:
       /*!
        \brief Node allocation
@@ -0,0 +1,337 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_CONCURRENT_COVER_GRAPH_HH
+#define TCHECKER_CONCURRENT_COVER_GRAPH_HH
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/graph/cover_graph.hh"
+#include "tchecker/utils/spinlock.hh"
+
+/*!
+ \file concurrent_cover_graph.hh
+ \brief Graph with node covering that can be shared by several threads
+ */
+
+namespace tchecker {
+  
+  namespace graph {
+    
+    namespace cover {
+      
+      /*!
+       \class concurrent_graph_t
+       \brief Graph with node covering, safe for concurrent use
+       \tparam NODE_PTR : type of pointers to node, *NODE_PTR should inherit from tchecker::graph::cover::node_t
+       \tparam KEY : type of keys
+       \tparam NODE_TO_KEY : type of node-to-key map (see tchecker::graph::cover::graph_t)
+       \tparam NODE_TO_SIGNATURE : type of node-to-signature map (see tchecker::graph::cover::graph_t)
+       \note this graph stores nodes in a table of buckets, as tchecker::graph::cover::graph_t. Each bucket is
+       protected by its own lock, hence threads that work on nodes with different keys do not contend.
+       Covering checks and insertion of a node are performed as one atomic operation on the bucket of the node
+       (see add_node_if_not_covered())
+       \note the less-or-equal relation on nodes is passed to each covering query instead of being stored in the
+       graph, as covering predicates may use internal buffers, and thus should not be shared by several threads
+       */
+      template <class NODE_PTR,
+      class KEY=std::size_t,
+      class NODE_TO_KEY=tchecker::graph::cover::node_to_key_t<KEY, NODE_PTR>,
+      class NODE_TO_SIGNATURE=tchecker::graph::cover::node_to_signature_t<NODE_PTR>
+      >
+      class concurrent_graph_t {
+        static_assert(std::is_unsigned<KEY>::value, "");
+      private:
+        /*!
+         \brief Type of nodes container
+         */
+        using nodes_container_t = tchecker::graph::cover::details::nodes_container_t<NODE_PTR, KEY>;
+        
+        /*!
+         \brief Type of buckets: container of nodes with a lock
+         */
+        struct bucket_t {
+          tchecker::spinlock_t _lock;     /*!< Lock on bucket */
+          nodes_container_t _nodes;       /*!< Nodes in bucket */
+        };
+      public:
+        /*!
+         \brief Type of pointers to node
+         */
+        using node_ptr_t = NODE_PTR;
+        
+        /*!
+         \brief Type of key
+         */
+        using key_t = KEY;
+        
+        /*!
+         \brief Constructor
+         \param table_size : size of the table of buckets
+         \param node_to_key : a map from NODE_PTR to KEY
+         \param node_to_signature : a map from NODE_PTR to signatures (see tchecker::graph::cover::graph_t)
+         \throw std::invalid_argument : if table_size is 0 or too big w.r.t. type
+         tchecker::graph::cover::node_position_t
+         \note node_to_key and node_to_signature must be safe to call concurrently
+         */
+        concurrent_graph_t(std::size_t table_size,
+                           NODE_TO_KEY node_to_key,
+                           NODE_TO_SIGNATURE node_to_signature = tchecker::graph::cover::empty_signature<NODE_PTR>)
+        : _node_to_key(std::move(node_to_key)),
+        _node_to_signature(std::move(node_to_signature)),
+        _table_size(table_size),
+        _buckets(new bucket_t[table_size]),
+        _cover_checks(0),
+        _avoided_cover_checks(0)
+        {
+          if (table_size == 0)
+            throw std::invalid_argument("table size should be positive");
+          if (table_size > std::numeric_limits<tchecker::graph::cover::node_position_t>::max())
+            throw std::invalid_argument("table size exceeds node positions");
+        }
+        
+        /*!
+         \brief Copy constructor (deleted)
+         */
+        concurrent_graph_t(tchecker::graph::cover::concurrent_graph_t<NODE_PTR, KEY, NODE_TO_KEY, NODE_TO_SIGNATURE> const &) = delete;
+        
+        /*!
+         \brief Move constructor (deleted)
+         */
+        concurrent_graph_t(tchecker::graph::cover::concurrent_graph_t<NODE_PTR, KEY, NODE_TO_KEY, NODE_TO_SIGNATURE> &&) = delete;
+        
+        /*!
+         \brief Destructor
+         */
+        ~concurrent_graph_t()
+        {
+          clear();
+        }
+        
+        /*!
+         \brief Assignment operator (deleted)
+         */
+        tchecker::graph::cover::concurrent_graph_t<NODE_PTR, KEY, NODE_TO_KEY, NODE_TO_SIGNATURE> &
+        operator= (tchecker::graph::cover::concurrent_graph_t<NODE_PTR, KEY, NODE_TO_KEY, NODE_TO_SIGNATURE> const &) = delete;
+        
+        /*!
+         \brief Move-assignment operator (deleted)
+         */
+        tchecker::graph::cover::concurrent_graph_t<NODE_PTR, KEY, NODE_TO_KEY, NODE_TO_SIGNATURE> &
+        operator= (tchecker::graph::cover::concurrent_graph_t<NODE_PTR, KEY, NODE_TO_KEY, NODE_TO_SIGNATURE> &&) = delete;
+        
+        /*!
+         \brief Clear
+         \post The graph is empty
+         \note No destructor call on nodes
+         \note not thread-safe
+         */
+        void clear()
+        {
+          for (std::size_t i = 0; i < _table_size; ++i)
+            _buckets[i]._nodes.clear();
+        }
+        
+        /*!
+         \brief Add node
+         \param n : a node
+         \pre n is not stored in a graph
+         \post n has been added to the graph
+         \throw std::invalid_argument : if n is already stored in a graph
+         \note thread-safe
+         */
+        void add_node(NODE_PTR const & n)
+        {
+          if (n->is_stored())
+            throw std::invalid_argument("adding a stored node is not allowed");
+          KEY const key = _node_to_key(n);
+          tchecker::graph::cover::signature_t const signature = _node_to_signature(n);
+          bucket_t & bucket = node_bucket(n, key);
+          std::lock_guard<tchecker::spinlock_t> lock(bucket._lock);
+          bucket._nodes.add(n, key, signature);
+        }
+        
+        /*!
+         \brief Add node unless it is covered
+         \param n : a node
+         \param le_node : less-or-equal predicate on nodes
+         \param covering_node : a node
+         \param covered_nodes : a vector of nodes
+         \pre n is not stored in a graph
+         \post if n is less-or-equal to some node with same key in the graph (w.r.t. le_node), then covering_node
+         points to that node, and n has not been added to the graph. Otherwise, all nodes in the graph with same key
+         as n that are less-or-equal to n have been removed from the graph and appended to covered_nodes, and n has
+         been added to the graph.
+         \return true if n has been added to the graph, false otherwise
+         \throw std::invalid_argument : if n is already stored in a graph
+         \note thread-safe: the covering checks, the removal of covered nodes and the insertion of n are performed
+         atomically w.r.t. the other operations on the graph
+         */
+        template <class LE_NODE>
+        bool add_node_if_not_covered(NODE_PTR const & n, LE_NODE & le_node, NODE_PTR & covering_node,
+                                     std::vector<NODE_PTR> & covered_nodes)
+        {
+          if (n->is_stored())
+            throw std::invalid_argument("adding a stored node is not allowed");
+            
+          KEY const key = _node_to_key(n);
+          tchecker::graph::cover::signature_t const signature = _node_to_signature(n);
+          unsigned long checks = 0, avoided_checks = 0;
+          bucket_t & bucket = node_bucket(n, key);
+          std::lock_guard<tchecker::spinlock_t> lock(bucket._lock);
+          nodes_container_t & nodes = bucket._nodes;
+          
+          auto candidate = [&] (std::size_t i, tchecker::graph::cover::signature_t sig1,
+                                tchecker::graph::cover::signature_t sig2) {
+            if ((nodes.key(i) == key) && tchecker::graph::cover::signature_le(sig1, sig2)) {
+              ++checks;
+              return true;
+            }
+            ++avoided_checks;
+            return false;
+          };
+          
+          for (std::size_t i = 0; i < nodes.size(); ++i)
+            if (candidate(i, signature, nodes.signature(i)) && le_node(n, nodes.node(i))) {
+              n->clear_position();
+              covering_node = nodes.node(i);
+              count_checks(checks, avoided_checks);
+              return false;
+            }
+            
+          covering_node = nullptr;
+          
+          std::size_t const first_covered = covered_nodes.size();
+          for (std::size_t i = 0; i < nodes.size(); ++i)
+            if (candidate(i, nodes.signature(i), signature) && le_node(nodes.node(i), n))
+              covered_nodes.push_back(nodes.node(i));
+          for (std::size_t i = first_covered; i < covered_nodes.size(); ++i)
+            nodes.remove(covered_nodes[i]);
+            
+          nodes.add(n, key, signature);
+          count_checks(checks, avoided_checks);
+          return true;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of nodes in this graph
+         \note linear-time complexity in the size of table of nodes
+         \note not thread-safe
+         */
+        std::size_t nodes_count() const
+        {
+          std::size_t count = 0;
+          for (std::size_t i = 0; i < _table_size; ++i)
+            count += _buckets[i]._nodes.size();
+          return count;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of covering checks (calls to the less-or-equal predicate on nodes)
+         */
+        inline unsigned long cover_checks() const
+        {
+          return _cover_checks.load();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of covering checks that have been avoided thanks to keys and signatures
+         */
+        inline unsigned long avoided_cover_checks() const
+        {
+          return _avoided_cover_checks.load();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Size of the table of buckets
+         */
+        inline std::size_t table_size() const
+        {
+          return _table_size;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of nodes in the biggest bucket
+         \note linear-time complexity in the size of table of nodes
+         \note not thread-safe
+         */
+        std::size_t max_container_size() const
+        {
+          std::size_t max = 0;
+          for (std::size_t i = 0; i < _table_size; ++i)
+            max = std::max(max, _buckets[i]._nodes.size());
+          return max;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of non-empty buckets
+         \note linear-time complexity in the size of table of nodes
+         \note not thread-safe
+         */
+        std::size_t nonempty_containers_count() const
+        {
+          std::size_t count = 0;
+          for (std::size_t i = 0; i < _table_size; ++i)
+            if (_buckets[i]._nodes.size() != 0)
+              ++count;
+          return count;
+        }
+      private:
+        /*!
+         \brief Accessor
+         \param n : a node
+         \param key : key of n
+         \post the position in table of n has been set to its bucket
+         \return the bucket of n
+         */
+        bucket_t & node_bucket(NODE_PTR const & n, KEY key)
+        {
+          tchecker::graph::cover::node_position_t position = key % _table_size;
+          n->position_in_table(position);
+          return _buckets[position];
+        }
+        
+        /*!
+         \brief Update counters of covering checks
+         \param checks : number of covering checks
+         \param avoided_checks : number of avoided covering checks
+         \post checks and avoided_checks have been added to the counters
+         */
+        void count_checks(unsigned long checks, unsigned long avoided_checks)
+        {
+          _cover_checks.fetch_add(checks, std::memory_order_relaxed);
+          _avoided_cover_checks.fetch_add(avoided_checks, std::memory_order_relaxed);
+        }
+        
+        NODE_TO_KEY _node_to_key;                                           /*!< a node-to-key map */
+        NODE_TO_SIGNATURE _node_to_signature;                               /*!< a node-to-signature map */
+        std::size_t const _table_size;                                      /*!< Number of buckets */
+        std::unique_ptr<bucket_t[]> _buckets;                               /*!< Table of buckets */
+        std::atomic<unsigned long> _cover_checks;                           /*!< Number of covering checks */
+        std::atomic<unsigned long> _avoided_cover_checks;                   /*!< Number of avoided covering checks */
+      };
+      
+    } // end of namespace cover
+    
+  } // end of namespace graph
+  
+} // end of namespace tchecker
+
+#endif // TCHECKER_CONCURRENT_COVER_GRAPH_HH
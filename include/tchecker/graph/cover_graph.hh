@@ -8,7 +8,12 @@
 #ifndef TCHECKER_COVER_GRAPH_HH
 #define TCHECKER_COVER_GRAPH_HH
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -26,8 +31,9 @@ namespace tchecker {
     
     namespace cover {
       
-      // Forward declaration
-      template <class NPTR, class K> class graph_t;
+      // Forward declarations
+      template <class NPTR, class K, class NTK, class LE, class NTS> class graph_t;
+      template <class NPTR, class K, class NTK, class NTS> class concurrent_graph_t;
       
       
       
@@ -47,6 +53,45 @@ namespace tchecker {
       template <class NODE_PTR>
       using node_binary_predicate_t = std::function<bool(NODE_PTR const &, NODE_PTR const &)>;
       
+      /*!
+       \brief Type of node signatures
+       \note signatures are bitsets that allow to discard covering checks: if a node n1 is less-or-equal to a node n2,
+       then all the bits set in the signature of n2 should also be set in the signature of n1
+       */
+      using signature_t = std::uint64_t;
+      
+      /*!
+       \brief Node-to-signature map
+       \tparam NODE_PTR : type of pointers to node
+       */
+      template <class NODE_PTR>
+      using node_to_signature_t = std::function<tchecker::graph::cover::signature_t(NODE_PTR const &)>;
+      
+      /*!
+       \brief Signature ordering
+       \param sig1 : a signature
+       \param sig2 : a signature
+       \return true if all the bits set in sig2 are also set in sig1, false otherwise
+       \note a node with signature sig1 can only be less-or-equal to a node with signature sig2 if
+       signature_le(sig1, sig2) holds
+       */
+      inline bool signature_le(tchecker::graph::cover::signature_t sig1, tchecker::graph::cover::signature_t sig2)
+      {
+        return ((sig2 & ~sig1) == 0);
+      }
+      
+      /*!
+       \brief Node-to-signature map that maps all nodes to the empty signature (no pruning)
+       \tparam NODE_PTR : type of pointers to node
+       \param n : a node
+       \return 0
+       */
+      template <class NODE_PTR>
+      tchecker::graph::cover::signature_t empty_signature(NODE_PTR const & n)
+      {
+        return 0;
+      }
+      
       
       
       
@@ -56,8 +101,11 @@ namespace tchecker {
          \class nodes_container_t
          \brief Type of container of nodes
          \tparam NODE_PTR : type of pointers to node, *NODE_PTR should inherit from tchecker::graph::cover::node_t
+         \tparam KEY : type of keys
+         \note the key and the signature of each node are stored along with the node, in order to discard candidate
+         nodes in covering queries without dereferencing them
          */
-        template <class NODE_PTR>
+        template <class NODE_PTR, class KEY>
         class nodes_container_t {
         public:
           /*!
@@ -71,19 +119,23 @@ namespace tchecker {
             for (NODE_PTR & n : _vector)
               n->clear_position();
             _vector.clear();
+            _index.clear();
           }
           
           /*!
            \brief Add node
            \param n : a node
+           \param key : key of n
+           \param signature : signature of n
            \pre n is not stored (not checked)
            \post n has been added to this container
            \note invalidates iterators on this container
            */
-          void add(NODE_PTR const & n)
+          void add(NODE_PTR const & n, KEY key, tchecker::graph::cover::signature_t signature)
           {
             n->position_in_container(_vector.size());
             _vector.push_back(n);
+            _index.push_back(index_entry_t{key, signature});
           }
           
           /*!
@@ -105,6 +157,75 @@ namespace tchecker {
             n->clear_position();
             _vector[position] = _vector.back();
             _vector.pop_back();
+            _index[position] = _index.back();
+            _index.pop_back();
+          }
+          
+          /*!
+           \brief Move nodes to another container
+           \param container : a container of nodes
+           \param pred : a predicate on keys
+           \post all nodes n in this container such that pred(key of n) holds have been moved to container. The
+           relative order of nodes in this container and of nodes moved to container has been preserved
+           \note linear-time complexity in the size of this container
+           \note invalidates iterators on this container and on container
+           */
+          template <class PRED>
+          void move_if(tchecker::graph::cover::details::nodes_container_t<NODE_PTR, KEY> & container, PRED && pred)
+          {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < _vector.size(); ++i) {
+              if (pred(_index[i]._key)) {
+                _vector[i]->clear_position();
+                container.add(_vector[i], _index[i]._key, _index[i]._signature);
+              }
+              else {
+                if (kept != i) {
+                  _vector[kept] = _vector[i];
+                  _index[kept] = _index[i];
+                }
+                _vector[kept]->position_in_container(kept);
+                ++kept;
+              }
+            }
+            _vector.resize(kept);
+            _index.resize(kept);
+          }
+          
+          /*!
+           \brief Accessor
+           \param i : position in this container
+           \pre i < size() (checked by assertion)
+           \return node at position i
+           */
+          inline NODE_PTR const & node(std::size_t i) const
+          {
+            assert(i < _vector.size());
+            return _vector[i];
+          }
+          
+          /*!
+           \brief Accessor
+           \param i : position in this container
+           \pre i < size() (checked by assertion)
+           \return key of the node at position i
+           */
+          inline KEY key(std::size_t i) const
+          {
+            assert(i < _index.size());
+            return _index[i]._key;
+          }
+          
+          /*!
+           \brief Accessor
+           \param i : position in this container
+           \pre i < size() (checked by assertion)
+           \return signature of the node at position i
+           */
+          inline tchecker::graph::cover::signature_t signature(std::size_t i) const
+          {
+            assert(i < _index.size());
+            return _index[i]._signature;
           }
           
           /*!
@@ -116,7 +237,7 @@ namespace tchecker {
            \brief Accessor
            \return constant iterator on first node in container if any, past-the-end iterator otherwise
            */
-          tchecker::graph::cover::details::nodes_container_t<NODE_PTR>::const_iterator_t begin() const
+          tchecker::graph::cover::details::nodes_container_t<NODE_PTR, KEY>::const_iterator_t begin() const
           {
             return _vector.begin();
           }
@@ -125,7 +246,7 @@ namespace tchecker {
            \brief Accessor
            \return constant past-the-end iterator
            */
-          tchecker::graph::cover::details::nodes_container_t<NODE_PTR>::const_iterator_t end() const
+          tchecker::graph::cover::details::nodes_container_t<NODE_PTR, KEY>::const_iterator_t end() const
           {
             return _vector.end();
           }
@@ -140,7 +261,16 @@ namespace tchecker {
             return _vector.size();
           }
         private:
-          std::vector<NODE_PTR> _vector;  /*!< Container of nodes */
+          /*!
+           \brief Type of index entries
+           */
+          struct index_entry_t {
+            KEY _key;                                          /*!< Key of node */
+            tchecker::graph::cover::signature_t _signature;    /*!< Signature of node */
+          };
+          
+          std::vector<NODE_PTR> _vector;        /*!< Container of nodes */
+          std::vector<index_entry_t> _index;    /*!< Keys and signatures of nodes (same order as _vector) */
         };
         
       } // end of namespace details
@@ -195,8 +325,9 @@ namespace tchecker {
          */
         tchecker::graph::cover::node_t & operator= (tchecker::graph::cover::node_t &) = default;
       private:
-        template <class NPTR> friend class tchecker::graph::cover::details::nodes_container_t;
-        template <class NPTR, class K> friend class tchecker::graph::cover::graph_t;
+        template <class NPTR, class K> friend class tchecker::graph::cover::details::nodes_container_t;
+        template <class NPTR, class K, class NTK, class LE, class NTS> friend class tchecker::graph::cover::graph_t;
+        template <class NPTR, class K, class NTK, class NTS> friend class tchecker::graph::cover::concurrent_graph_t;
         
         /*!
          \brief Accessor
@@ -272,23 +403,39 @@ namespace tchecker {
        \brief Graph with node covering
        \tparam NODE_PTR : type of pointers to node, *NODE_PTR should inherit from tchecker::graph::cover::node_t
        \tparam KEY : type of keys
+       \tparam NODE_TO_KEY : type of node-to-key map, callable as KEY(NODE_PTR const &)
+       \tparam LE_NODE : type of less-or-equal predicate on nodes, callable as bool(NODE_PTR const &, NODE_PTR const &)
+       \tparam NODE_TO_SIGNATURE : type of node-to-signature map, callable as
+       tchecker::graph::cover::signature_t(NODE_PTR const &)
+       \note NODE_TO_KEY, LE_NODE and NODE_TO_SIGNATURE default to type-erased std::function. Instantiating this graph
+       with the actual types of the maps and of the predicate allows covering checks to be inlined
        \note this graph stores nodes in a map : keys -> containers of nodes. All nodes with the same key
        are stored in the same container. Keys are used to restrict the set of nodes that need to be examined
        for covering queries: only the nodes with the same key are considered
+       \note the key and the signature of each node are stored in its container. Covering checks between nodes with
+       distinct keys, or with signatures that are not ordered (see tchecker::graph::cover::signature_le), are avoided
+       \note the table of containers grows by linear hashing: each time the number of nodes per container exceeds
+       the maximal load factor, one container is split in two. Hence, the table grows incrementally (one container at
+       a time), and only the nodes in the split container are moved (and their position in table is updated)
        */
-      template <class NODE_PTR, class KEY=std::size_t>
+      template <class NODE_PTR,
+      class KEY=std::size_t,
+      class NODE_TO_KEY=tchecker::graph::cover::node_to_key_t<KEY, NODE_PTR>,
+      class LE_NODE=tchecker::graph::cover::node_binary_predicate_t<NODE_PTR>,
+      class NODE_TO_SIGNATURE=tchecker::graph::cover::node_to_signature_t<NODE_PTR>
+      >
       class graph_t {
         static_assert(std::is_unsigned<KEY>::value, "");
       private:
         /*!
          \brief Type of map : index -> container of nodes
          */
-        using nodes_map_t = std::vector<tchecker::graph::cover::details::nodes_container_t<NODE_PTR>>;
+        using nodes_map_t = std::vector<tchecker::graph::cover::details::nodes_container_t<NODE_PTR, KEY>>;
         
         /*!
          \brief Type of nodes container
          */
-        using nodes_container_t = tchecker::graph::cover::details::nodes_container_t<NODE_PTR>;
+        using nodes_container_t = tchecker::graph::cover::details::nodes_container_t<NODE_PTR, KEY>;
       public:
         /*!
          \brief Type of pointers to node
@@ -300,31 +447,56 @@ namespace tchecker {
          */
         using key_t = KEY;
         
+        /*!
+         \brief Default maximal load factor (number of nodes per container)
+         */
+        static constexpr double DEFAULT_MAX_LOAD_FACTOR = 4.0;
+        
         /*!
          \brief Constructor
-         \param table_size : size of the table of node containers
+         \param table_size : initial size of the table of node containers
          \param node_to_key : a map from NODE_PTR to KEY
          \param le_node : s less-or-equal predicate on nodes
-         \throw std::invalid_argument : if table_size is too big w.r.t. type tchecker::graph::cover::node_position_t
+         \param node_to_signature : a map from NODE_PTR to signatures, such that le_node(n1, n2) implies
+         signature_le(node_to_signature(n1), node_to_signature(n2))
+         \param max_load_factor : maximal number of nodes per container before the table grows
+         \throw std::invalid_argument : if table_size is 0 or too big w.r.t. type tchecker::graph::cover::node_position_t,
+         or if max_load_factor is not positive
          */
         graph_t(std::size_t table_size,
-                tchecker::graph::cover::node_to_key_t<KEY, NODE_PTR> node_to_key,
-                tchecker::graph::cover::node_binary_predicate_t<NODE_PTR> le_node)
-        : _node_to_key(std::move(node_to_key)), _le_node(std::move(le_node)), _nodes(table_size)
+                NODE_TO_KEY node_to_key,
+                LE_NODE le_node,
+                NODE_TO_SIGNATURE node_to_signature = tchecker::graph::cover::empty_signature<NODE_PTR>,
+                double max_load_factor = DEFAULT_MAX_LOAD_FACTOR)
+        : _node_to_key(std::move(node_to_key)),
+        _le_node(std::move(le_node)),
+        _node_to_signature(std::move(node_to_signature)),
+        _nodes(table_size),
+        _initial_size(table_size),
+        _level_size(table_size),
+        _split(0),
+        _nodes_count(0),
+        _max_load_factor(max_load_factor),
+        _cover_checks(0),
+        _avoided_cover_checks(0)
         {
+          if (table_size == 0)
+            throw std::invalid_argument("table size should be positive");
           if (table_size > std::numeric_limits<tchecker::graph::cover::node_position_t>::max())
             throw std::invalid_argument("table size exceeds node positions");
+          if (max_load_factor <= 0.0)
+            throw std::invalid_argument("maximal load factor should be positive");
         }
         
         /*!
          \brief Copy constructor
          */
-        graph_t(tchecker::graph::cover::graph_t<NODE_PTR, KEY> const &) = default;
+        graph_t(tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> const &) = default;
         
         /*!
          \brief Move constructor
          */
-        graph_t(tchecker::graph::cover::graph_t<NODE_PTR, KEY> &&) = default;
+        graph_t(tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &&) = default;
         
         /*!
          \brief Destructor
@@ -334,42 +506,50 @@ namespace tchecker {
         /*!
          \brief Assignment operator
          */
-        tchecker::graph::cover::graph_t<NODE_PTR, KEY> &
-        operator= (tchecker::graph::cover::graph_t<NODE_PTR, KEY> const &) = default;
+        tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &
+        operator= (tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> const &) = default;
         
         /*!
          \brief Move-assignment operator
          */
-        tchecker::graph::cover::graph_t<NODE_PTR, KEY> & operator= (tchecker::graph::cover::graph_t<NODE_PTR, KEY> &&) = default;
+        tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> & operator= (tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE> &&) = default;
         
         /*!
          \brief Clear
-         \post The graph is empty
+         \post The graph is empty, and the table of node containers has its initial size
          \note No destructor call on nodes
          */
         void clear()
         {
           for (auto & container : _nodes)
             container.clear();
-          _nodes.clear();
+          _nodes.resize(_initial_size);
+          _level_size = _initial_size;
+          _split = 0;
+          _nodes_count = 0;
         }
         
         /*!
          \brief Add node
          \param n : a node
          \pre n is not stored in a graph
-         \post n has been added to the graph
+         \post n has been added to the graph. The table of node containers may have grown by one container
          \throw std::invalid_argument : if n is already stored in a graph
-         \note complexity : computation of the key of node n
+         \note complexity : computation of the key and of the signature of node n, and linear in the size of the
+         split container if the table grows
          \note invalidates iterators
          */
         void add_node(NODE_PTR const & n)
         {
           if (n->is_stored())
             throw std::invalid_argument("adding a stored node is not allowed");
-          tchecker::graph::cover::node_position_t position =_node_to_key(n) % _nodes.size();
+          KEY const key = _node_to_key(n);
+          tchecker::graph::cover::node_position_t position = table_position(key);
           n->position_in_table(position);
-          _nodes[position].add(n);
+          _nodes[position].add(n, key, _node_to_signature(n));
+          ++_nodes_count;
+          if (_nodes_count > _max_load_factor * _nodes.size())
+            grow();
         }
         
         /*!
@@ -390,6 +570,7 @@ namespace tchecker {
           if (position >= _nodes.size())
             throw std::invalid_argument("removing a node which is not stored in this graph is not allowed");
           _nodes[position].remove(n);
+          --_nodes_count;
         }
         
         /*!
@@ -404,11 +585,19 @@ namespace tchecker {
         {
           assert(n->position_in_table() < _nodes.size());
           auto const & container = _nodes[n->position_in_table()];
-          for (NODE_PTR const & node : container)
-            if (_le_node(n, node)) {
-              covering_node = node;
+          KEY const key = container.key(n->position_in_container());
+          tchecker::graph::cover::signature_t const signature = container.signature(n->position_in_container());
+          for (std::size_t i = 0; i < container.size(); ++i) {
+            if ((container.key(i) != key) || ! tchecker::graph::cover::signature_le(signature, container.signature(i))) {
+              ++_avoided_cover_checks;
+              continue;
+            }
+            ++_cover_checks;
+            if (_le_node(n, container.node(i))) {
+              covering_node = container.node(i);
               return true;
             }
+          }
           
           covering_node = nullptr;
           return false;
@@ -426,21 +615,80 @@ namespace tchecker {
         {
           assert(n->position_in_table() < _nodes.size());
           auto const & container = _nodes[n->position_in_table()];
-          for (NODE_PTR const & node : container)
-            if (_le_node(node, n))
-              ins = node;
+          KEY const key = container.key(n->position_in_container());
+          tchecker::graph::cover::signature_t const signature = container.signature(n->position_in_container());
+          for (std::size_t i = 0; i < container.size(); ++i) {
+            if ((container.key(i) != key) || ! tchecker::graph::cover::signature_le(container.signature(i), signature)) {
+              ++_avoided_cover_checks;
+              continue;
+            }
+            ++_cover_checks;
+            if (_le_node(container.node(i), n))
+              ins = container.node(i);
+          }
         }
         
         /*!
          \brief Accessor
          \return Number of nodes in this graph
-         \note linear-time complexity in the size of table of nodes
+         \note constant-time complexity
+         */
+        inline std::size_t nodes_count() const
+        {
+          return _nodes_count;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Current size of the table of node containers
+         */
+        inline std::size_t table_size() const
+        {
+          return _nodes.size();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of covering checks (calls to the less-or-equal predicate on nodes)
+         */
+        inline unsigned long cover_checks() const
+        {
+          return _cover_checks;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of covering checks that have been avoided thanks to keys and signatures
+         */
+        inline unsigned long avoided_cover_checks() const
+        {
+          return _avoided_cover_checks;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of nodes in the biggest container in the table
+         \note linear-time complexity in the size of the table
+         */
+        std::size_t max_container_size() const
+        {
+          std::size_t max = 0;
+          for (nodes_container_t const & c : _nodes)
+            max = std::max(max, c.size());
+          return max;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of non-empty containers in the table
+         \note linear-time complexity in the size of the table
          */
-        std::size_t nodes_count() const
+        std::size_t nonempty_containers_count() const
         {
           std::size_t count = 0;
           for (nodes_container_t const & c : _nodes)
-            count += c.size();
+            if (c.size() != 0)
+              ++count;
           return count;
         }
         
@@ -454,9 +702,9 @@ namespace tchecker {
          \brief Accessor
          \return Iterator pointing to the first node in the graph, or past-the-end if the graph is empty
          */
-        tchecker::graph::cover::graph_t<NODE_PTR, KEY>::const_iterator_t begin() const
+        tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE>::const_iterator_t begin() const
         {
-          return tchecker::graph::cover::graph_t<NODE_PTR, KEY>::const_iterator_t
+          return tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE>::const_iterator_t
           (_nodes.begin(),
            _nodes.end(),
            [] (typename nodes_map_t::const_iterator const & it) {
@@ -468,9 +716,9 @@ namespace tchecker {
          \brief Accessor
          \return Past-the-end iterator
          */
-        tchecker::graph::cover::graph_t<NODE_PTR, KEY>::const_iterator_t end() const
+        tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE>::const_iterator_t end() const
         {
-          return tchecker::graph::cover::graph_t<NODE_PTR, KEY>::const_iterator_t
+          return tchecker::graph::cover::graph_t<NODE_PTR, KEY, NODE_TO_KEY, LE_NODE, NODE_TO_SIGNATURE>::const_iterator_t
           (_nodes.end(),
            _nodes.end(),
            [] (typename nodes_map_t::const_iterator const & it) {
@@ -478,9 +726,60 @@ namespace tchecker {
            });
         }
       protected:
-        tchecker::graph::cover::node_to_key_t<KEY, NODE_PTR> _node_to_key;  /*!< a node-to-key map */
-        tchecker::graph::cover::node_binary_predicate_t<NODE_PTR> _le_node; /*!< less-or-equal relation on node pointers */
+        /*!
+         \brief Accessor
+         \param key : a key
+         \return position in the table of the container of nodes with key
+         \note containers below the split pointer have already been split at the current level, hence their nodes
+         are addressed modulo twice the level size
+         */
+        tchecker::graph::cover::node_position_t table_position(KEY key) const
+        {
+          std::size_t position = key % _level_size;
+          if (position < _split)
+            position = key % (2 * _level_size);
+          return static_cast<tchecker::graph::cover::node_position_t>(position);
+        }
+        
+        /*!
+         \brief Grow the table of node containers by one container
+         \post the container at the split pointer has been split: its nodes have been distributed between this
+         container and a new container at the end of the table, preserving their relative order. The position in table
+         of moved nodes has been updated.
+         The table does not grow beyond the capacity of tchecker::graph::cover::node_position_t
+         */
+        void grow()
+        {
+          if (_nodes.size() >= std::numeric_limits<tchecker::graph::cover::node_position_t>::max())
+            return;
+          
+          std::size_t const new_position = _split + _level_size;
+          assert(new_position == _nodes.size());
+          _nodes.emplace_back();
+          
+          std::size_t const new_size = 2 * _level_size;
+          _nodes[_split].move_if(_nodes[new_position], [&] (KEY key) { return (key % new_size == new_position); });
+          for (NODE_PTR const & node : _nodes[new_position])
+            node->position_in_table(static_cast<tchecker::graph::cover::node_position_t>(new_position));
+          
+          ++_split;
+          if (_split == _level_size) {
+            _level_size *= 2;
+            _split = 0;
+          }
+        }
+        
+        NODE_TO_KEY _node_to_key;                                           /*!< a node-to-key map */
+        mutable LE_NODE _le_node;                                           /*!< less-or-equal relation on node pointers */
+        NODE_TO_SIGNATURE _node_to_signature;                               /*!< a node-to-signature map */
         nodes_map_t _nodes;                                                 /*!< map : key -> nodes with that key */
+        std::size_t _initial_size;                                          /*!< Initial size of _nodes */
+        std::size_t _level_size;                                            /*!< Size of _nodes at current level */
+        std::size_t _split;                                                 /*!< Next container to split */
+        std::size_t _nodes_count;                                           /*!< Number of nodes in graph */
+        double _max_load_factor;                                            /*!< Max number of nodes per container */
+        mutable unsigned long _cover_checks;                                /*!< Number of covering checks */
+        mutable unsigned long _avoided_cover_checks;                        /*!< Number of avoided covering checks */
       };
       
     } // end of namespace cover
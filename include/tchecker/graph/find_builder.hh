@@ -28,6 +28,7 @@ namespace tchecker {
      \tparam TS : type of transition system (see tchecker::ts::ts_t)
      \tparam FIND_GRAPH : type of find graph, should derive from tchecker::graph::find_graph_t, and
      should be a graph allocator (see tchecker::graph::graph_allocator_t)
+     \note the components of new nodes are shared with other nodes (see tchecker::graph::graph_allocator_t::share_node)
      */
     template <class TS, class FIND_GRAPH>
     class ts_find_builder_t : protected tchecker::graph::ts_builder_t<TS, FIND_GRAPH> {
@@ -108,6 +109,8 @@ namespace tchecker {
         
         node_ptr_t actual_node = this->_graph.find(node);
         bool is_new_node = (actual_node == node);
+        if (is_new_node)
+          this->_graph.share_node(actual_node);
         return std::make_tuple(actual_node, edge, status, is_new_node);
       }
       
@@ -146,6 +149,8 @@ namespace tchecker {
         
         node_ptr_t actual_next_node = this->_graph.find(next_node);
         bool is_new_node = (actual_next_node == next_node);
+        if (is_new_node)
+          this->_graph.share_node(actual_next_node);
         return std::make_tuple(actual_next_node, edge, status, is_new_node);
       }
     };
@@ -9,6 +9,7 @@
 #define TCHECKER_TA_DETAILS_TA_HH
 
 #include "tchecker/basictypes.hh"
+#include "tchecker/flat_system/outgoing_edges_cache.hh"
 #include "tchecker/fsm/details/fsm.hh"
 #include "tchecker/variables/clocks.hh"
 
@@ -29,6 +30,7 @@ namespace tchecker {
        \tparam MODEL : type of model, should inherit from tchecker::ta::details::model_t
        \tparam VLOC : type of tuple of locations, locations should inherit from tchecker::ta::loc_t
        \tparam INTVARS_VAL : type of integer variables valuation
+       \note outgoing edges are memoized per tuple of locations (see tchecker::outgoing_edges_cache_t)
        */
       template <class MODEL, class VLOC, class INTVARS_VAL>
       class ta_t : protected tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL> {
@@ -53,8 +55,11 @@ namespace tchecker {
          \param model : a model
          */
         explicit ta_t(MODEL & model)
-        : tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL>(model)
-        {}
+        : tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL>(model),
+        _outgoing_edges_cache(model.system(), model.synchronizer(), OUTGOING_EDGES_CACHE_CAPACITY)
+        {
+          _outgoing_edges_cache.prebuild(OUTGOING_EDGES_PREBUILD_MAX);
+        }
         
         /*!
          \brief Copy constructor
@@ -115,19 +120,39 @@ namespace tchecker {
         /*!
          \brief Type of iterator over outgoing edges
          */
-        using outgoing_edges_iterator_t
-        = typename tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL>::outgoing_edges_iterator_t;
+        using outgoing_edges_iterator_t = typename tchecker::outgoing_edges_cache_t<typename MODEL::system_t, VLOC>::iterator_t;
         
         /*!
          \brief Accessor
          \param vloc : tuple of locations
          \return range of outgoing synchronized and asynchronous edges from vloc
+         \note the returned range is invalidated by the next call to outgoing_edges
+         */
+        tchecker::range_t<outgoing_edges_iterator_t> outgoing_edges(VLOC const & vloc)
+        {
+          return _outgoing_edges_cache.outgoing_edges(vloc);
+        }
+        
+        /*!
+         \brief Accessor
+         \param vloc : tuple of locations
+         \param intvars_val : valuation of bounded integer variables
+         \return range of outgoing synchronized and asynchronous edges from vloc, where tuples of edges that
+         contain an edge with an integer guard that does not hold on intvars_val have been filtered out
          \note see tchecker::fsm::details::fsm_t::outgoing_edges
+         \note the returned range is invalidated by the next call to outgoing_edges
+         \throw std::invalid_argument : if intvars_val size is not compatible with the model's bounded
+         integer variables
          */
-        using tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL>::outgoing_edges;
+        tchecker::range_t<outgoing_edges_iterator_t> outgoing_edges(VLOC const & vloc, INTVARS_VAL const & intvars_val)
+        {
+          this->load_filter_intvars_val(intvars_val);
+          return _outgoing_edges_cache.outgoing_edges(vloc, &this->_edges_filter);
+        }
         
         /*!
          \brief Dereference type for iterator over outgoing edges
+         \note same as for tchecker::fsm::details::fsm_t, hence next() accepts the tuples of edges in the cache
          */
         using outgoing_edges_iterator_value_t
         = typename tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL>::outgoing_edges_iterator_value_t;
@@ -161,6 +186,19 @@ namespace tchecker {
         {
           return tchecker::fsm::details::fsm_t<MODEL, VLOC, INTVARS_VAL>::model();
         }
+      protected:
+        /*!
+         \brief Maximal number of tuples of locations in the cache of outgoing edges
+         */
+        static constexpr std::size_t OUTGOING_EDGES_CACHE_CAPACITY = 16384;
+        
+        /*!
+         \brief Maximal number of tuples of locations in a system for the cache of outgoing edges to be
+         filled at construction
+         */
+        static constexpr std::size_t OUTGOING_EDGES_PREBUILD_MAX = 256;
+        
+        tchecker::outgoing_edges_cache_t<typename MODEL::system_t, VLOC> _outgoing_edges_cache;  /*!< Cache of outgoing edges */
       };
       
     } // end of namespace details
@@ -106,7 +106,7 @@ namespace tchecker {
          */
         virtual tchecker::range_t<typename TA::outgoing_edges_iterator_t> outgoing_edges(STATE const & s)
         {
-          return _ta.outgoing_edges(s.vloc());
+          return _ta.outgoing_edges(s.vloc(), s.intvars_valuation());
         }
         
         /*!
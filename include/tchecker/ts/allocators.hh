@@ -370,6 +370,27 @@ namespace tchecker {
         return _state_allocator.destruct(p);
       }
       
+      /*!
+       \brief Share components of a state
+       \param p : pointer to state
+       \pre p has been allocated by this allocator, and is not nullptr. The state pointed by p will not be
+       modified anymore
+       \post the components of the state pointed by p are shared with other states (see STATE_ALLOCATOR::share())
+       */
+      inline void share_state(state_ptr_t & p)
+      {
+        _state_allocator.share(*p);
+      }
+      
+      /*!
+       \brief Accessor
+       \return State allocator
+       */
+      inline STATE_ALLOCATOR const & state_allocator() const
+      {
+        return _state_allocator;
+      }
+      
       /*!
        \brief Transition contruction
        \param args : parameters to a constructor of transition_t
@@ -95,6 +95,8 @@ namespace tchecker {
         transition_ptr_t transition = _allocator.construct_transition(std::forward<std::tuple<TARGS...>>(targs));
         
         tchecker::state_status_t status = _ts.initialize(*state, *transition, v);
+        if (status == tchecker::STATE_OK)
+          _allocator.share_state(state);
         
         return std::make_tuple((status == tchecker::STATE_OK ? state : state_ptr_t(nullptr)), transition, status);
       }
@@ -121,6 +123,8 @@ namespace tchecker {
         transition_ptr_t transition = _allocator.construct_transition(std::forward<std::tuple<TARGS...>>(targs));
         
         tchecker::state_status_t status = _ts.next(*next_state, *transition, v);
+        if (status == tchecker::STATE_OK)
+          _allocator.share_state(next_state);
         
         return std::make_tuple((status == tchecker::STATE_OK ? next_state : state_ptr_t(nullptr)), transition, status);
       }
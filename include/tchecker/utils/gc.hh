@@ -8,7 +8,11 @@
 #ifndef TCHECKER_GC_HH
 #define TCHECKER_GC_HH
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -22,22 +26,41 @@ namespace tchecker {
   /*!
    \class gc_t
    \brief Garbarge collector for pool allocated objects
-   \note Repeatedly runs a list of functions. Functions are added using method
+   \note Runs a list of collection functions. Functions are added using method
    enroll(). A specialized version of enroll() for tchecker::pool_t adds the
    pool_t::collect() method to the list of functions. Enrolled functions should
    terminate. The GC is run in a separate thread. Hence, enrolled functions should
    be thread safe.
+   \note The GC thread sleeps between two collections. A collection is run when
+   it is requested by an enrolled pool (see request_collection()), and at least
+   once every period otherwise.
    \note Use enroll() to register functions and pools. Then, use start() to start
    garbage collecting, and use stop() to stop garbarge collecting.
    \note Garbage collection must be stopped before any enrolled pool is destructed
    */
   class gc_t {
   public:
+    /*!
+     \brief Default period between two collections
+     */
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD{10};
+    
     /*!
      \brief Constructor
+     \post this garbage collector runs collections with period DEFAULT_PERIOD
      */
     gc_t();
     
+    /*!
+     \brief Constructor
+     \param period : maximal period between two collections
+     \pre period > 0
+     \post this garbage collector runs collections at least once every period,
+     and whenever a collection is requested
+     \throw std::invalid_argument : if period is not positive
+     */
+    gc_t(std::chrono::milliseconds period);
+    
     /*!
      \brief Copy constructor (deleted)
      */
@@ -45,6 +68,7 @@ namespace tchecker {
     
     /*!
      \brief Move constructor
+     \pre gc is not running
      */
     gc_t(tchecker::gc_t && gc);
     
@@ -61,25 +85,37 @@ namespace tchecker {
     
     /*!
      \brief Move-assignment operator
+     \pre neither this nor gc is running
      */
     tchecker::gc_t & operator= (tchecker::gc_t &&);
     
     /*!
      \brief Enroll a function
-     \param f : function
-     \pre f terminates and garbage collection is stopped
-     \post f has been added to the list of GC functions
+     \param collect : collection function, returns the number of collected chunks
+     \param memsize : memory footprint function
+     \pre collect and memsize terminate and garbage collection is stopped
+     \post collect has been added to the list of GC functions. memsize is used to
+     compute the peak memory footprint of enrolled functions (see peak_memsize())
      \throw std::runtime_error : if garbage collection is running
      */
-    void enroll(std::function<void(void)> && f);
+    void enroll(std::function<std::size_t(void)> && collect, std::function<std::size_t(void)> && memsize);
     
     /*!
      \brief Garbarge collection
-     \post Repeatedly runs enrolled functions in a round-robin
+     \post Runs enrolled functions each time a collection is requested or the
+     period has elapsed
      \note The function terminates if stop() is called. As a result, execution
      of enrolled functions is suspended
      */
-    void collect() const;
+    void collect();
+    
+    /*!
+     \brief Request a collection
+     \post The garbage collection thread has been woken up
+     \note thread-safe, meant to be called by enrolled pools under allocation
+     pressure
+     */
+    void request_collection();
     
     /*!
      \brief Start garbage collection
@@ -97,10 +133,69 @@ namespace tchecker {
      This method may not terminate if an enrolled function does not terminate.
      */
     void stop();
+    
+    /*!
+     \brief Accessor
+     \return Maximal period between two collections
+     */
+    inline std::chrono::milliseconds period() const
+    {
+      return _period;
+    }
+    
+    /*!
+     \brief Accessor
+     \return Number of collections run so far
+     */
+    inline unsigned long collections() const
+    {
+      return _collections.load(std::memory_order_relaxed);
+    }
+    
+    /*!
+     \brief Accessor
+     \return Number of chunks collected so far
+     */
+    inline unsigned long collected_chunks() const
+    {
+      return _collected_chunks.load(std::memory_order_relaxed);
+    }
+    
+    /*!
+     \brief Accessor
+     \return Time spent in collections so far (seconds)
+     */
+    double collection_time() const;
+    
+    /*!
+     \brief Accessor
+     \return Peak memory footprint of enrolled functions, sampled after each
+     collection (bytes)
+     */
+    inline std::size_t peak_memsize() const
+    {
+      return _peak_memsize.load(std::memory_order_relaxed);
+    }
   private:
-    std::vector< std::function<void(void)> > _functions;    /*!< GC functions */
-    bool _stop;                                             /*!< Stop flag */
-    std::thread * _thread;                                  /*!< GC thread */
+    /*!
+     \brief Run enrolled functions once
+     \post All enrolled functions have been run (unless stop() has been called),
+     and statistics have been updated
+     */
+    void collect_once();
+    
+    std::vector< std::function<std::size_t(void)> > _functions;   /*!< GC functions */
+    std::vector< std::function<std::size_t(void)> > _memsizes;    /*!< Memory footprint functions */
+    std::chrono::milliseconds _period;                            /*!< Maximal period between collections */
+    std::atomic<bool> _stop;                                      /*!< Stop flag */
+    bool _requested;                                              /*!< Collection request flag */
+    std::mutex _mutex;                                            /*!< Protects _stop and _requested */
+    std::condition_variable _cv;                                  /*!< Wakes up GC thread */
+    std::thread * _thread;                                        /*!< GC thread */
+    std::atomic<unsigned long> _collections;                      /*!< Number of collections */
+    std::atomic<unsigned long> _collected_chunks;                 /*!< Number of collected chunks */
+    std::atomic<long long> _collection_time;                      /*!< Collection time (nanoseconds) */
+    std::atomic<std::size_t> _peak_memsize;                       /*!< Peak memory footprint */
   };
   
   
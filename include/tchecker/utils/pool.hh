@@ -8,9 +8,11 @@
 #ifndef TCHECKER_POOL_HH
 #define TCHECKER_POOL_HH
 
+#include <atomic>
+#include <limits>
+
 #include "tchecker/utils/gc.hh"
 #include "tchecker/utils/shared_objects.hh"
-#include "tchecker/utils/spinlock.hh"
 
 /*!
  \file pool.hh
@@ -34,6 +36,15 @@ namespace tchecker {
    only the other methods). The first thread plays the role of a garbage collector
    whereas the other thread uses the pool to construct objects. A garbage
    collection thread is implemented in the class tchecker::gc_t.
+   \note Free chunks are kept in two lists. The allocating thread owns a cache
+   of free chunks that it accesses without synchronization. Collected chunks are
+   pushed to a shared lock-free list, which is moved to the cache in one atomic
+   operation when the cache is empty. As the shared list is only ever taken as a
+   whole, it is not subject to the ABA problem
+   \note Collection only scans the blocks when some object of type T has lost its
+   last reference since the previous scan (see tchecker::make_shared_t::release_generation()).
+   A pool enrolled to a garbage collector requests a collection each time it
+   allocates a new block.
    */
   template <class T>
   class pool_t {
@@ -98,9 +109,12 @@ namespace tchecker {
     _block_size(_alloc_nb * _alloc_size + sizeof(void *)),
     _blocks_count(0),
     _free_head(nullptr),
+    _cache_head(nullptr),
     _block_head(nullptr),
     _raw_head(nullptr),
-    _raw_end(nullptr)
+    _raw_end(nullptr),
+    _collected_generation(std::numeric_limits<unsigned long>::max()),
+    _gc(nullptr)
     {
       if (_alloc_nb < 1)
         throw std::invalid_argument("allocation number should be >= 1");
@@ -193,9 +207,16 @@ namespace tchecker {
      collected in the list of free objects, and their counters have been set to
      FREE_CHUNK
      \return Number of collected chunks
+     \note The blocks are not scanned if no object of type T has lost its last
+     reference since the previous call
      */
     std::size_t collect()
     {
+      unsigned long const generation = T::release_generation();
+      if (((generation & 1) == 0) && (generation == _collected_generation))
+        return 0;
+      _collected_generation = T::acknowledge_releases();
+      
       std::size_t collected = 0;
       void * collected_begin = nullptr, * collected_end = nullptr;
       
@@ -291,8 +312,9 @@ namespace tchecker {
         p = nextblock(p);
         delete[] static_cast<char *>(tmp);
       }
-      _blocks_count = 0;
-      _free_head = nullptr;   // _free_head_lock access protection useless
+      _blocks_count.store(0, std::memory_order_relaxed);
+      _free_head.store(nullptr, std::memory_order_relaxed);
+      _cache_head = nullptr;
       _block_head = nullptr;
       _raw_head = nullptr;
       _raw_end = nullptr;
@@ -303,20 +325,22 @@ namespace tchecker {
      \return Memory footprint of the pool
      \note Constant time
      */
-    inline constexpr std::size_t memsize() const
+    inline std::size_t memsize() const
     {
-      return (_blocks_count * _block_size);
+      return (_blocks_count.load(std::memory_order_relaxed) * _block_size);
     }
     
     /*!
      \brief Enroll to garbarge collector
      \param gc : a garbage collector
      \pre this is not enrolled to a garbage collector yet
-     \post this is enrolled to gc
+     \post this is enrolled to gc, and requests a collection from gc each time a
+     new block is allocated
      */
     void enroll(tchecker::gc_t & gc)
     {
-      gc.enroll( [&] () { this->collect(); } );
+      gc.enroll( [&] () { return this->collect(); }, [&] () { return this->memsize(); } );
+      _gc = &gc;
     }
   protected:
     /*!
@@ -363,17 +387,18 @@ namespace tchecker {
      */
     inline void * allocate()
     {
+      // Refill the cache with all the collected chunks if needed
+      if (_cache_head == nullptr)
+        _cache_head = _free_head.exchange(nullptr, std::memory_order_acquire);
+      
       // Use a free chunk if any
-      _free_head_lock.lock();
-      if (_free_head != nullptr) {
-        typename T::refcount_t * refcount = reinterpret_cast<typename T::refcount_t *>(_free_head);
+      if (_cache_head != nullptr) {
+        typename T::refcount_t * refcount = reinterpret_cast<typename T::refcount_t *>(_cache_head);
         *refcount = ALLOCATED_CHUNK; // protect the first chunk from collection (i.e. method collect())
-        char * chunk = _free_head;
-        _free_head = static_cast<char *>(nextchunk(chunk));
-        _free_head_lock.unlock();
+        char * chunk = _cache_head;
+        _cache_head = static_cast<char *>(nextchunk(chunk));
         return chunk;
       }
-      _free_head_lock.unlock();
       
       // Allocate a new block if no chunk available
       if (_raw_head == _raw_end) {
@@ -386,7 +411,10 @@ namespace tchecker {
         // jump over 1st word used for linking chunks
         _raw_head = first_chunk_ptr(_raw_head);
         // count one more block
-        ++ _blocks_count;
+        _blocks_count.fetch_add(1, std::memory_order_relaxed);
+        // free list exhausted: collect released chunks for the next allocations
+        if (_gc != nullptr)
+          _gc->request_collection();
       }
       
       // Allocate a chunk from the raw block
@@ -401,14 +429,16 @@ namespace tchecker {
      \brief Release allocated memory
      \param chunk : pointer to chunk to release
      \pre chunk has been returned by allocate()
-     \post chunk has been released. The first SIZEOF_REFCOUNT bytes of chunk
-     have not been modified
+     \post chunk has been released to the cache of free chunks. Its reference
+     counter has been set to FREE_CHUNK
+     \note should only be called by the allocating thread
      */
     void release(void const * chunk)
     {
       typename T::refcount_t * refcount = static_cast<typename T::refcount_t *>(const_cast<void *>(chunk));
       *refcount = FREE_CHUNK;
-      this->release(chunk, chunk);
+      nextchunk(refcount) = _cache_head;
+      _cache_head = reinterpret_cast<char *>(refcount);
     }
     
     /*!
@@ -419,28 +449,33 @@ namespace tchecker {
      nextof() from begin eventually lead to end (linked list according to
      nextof()). All the chunks in the list have been returned by allocate() and
      have their refcount value FREE_CHUNK
-     \post All the chunks in the list begin..end have been released
+     \post All the chunks in the list begin..end have been released to the
+     shared list of free chunks
+     \note lock-free, safe to call concurrently with allocate()
      */
     inline void release(void const * begin, void const * end)
     {
-      void * pbegin = const_cast<void *>(begin);
+      char * pbegin = static_cast<char *>(const_cast<void *>(begin));
       void * pend = const_cast<void *>(end);
-      _free_head_lock.lock();
-      nextchunk(pend) = _free_head;
-      _free_head = static_cast<char *>(pbegin);
-      _free_head_lock.unlock();
+      char * head = _free_head.load(std::memory_order_relaxed);
+      do {
+        nextchunk(pend) = head;
+      } while ( ! _free_head.compare_exchange_weak(head, pbegin, std::memory_order_release,
+                                                   std::memory_order_relaxed) );
     }
     
     
-    std::size_t const _alloc_nb;     /*!< number of chunks per block */
-    std::size_t const _alloc_size;   /*!< size of a chunk (bytes) */
-    std::size_t const _block_size;   /*!< size of a block (bytes) */
-    std::size_t _blocks_count;       /*!< number of allocated blocks */
-    char * _free_head;               /*!< head pointer to list of free chunks */
-    char * _block_head;              /*!< head pointer to list of blocks */
-    char * _raw_head;                /*!< pointer to raw block */
-    char * _raw_end;                 /*!< pointer to past-the-end raw block */
-    spinlock_t _free_head_lock;      /*!< protect access to _free_head */
+    std::size_t const _alloc_nb;              /*!< number of chunks per block */
+    std::size_t const _alloc_size;            /*!< size of a chunk (bytes) */
+    std::size_t const _block_size;            /*!< size of a block (bytes) */
+    std::atomic<std::size_t> _blocks_count;   /*!< number of allocated blocks */
+    std::atomic<char *> _free_head;           /*!< head pointer to shared list of collected chunks */
+    char * _cache_head;                       /*!< head pointer to cache of free chunks (allocating thread) */
+    char * _block_head;                       /*!< head pointer to list of blocks */
+    char * _raw_head;                         /*!< pointer to raw block */
+    char * _raw_end;                          /*!< pointer to past-the-end raw block */
+    unsigned long _collected_generation;      /*!< release generation at last scan (see collect()) */
+    tchecker::gc_t * _gc;                     /*!< garbage collector this is enrolled to (if any) */
   };
   
 } // end of namespace tchecker
@@ -8,6 +8,7 @@
 #ifndef TCHECKER_SHARED_OBJECTS_HH
 #define TCHECKER_SHARED_OBJECTS_HH
 
+#include <atomic>
 #include <exception>
 #include <limits>
 
@@ -158,15 +159,18 @@ namespace tchecker {
      \post The reference counter has been incremented
      \thow std::overflow_error : if the value of the reference counter exceeds
      the maximal value
+     \note thread-safe: references on a shared object can be taken and released
+     concurrently from several threads
      */
     inline void take_reference(void) const
     {
-      refcount_t * refcount = refcount_addr();
-      if (*refcount == REFCOUNT_MAX)  // allocated object with no reference yet
-        *refcount = 1;                // first reference to this object
-      else
-        *refcount += 1;
-      if (*refcount == REFCOUNT_MAX)  // overflow
+      std::atomic<refcount_t> * refcount = atomic_refcount_addr();
+      refcount_t value = refcount->load(std::memory_order_relaxed), next;
+      do {
+        // first reference to an allocated object with no reference yet
+        next = (value == REFCOUNT_MAX ? 1 : value + 1);
+      } while ( ! refcount->compare_exchange_weak(value, next, std::memory_order_relaxed) );
+      if (next == REFCOUNT_MAX)  // overflow
         throw std::overflow_error("reference counter overflow");
     }
     
@@ -175,22 +179,66 @@ namespace tchecker {
      \post The reference counter has been decremented
      \throw std::underflow_error : if the value of the reference counter
      becomes smaller than 0
+     \note thread-safe (see take_reference())
      */
     inline void release_reference(void) const
     {
-      refcount_t * refcount = refcount_addr();
-      if (*refcount == 0)
-        throw std::underflow_error("reference counter underflow");
-      *refcount -= 1;
+      std::atomic<refcount_t> * refcount = atomic_refcount_addr();
+      refcount_t value = refcount->load(std::memory_order_relaxed);
+      do {
+        if (value == 0)
+          throw std::underflow_error("reference counter underflow");
+      } while ( ! refcount->compare_exchange_weak(value, value - 1, std::memory_order_release) );
+      
+      if (value == 1) { // last reference released: notify collectors (see acknowledge_releases())
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((_release_generation.load(std::memory_order_relaxed) & 1) == 0)
+          _release_generation.fetch_or(1, std::memory_order_relaxed);
+      }
+    }
+    
+    /*!
+     \brief Accessor
+     \return Release generation of objects of this type
+     \note The release generation is odd if some object of this type has lost its last
+     reference since the last call to acknowledge_releases(), and even otherwise
+     \note thread-safe
+     */
+    static inline unsigned long release_generation()
+    {
+      return _release_generation.load(std::memory_order_seq_cst);
+    }
+    
+    /*!
+     \brief Acknowledge releases of last references
+     \post The release generation is even
+     \return The release generation
+     \note Every object of this type that has lost its last reference before the release
+     generation has been made even has a reference counter with value 0 from the point of view
+     of the calling thread. Hence, collectors (see tchecker::pool_t::collect()) can skip scanning
+     their objects as long as the release generation is even and unchanged
+     \note thread-safe
+     */
+    static unsigned long acknowledge_releases()
+    {
+      unsigned long generation = _release_generation.load(std::memory_order_seq_cst);
+      while (generation & 1) {
+        if (_release_generation.compare_exchange_weak(generation, generation + 1, std::memory_order_seq_cst)) {
+          ++generation;
+          break;
+        }
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return generation;
     }
     
     /*!
      \brief Accessor
      \return The value of the reference counter
      */
-    inline constexpr std::size_t refcount(void) const
+    inline std::size_t refcount(void) const
     {
-      return *( refcount_addr() );
+      return atomic_refcount_addr()->load(std::memory_order_acquire);
     }
   private:
     /*!
@@ -204,8 +252,7 @@ namespace tchecker {
     make_shared_t(ARGS && ... args) : T(std::forward<ARGS>(args)...)
     {
       // initialize reference counter to REFCOUNT_MAX (allocated object)
-      refcount_t * const refcount = refcount_addr();
-      *refcount = REFCOUNT_MAX;   // yet no reference to this (GC protection)
+      atomic_refcount_addr()->store(REFCOUNT_MAX, std::memory_order_release);  // yet no reference to this (GC protection)
     }
     
     /*!
@@ -216,8 +263,7 @@ namespace tchecker {
     make_shared_t(make_shared_t<T, REFCOUNT, RESERVED> const & shared) : T(shared)
     {
       // initialize reference counter to REFCOUNT_MAX (allocated object)
-      refcount_t * const refcount = refcount_addr();
-      *refcount = REFCOUNT_MAX;   // yet no reference to this (GC protection)
+      atomic_refcount_addr()->store(REFCOUNT_MAX, std::memory_order_release);  // yet no reference to this (GC protection)
     }
     
     /*!
@@ -233,6 +279,21 @@ namespace tchecker {
     {
       return (reinterpret_cast<refcount_t *>(const_cast<tchecker::make_shared_t<T> *>(this)) - 1);
     }
+    
+    /*!
+     \brief Accessor
+     \return The address of the reference counter, viewed as an atomic counter
+     \note the reference counter is stored in raw memory in front of the object
+     (see tchecker::pool_t), hence the atomic view must have the same layout
+     */
+    inline std::atomic<refcount_t> * atomic_refcount_addr() const
+    {
+      static_assert(sizeof(std::atomic<refcount_t>) == sizeof(refcount_t), "atomic reference counter layout");
+      static_assert(alignof(std::atomic<refcount_t>) == alignof(refcount_t), "atomic reference counter alignment");
+      return reinterpret_cast<std::atomic<refcount_t> *>(refcount_addr());
+    }
+    
+    static inline std::atomic<unsigned long> _release_generation{0};  /*!< Release generation (see release_generation()) */
   };
   
   
@@ -90,9 +90,12 @@ namespace tchecker {
     /*!
      \brief Collection
      \post Does nothing
+     \return 0 (number of collected objects)
      */
-    void collect()
-    {}
+    std::size_t collect()
+    {
+      return 0;
+    }
     
     /*!
      \brief Destruct all allocated objects
@@ -121,7 +124,7 @@ namespace tchecker {
      */
     void enroll(tchecker::gc_t & gc)
     {
-      gc.enroll( [&] () { this->collect(); } );
+      gc.enroll( [&] () { return this->collect(); }, [] () { return std::size_t(0); } );
     }
   private:
     T * _t;   /*!< Singleton allocated object */
@@ -21,6 +21,8 @@ namespace tchecker {
   /*!
    \class spinlock_t
    \brief Spin lock
+   \note Waiting threads back off exponentially, then yield, in order to limit
+   contention on the lock
    */
   class spinlock_t {
   public:
@@ -65,7 +67,9 @@ namespace tchecker {
      */
     inline void lock()
     {
-      while ( _flag.test_and_set(std::memory_order_acquire) ) ;
+      unsigned int round = 0;
+      while ( _flag.test_and_set(std::memory_order_acquire) )
+        backoff(round);
     }
     
     /*!
@@ -77,6 +81,31 @@ namespace tchecker {
       _flag.clear(std::memory_order_release);
     }
   protected:
+    /*!
+     \brief Maximal number of busy-waiting rounds before yielding
+     */
+    static constexpr unsigned int MAX_SPIN_ROUNDS = 6;
+    
+    /*!
+     \brief Back off after a failed attempt to acquire the lock
+     \param round : number of failed attempts so far
+     \post busy-waited 2^round pauses and incremented round if round < MAX_SPIN_ROUNDS,
+     yielded otherwise
+     */
+    static inline void backoff(unsigned int & round)
+    {
+      if (round < MAX_SPIN_ROUNDS) {
+        for (unsigned int i = 0; i < (1u << round); ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+          __builtin_ia32_pause();
+#endif
+        }
+        ++round;
+      }
+      else
+        std::this_thread::yield();
+    }
+    
     std::atomic_flag _flag;               /*!< Atomic flag (lock) */
   };
   
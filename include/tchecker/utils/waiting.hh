@@ -8,9 +8,20 @@
 #ifndef TCHECKER_WAITING_HH
 #define TCHECKER_WAITING_HH
 
+#include <atomic>
+#include <cassert>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <stack>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/utils/spinlock.hh"
 
 /*!
  \file waiting.hh
@@ -181,6 +192,111 @@ namespace tchecker {
   
   
   
+  /*!
+   \class priority_waiting_t
+   \brief Waiting container with a priority policy (binary heap)
+   \tparam T : type of waiting elements
+   \tparam PRIORITY : type of priority function, should be callable on T const & and return a totally ordered
+   value
+   \note elements with smallest priority come first. Elements with same priority follow a Last-In-First-Out
+   policy. The priority of an element is computed once, when it is inserted
+   */
+  template <class T, class PRIORITY>
+  class priority_waiting_t {
+  public:
+    /*!
+     \brief Type of waiting element
+     */
+    using element_t = T;
+    
+    /*!
+     \brief Type of priority function
+     */
+    using priority_t = PRIORITY;
+    
+    /*!
+     \brief Type of priority values
+     */
+    using priority_value_t = std::invoke_result_t<PRIORITY &, T const &>;
+    
+    /*!
+     \brief Constructor
+     \param priority : priority function
+     */
+    explicit priority_waiting_t(PRIORITY const & priority) : _priority(priority), _inserted(0)
+    {}
+    
+    /*!
+     \brief Accessor
+     \return true if the container is empty, false otherwise
+     */
+    inline bool empty() const
+    {
+      return _heap.empty();
+    }
+    
+    /*!
+     \brief Insert
+     \param t : element
+     \post t has been inserted in the heap with its priority
+     */
+    inline void insert(T const & t)
+    {
+      _heap.push(entry_t{_priority(t), _inserted++, t});
+    }
+    
+    /*!
+     \brief Remove first element
+     \pre not empty()
+     \post the element with smallest priority, that has been inserted last, has been removed from the heap
+     */
+    inline void remove_first()
+    {
+      _heap.pop();
+    }
+    
+    /*!
+     \brief Accessor
+     \pre not empty()
+     \return element with smallest priority that has been inserted last
+     */
+    inline T const & first() const
+    {
+      return _heap.top().element;
+    }
+  private:
+    /*!
+     \brief Type of heap entries
+     */
+    struct entry_t {
+      priority_value_t priority;    /*!< Priority of element */
+      unsigned long long rank;      /*!< Insertion rank of element */
+      T element;                    /*!< Element */
+    };
+    
+    /*!
+     \brief Ordering on heap entries: the top of the heap is the entry with smallest priority, and biggest
+     insertion rank among them
+     */
+    struct entry_lt_t {
+      bool operator() (entry_t const & e1, entry_t const & e2) const
+      {
+        if (e1.priority < e2.priority)
+          return false;
+        if (e2.priority < e1.priority)
+          return true;
+        return (e1.rank < e2.rank);
+      }
+    };
+    
+    PRIORITY _priority;                                                     /*!< Priority function */
+    unsigned long long _inserted;                                           /*!< Number of inserted elements */
+    std::priority_queue<entry_t, std::vector<entry_t>, entry_lt_t> _heap;   /*!< Heap of waiting elements */
+  };
+  
+  
+  
+  
   /*!
    \class filter_waiting_t
    \brief Waiting container with filtering
@@ -296,6 +412,226 @@ namespace tchecker {
     filter_t _filter;  /*!< Filter */
   };
   
+  
+  
+  
+  /*!
+   \class work_stealing_waiting_t
+   \brief Waiting container shared by several workers, with work stealing
+   \tparam T : type of waiting elements
+   \note each worker has its own double-ended queue. A worker inserts elements at the back of its own queue,
+   and takes elements from its own queue w.r.t. the policy of this container: at the back with policy LIFO
+   (DFS-like bias), at the front with policy FIFO (BFS-like bias). A worker with an empty queue steals the
+   oldest element (front) of the queue of another worker.
+   \note each queue is protected by its own lock, hence workers do not contend unless they steal. Elements are
+   not required to be trivially copyable (e.g. reference-counted pointers)
+   \note elements that do not satisfy the filter are discarded when they are taken, as in
+   tchecker::filter_waiting_t. This allows to remove elements lazily
+   \note termination is detected by counting pending elements: an element is pending from its insertion until
+   the worker that has taken it calls done() (or until it is discarded by the filter). The exploration is over
+   when no element is pending, since no worker can insert new elements
+   */
+  template <class T>
+  class work_stealing_waiting_t {
+  public:
+    /*!
+     \brief Type of waiting element
+     */
+    using element_t = T;
+    
+    /*!
+     \brief Type of filter
+     */
+    using filter_t = std::function<bool(element_t const &)>;
+    
+    /*!
+     \brief Type of policy
+     */
+    enum policy_t {
+      LIFO,   /*!< Last-In-First-Out on local queue (DFS-like) */
+      FIFO,   /*!< First-In-First-Out on local queue (BFS-like) */
+    };
+    
+    /*!
+     \brief Constructor
+     \param workers : number of workers
+     \param policy : policy on local queues
+     \param filter : a filter
+     \pre workers > 0
+     \post this container has one empty queue per worker and no pending element
+     \throw std::invalid_argument : if workers is 0
+     */
+    work_stealing_waiting_t(std::size_t workers, enum policy_t policy,
+                            filter_t filter = [] (element_t const &) { return true; })
+    : _workers(workers),
+    _policy(policy),
+    _filter(std::move(filter)),
+    _queues(new queue_t[workers]),
+    _pending(0),
+    _stopped(false)
+    {
+      if (workers == 0)
+        throw std::invalid_argument("expecting a positive number of workers");
+    }
+    
+    /*!
+     \brief Copy constructor (deleted)
+     */
+    work_stealing_waiting_t(tchecker::work_stealing_waiting_t<T> const &) = delete;
+    
+    /*!
+     \brief Move constructor (deleted)
+     */
+    work_stealing_waiting_t(tchecker::work_stealing_waiting_t<T> &&) = delete;
+    
+    /*!
+     \brief Destructor
+     */
+    ~work_stealing_waiting_t() = default;
+    
+    /*!
+     \brief Assignment operator (deleted)
+     */
+    tchecker::work_stealing_waiting_t<T> & operator= (tchecker::work_stealing_waiting_t<T> const &) = delete;
+    
+    /*!
+     \brief Move-assignment operator (deleted)
+     */
+    tchecker::work_stealing_waiting_t<T> & operator= (tchecker::work_stealing_waiting_t<T> &&) = delete;
+    
+    /*!
+     \brief Accessor
+     \return number of workers
+     */
+    inline std::size_t workers() const
+    {
+      return _workers;
+    }
+    
+    /*!
+     \brief Insert
+     \param worker : a worker
+     \param t : element
+     \pre worker < workers() (checked by assertion)
+     \post t has been inserted at the back of the queue of worker if t satisfies the filter, and t is pending
+     */
+    void insert(std::size_t worker, T const & t)
+    {
+      assert(worker < _workers);
+      if (! _filter(t))
+        return;
+      _pending.fetch_add(1, std::memory_order_relaxed);
+      queue_t & q = _queues[worker];
+      std::lock_guard<tchecker::spinlock_t> lock(q._lock);
+      q._elements.push_back(t);
+    }
+    
+    /*!
+     \brief Take an element
+     \param worker : a worker
+     \param t : an element
+     \pre worker < workers() (checked by assertion)
+     \post t is an element that satisfies the filter, taken from the queue of worker according to the policy of
+     this container if it is not empty, or stolen from the queue of another worker otherwise. Blocks until some
+     element is available, or until no element is pending, or until this container has been stopped
+     \return true if an element has been taken, false if no element is pending or if this container has been
+     stopped
+     \note every successful call should be followed by a call to done() once t has been processed
+     */
+    bool take(std::size_t worker, T & t)
+    {
+      assert(worker < _workers);
+      while (! _stopped.load(std::memory_order_acquire)) {
+        if (pop(_queues[worker], (_policy == LIFO), t))
+          return true;
+        for (std::size_t i = 1; i < _workers; ++i)
+          if (pop(_queues[(worker + i) % _workers], false, t))
+            return true;
+        if (_pending.load(std::memory_order_acquire) == 0)
+          return false;
+        std::this_thread::yield();
+      }
+      return false;
+    }
+    
+    /*!
+     \brief Signal a processed element
+     \pre the calling worker has taken an element, and it has inserted all the elements produced from it
+     \post the element taken by the calling worker is not pending anymore
+     */
+    void done()
+    {
+      assert(_pending.load() > 0);
+      _pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    
+    /*!
+     \brief Stop
+     \post all subsequent calls to take() return false
+     */
+    void stop()
+    {
+      _stopped.store(true, std::memory_order_release);
+    }
+    
+    /*!
+     \brief Clear
+     \post all queues are empty, and no element is pending
+     \note not thread-safe
+     */
+    void clear()
+    {
+      for (std::size_t i = 0; i < _workers; ++i)
+        _queues[i]._elements.clear();
+      _pending.store(0);
+    }
+  private:
+    /*!
+     \brief Type of queue of a worker
+     \note aligned to avoid false sharing between workers
+     */
+    struct alignas(64) queue_t {
+      tchecker::spinlock_t _lock;    /*!< Lock on queue */
+      std::deque<T> _elements;       /*!< Elements */
+    };
+    
+    /*!
+     \brief Pop an element
+     \param q : a queue
+     \param back : back/front flag
+     \param t : an element
+     \post the elements that do not satisfy the filter have been removed from q (at its back if back is true,
+     at its front otherwise) and are not pending anymore. Then, t is the first element in q that satisfies the
+     filter, which has been removed from q, if any
+     \return true if an element has been taken from q, false otherwise
+     */
+    bool pop(queue_t & q, bool back, T & t)
+    {
+      std::lock_guard<tchecker::spinlock_t> lock(q._lock);
+      while (! q._elements.empty()) {
+        if (back) {
+          t = std::move(q._elements.back());
+          q._elements.pop_back();
+        }
+        else {
+          t = std::move(q._elements.front());
+          q._elements.pop_front();
+        }
+        if (_filter(t))
+          return true;
+        _pending.fetch_sub(1, std::memory_order_acq_rel);
+      }
+      return false;
+    }
+    
+    std::size_t const _workers;            /*!< Number of workers */
+    enum policy_t const _policy;           /*!< Policy on local queues */
+    filter_t _filter;                      /*!< Filter */
+    std::unique_ptr<queue_t[]> _queues;    /*!< Queues (one per worker) */
+    std::atomic<std::size_t> _pending;     /*!< Number of pending elements */
+    std::atomic<bool> _stopped;            /*!< Stop flag */
+  };
+  
 } // end of namespace tchecker
 
 #endif // TCHECKER_WAITING_HH
@@ -10,6 +10,8 @@
 
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -321,6 +323,115 @@ namespace tchecker {
   
   
   
+  /*!
+   \class intvars_packing_t
+   \brief Bit-packed layout of integer variables valuations
+   \note Each flat variable with domain [min,max] is stored as its value minus min, on the number of bits needed to
+   represent max-min (no bit for a variable with a single value). A variable never spans two cells. Packed valuations
+   are stored in instances of tchecker::intvars_valuation_t of size packed_size(), and unused bits are 0. Hence two
+   valuations are equal iff their packed valuations are equal, and hashing applies to packed valuations as well
+   */
+  class intvars_packing_t {
+  public:
+    /*!
+     \brief Constructor
+     \param intvars : flat integer variables
+     \post this is the packed layout of valuations of intvars
+     */
+    explicit intvars_packing_t(tchecker::flat_integer_variables_t const & intvars);
+    
+    /*!
+     \brief Copy constructor
+     */
+    intvars_packing_t(tchecker::intvars_packing_t const &) = default;
+    
+    /*!
+     \brief Move constructor
+     */
+    intvars_packing_t(tchecker::intvars_packing_t &&) = default;
+    
+    /*!
+     \brief Destructor
+     */
+    ~intvars_packing_t() = default;
+    
+    /*!
+     \brief Assignment operator
+     */
+    tchecker::intvars_packing_t & operator= (tchecker::intvars_packing_t const &) = default;
+    
+    /*!
+     \brief Move-assignment operator
+     */
+    tchecker::intvars_packing_t & operator= (tchecker::intvars_packing_t &&) = default;
+    
+    /*!
+     \brief Accessor
+     \return Number of flat variables
+     */
+    inline std::size_t size() const
+    {
+      return _fields.size();
+    }
+    
+    /*!
+     \brief Accessor
+     \return Number of cells of packed valuations
+     */
+    inline std::size_t packed_size() const
+    {
+      return _packed_size;
+    }
+    
+    /*!
+     \brief Pack a valuation
+     \param intvars_val : integer variables valuation
+     \param packed : packed valuation
+     \pre intvars_val has size at least size(), and packed has size at least packed_size()
+     \post packed is the packed valuation corresponding to intvars_val
+     \throw std::invalid_argument : if the precondition is violated
+     \throw std::out_of_range : if a value in intvars_val does not belong to the domain of its variable
+     */
+    void pack(tchecker::intvars_valuation_t const & intvars_val, tchecker::intvars_valuation_t & packed) const;
+    
+    /*!
+     \brief Unpack a valuation
+     \param packed : packed valuation
+     \param intvars_val : integer variables valuation
+     \pre packed has size at least packed_size(), and intvars_val has size at least size()
+     \post intvars_val is the valuation corresponding to packed
+     \throw std::invalid_argument : if the precondition is violated
+     */
+    void unpack(tchecker::intvars_valuation_t const & packed, tchecker::intvars_valuation_t & intvars_val) const;
+  private:
+    /*!
+     \brief Type of cells of packed valuations
+     */
+    using cell_t = std::make_unsigned<tchecker::integer_t>::type;
+    
+    /*!
+     \brief Number of bits in a cell
+     */
+    static constexpr unsigned int CELL_BITS = 8 * sizeof(cell_t);
+    
+    /*!
+     \brief Position of a variable in packed valuations
+     */
+    struct field_t {
+      std::size_t _cell;              /*!< Cell of the variable */
+      unsigned int _shift;            /*!< Position of the variable in its cell */
+      cell_t _mask;                   /*!< Mask of the variable (before shift) */
+      cell_t _range;                  /*!< Maximal value minus minimal value of the variable */
+      tchecker::integer_t _min;       /*!< Minimal value of the variable */
+    };
+    
+    std::vector<field_t> _fields;     /*!< Position of variables (indexed by variable ID) */
+    std::size_t _packed_size;         /*!< Number of cells of packed valuations */
+  };
+  
+  
+  
+  
   /*!
    \brief Output integer variables valuation
    \param os : output stream
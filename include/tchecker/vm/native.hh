@@ -0,0 +1,178 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_VM_NATIVE_HH
+#define TCHECKER_VM_NATIVE_HH
+
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/vm.hh"
+
+/*!
+ \file native.hh
+ \brief Native code for VM's bytecode
+ */
+
+namespace tchecker {
+
+  /*!
+   \class native_code_t
+   \brief Native code for a sequence of bytecodes
+   \note each bytecode is translated to a C++ function. The functions are
+   gathered in a translation unit that is compiled to a shared library by the
+   system compiler, and then loaded with dlopen. Shared libraries are cached
+   on disk, keyed by a hash of the bytecodes, hence later runs on the same
+   model load the library without generating nor compiling code
+   */
+  class native_code_t {
+  public:
+    /*!
+     \brief Type of clock constraint emitters: emitter(clkconstr, id1, id2, cmp, value)
+     pushes constraint id1 - id2 # value into clock constraint container clkconstr,
+     where # is < if cmp is 0, and <= otherwise
+     */
+    using clkconstr_emitter_t = void (*)(void *, tchecker::clock_id_t, tchecker::clock_id_t, int, tchecker::integer_t);
+
+    /*!
+     \brief Type of clock reset emitters: emitter(clkreset, id1, id2, value) pushes
+     reset id1 := id2 + value into clock reset container clkreset
+     */
+    using clkreset_emitter_t = void (*)(void *, tchecker::clock_id_t, tchecker::clock_id_t, tchecker::integer_t);
+
+    /*!
+     \brief Emitters passed to native functions
+     */
+    struct emitters_t {
+      clkconstr_emitter_t clkconstr;   /*!< Clock constraints emitter */
+      clkreset_emitter_t clkreset;     /*!< Clock resets emitter */
+    };
+
+    /*!
+     \brief Type of native functions: f(intvars, clkconstr, clkreset, emitters, result)
+     \note f computes the same as tchecker::vm_t::run on its bytecode: it updates
+     intvars, and emits clock constraints into clkconstr and clock resets into
+     clkreset using emitters. It returns 0 and sets result to the computed value on
+     success, and it returns a non-zero value on out-of-bounds value (see
+     instruction VM_FAILNOTIN)
+     */
+    using function_t = int (*)(tchecker::integer_t *, void *, void *, emitters_t const *, tchecker::integer_t *);
+
+    /*!
+     \brief Constructor
+     \param bytecodes : sequence of bytecodes
+     \param cache_dir : directory of cached shared libraries
+     \pre every bytecode in bytecodes has been checked by tchecker::check_bytecode
+     \post the shared library for bytecodes has been loaded, from cache_dir if
+     available, or after generation and compilation into cache_dir otherwise.
+     The system compiler is the compiler TChecker has been built with, unless
+     environment variable TCHECKER_CXX is set
+     \throw std::runtime_error : if cache_dir cannot be created, if the generated code
+     cannot be compiled, or if the shared library cannot be loaded
+     */
+    native_code_t(std::vector<tchecker::bytecode_t const *> const & bytecodes, std::string const & cache_dir);
+
+    /*!
+     \brief Copy constructor (deleted)
+     */
+    native_code_t(tchecker::native_code_t const &) = delete;
+
+    /*!
+     \brief Move constructor (deleted)
+     */
+    native_code_t(tchecker::native_code_t &&) = delete;
+
+    /*!
+     \brief Destructor
+     \post the shared library has been unloaded
+     */
+    ~native_code_t();
+
+    /*!
+     \brief Assignment operator (deleted)
+     */
+    tchecker::native_code_t & operator= (tchecker::native_code_t const &) = delete;
+
+    /*!
+     \brief Move-assignment operator (deleted)
+     */
+    tchecker::native_code_t & operator= (tchecker::native_code_t &&) = delete;
+
+    /*!
+     \brief Accessor
+     \param i : index of a bytecode
+     \pre i is less than the number of bytecodes given to the constructor (checked by assertion)
+     \return native function for the i-th bytecode
+     */
+    inline function_t function(std::size_t i) const
+    {
+      assert(i < _functions.size());
+      return _functions[i];
+    }
+
+    /*!
+     \brief Accessor
+     \return true if the shared library has been loaded from the cache, false if it has been compiled
+     */
+    inline bool cached() const
+    {
+      return _cached;
+    }
+
+    /*!
+     \brief Run native function
+     \param f : native function
+     \param intvars_val : valuation of integer variables
+     \param clkconstr : container of clock constraints
+     \param clkreset : container of clock resets
+     \return same as tchecker::vm_t::run on the bytecode of f
+     \post same as tchecker::vm_t::run on the bytecode of f
+     \throw std::out_of_range : if out-of-bound array access or out-of-bound value
+     */
+    static inline tchecker::integer_t run(function_t f,
+                                          tchecker::intvars_valuation_t & intvars_val,
+                                          tchecker::clock_constraint_container_t & clkconstr,
+                                          tchecker::clock_reset_container_t & clkreset)
+    {
+      tchecker::integer_t result = 0;
+      if (f(intvars_val.ptr(), &clkconstr, &clkreset, &_emitters, &result) != 0)
+        throw std::out_of_range("out-of-bounds value");
+      return result;
+    }
+
+    /*!
+     \brief Code generation
+     \param os : output stream
+     \param bytecodes : sequence of bytecodes
+     \pre every bytecode in bytecodes has been checked by tchecker::check_bytecode
+     \post a C++ translation unit that defines array of native functions
+     tchecker_native_functions (one per bytecode in bytecodes, in the same order) has
+     been output to os
+     \return os after output
+     */
+    static std::ostream & generate(std::ostream & os, std::vector<tchecker::bytecode_t const *> const & bytecodes);
+  private:
+    static_assert(std::is_same<tchecker::clock_id_t, std::uint32_t>::value, "generated code assumes 32 bits clock IDs");
+
+    static emitters_t const _emitters;      /*!< Emitters to TChecker containers */
+
+    void * _handle;                         /*!< Handle of the shared library */
+    std::vector<function_t> _functions;     /*!< Native functions */
+    bool _cached;                           /*!< Shared library loaded from cache */
+  };
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_NATIVE_HH
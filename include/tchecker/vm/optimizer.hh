@@ -0,0 +1,42 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_VM_OPTIMIZER_HH
+#define TCHECKER_VM_OPTIMIZER_HH
+
+#include <vector>
+
+#include "tchecker/vm/vm.hh"
+
+
+/*!
+ \file optimizer.hh
+ \brief Peephole optimizer for VM's bytecode
+ */
+
+namespace tchecker {
+  
+  /*!
+   \brief Bytecode optimizer
+   \param bytecode : sequence of bytecode instructions
+   \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+   (i.e. instructions have the expected parameters)
+   \post bytecode has been rewritten into an equivalent sequence of instructions:
+   - operations on constants have been folded
+   - VM_FAILNOTIN on constants within bounds, VM_RETZ on non-zero constants,
+   repeated VM_RETZ and VM_NOP have been removed
+   - accesses to variables with constant IDs have been fused into superinstructions
+   (VM_VALUEOF, VM_EQVC, ..., VM_GTVC, VM_ASSIGNVC, VM_CLKCONSTRC, VM_CLKRESETC)
+   \throw std::invalid_argument : if bytecode contains an unknown instruction
+   \note operations that overflow or divide by zero are not folded, hence the
+   optimized bytecode fails exactly when bytecode fails
+   */
+  void optimize(std::vector<tchecker::bytecode_t> & bytecode);
+  
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_OPTIMIZER_HH
@@ -13,6 +13,8 @@
 #include <exception>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "tchecker/basictypes.hh"
@@ -60,6 +62,20 @@ namespace tchecker {
     //                                                         s is a parameter of VM_CLKCONSTR (strictness)
     VM_CLKRESET,     // stack = v1 ... vK-3                    output (vK-2 vK-1 vK)
     //
+    // superinstructions (see tchecker::optimize)
+    VM_VALUEOF,      // stack = v1 ... vK [x]                 where x is a parameter of VM_VALUEOF
+    VM_EQVC,         // stack = v1 ... vK ([x] == c)          where x and c are parameters of VM_EQVC
+    VM_NEVC,         // stack = v1 ... vK ([x] != c)          where x and c are parameters of VM_NEVC
+    VM_LTVC,         // stack = v1 ... vK ([x] < c)           where x and c are parameters of VM_LTVC
+    VM_LEVC,         // stack = v1 ... vK ([x] <= c)          where x and c are parameters of VM_LEVC
+    VM_GEVC,         // stack = v1 ... vK ([x] >= c)          where x and c are parameters of VM_GEVC
+    VM_GTVC,         // stack = v1 ... vK ([x] > c)           where x and c are parameters of VM_GTVC
+    VM_ASSIGNVC,     // stack = v1 ... vK                     [x] = c where x and c are parameters of VM_ASSIGNVC
+    VM_CLKCONSTRC,   // stack = v1 ... vK 1                   output (x1 x2 s c) where x1 x2 c s are parameters of
+    //                                                         VM_CLKCONSTRC
+    VM_CLKRESETC,    // stack = v1 ... vK                     output (x1 x2 c) where x1 x2 c are parameters of
+    //                                                         VM_CLKRESETC
+    //
     VM_NOP,          // SHOULD BE LAST INSTRUCTION
   };
   
@@ -97,6 +113,15 @@ namespace tchecker {
                 "tchecker::bytecode_t should contain tchecker::clock_id_t");
   
   
+  /*!
+   \brief Accessor
+   \param instruction : an instruction
+   \return number of parameters of instruction
+   \throw std::invalid_argument : if instruction is unknown
+   */
+  std::size_t instruction_parameters_count(tchecker::bytecode_t instruction);
+  
+  
   /*!
    \brief Output
    \param os : output stream
@@ -112,28 +137,59 @@ namespace tchecker {
   
   
   
+  /*!
+   \brief Static check of bytecode
+   \param bytecode : sequence of bytecode intructions
+   \param flat_intvars_size : number of flat bounded integer variables
+   \param flat_clocks_size : number of flat clock variables
+   \pre bytecode is null-terminated (i.e. RET terminated)
+   \return maximal size of the stack needed to interpret bytecode
+   \throw std::invalid_argument : if bytecode is ill-formed (unknown instruction, stack underflow, non-empty
+   stack on return, parameter that cannot be represented by tchecker::integer_t), or if some access to an
+   integer variable (resp. a clock) cannot be proved within 0..flat_intvars_size-1 (resp. 0..flat_clocks_size-1)
+   \note this is an interval analysis of the values on the stack. Array offsets are bounded by VM_FAILNOTIN,
+   hence all accesses to variables in the bytecode output by tchecker::compile are proved within bounds
+   */
+  std::size_t check_bytecode(tchecker::bytecode_t const * bytecode,
+                             std::size_t flat_intvars_size,
+                             std::size_t flat_clocks_size);
+  
+  
+  
+  
   // Virtual machine (VM)
   
   /*!
    \class vm_t
    \brief Virtual machine for bytecode interpretation
+   \note bytecode is checked once and for all by tchecker::check_bytecode, which allows the interpreter to run
+   on a preallocated stack without checking stack bounds, variable IDs and values at each instruction
+   \note instructions are dispatched using computed gotos when the compiler supports them (direct threading),
+   and using a switch statement otherwise
    */
   class vm_t {
   public:
     /*!
      \brief Constructor
-     \param vm_variables : virtual machine variables
+     \param flat_intvars_size : number of flat bounded integer variables
+     \param flat_clocks_size : number of flat clock variables
+     \param stack_size : size of the stack
      */
-    vm_t(std::size_t flat_intvars_size, std::size_t flat_clocks_size)
-    : _flat_intvars_size(flat_intvars_size), _flat_clocks_size(flat_clocks_size)
+    vm_t(std::size_t flat_intvars_size, std::size_t flat_clocks_size, std::size_t stack_size)
+    : _flat_intvars_size(flat_intvars_size),
+    _flat_clocks_size(flat_clocks_size),
+    _stack_size(stack_size),
+    _stack(new tchecker::integer_t[stack_size])
     {}
     
     /*!
      \brief Copy constructor
      \param vm : virtual machine
-     \post this is a copy of vm
+     \post this is a copy of vm, with its own stack
      */
-    vm_t(tchecker::vm_t const & vm) = default;
+    vm_t(tchecker::vm_t const & vm)
+    : vm_t(vm._flat_intvars_size, vm._flat_clocks_size, vm._stack_size)
+    {}
     
     /*!
      \brief Move constructor
@@ -169,6 +225,15 @@ namespace tchecker {
       return (intvars_val.size() >= _flat_intvars_size);
     }
     
+    /*!
+     \brief Accessor
+     \return size of the stack
+     */
+    inline constexpr std::size_t stack_size() const
+    {
+      return _stack_size;
+    }
+    
     /*!
      \brief Bytecode interpreter
      \param bytecode : tchecker bytecode
@@ -176,423 +241,268 @@ namespace tchecker {
      \param clkconstr : container of clock constraints
      \param clkreset : container of clock resets
      \pre bytecode is null-terminated (i.e. VM_RET) and
-     intvars_val.size() <= intvars_layout_size
+     intvars_val.size() <= intvars_layout_size. bytecode has been checked by
+     tchecker::check_bytecode w.r.t. the sizes of variables in this VM, and
+     it needs at most stack_size() values on the stack (checked by assertion)
      \return value computed by the last instruction in bytecode
      \post bytecode has been executed: intvars_val has been updated, clock
      constraints have been pushed into clkconstr and clock resets have
      been pushed into clkreset
-     \throw std::runtime_error : if bytecode interpretation fails
      \throw std::invalid_argument : if the size of intvars_val is too small
      (precondition is violated)
-     \throw std::out_of_range : if access to inexisting variable or
-     out-of-bound array access
+     \throw std::out_of_range : if out-of-bound array access or out-of-bound
+     value (instruction VM_FAILNOTIN)
      */
     tchecker::integer_t run(tchecker::bytecode_t const * bytecode,
                             tchecker::intvars_valuation_t & intvars_val,
                             tchecker::clock_constraint_container_t & clkconstr,
                             tchecker::clock_reset_container_t & clkreset)
     {
-      assert( size() == 0 );    // stack should be empty
-      
       if ( intvars_val.capacity() > _flat_intvars_size )
         throw std::invalid_argument("intvars valuation is too large");
       
-      tchecker::integer_t eval = 0;
-      _return = false;
-      
-      do {
-        try {
-          eval = interpret_instruction(bytecode, intvars_val, clkconstr, clkreset);
-        }
-        catch (...) {
-          clear();
-          throw;
-        }
-        
-        ++bytecode;
-      }
-      while( _return == false );
+      // Stack = v1 ... vK where vK = sp[-1] is the top symbol
+      tchecker::integer_t * sp = _stack.get();
       
-      return eval;
-    }
-  protected:
-    // bytecode instructions interpretation
-    
-    /*!
-     \brief Single instruction interpreter
-     \param bytecode : tchecker bytecode
-     \param intvars_val : valuation of integer variables
-     \param clkconstr : container of clock constraints
-     \param clkreset : container of clock resets
-     \return computed value
-     \pre intvars_val.size() > max_intvar_id
-     \post the instruction pointed by bytecode has been interpreted, intvars_val
-     and the stack have been updated. All clock constraints have been pushed into
-     clkconstr and all clock resets have been pushed into clkreset
-     \throw std::runtime_error : if bytecode interpretation fails
-     \throw std::out_of_range : if access to inexisting variable or
-     out-of-bound array access
-     */
-    inline tchecker::integer_t interpret_instruction(tchecker::bytecode_t const * & bytecode,
-                                                     tchecker::intvars_valuation_t & intvars_val,
-                                                     tchecker::clock_constraint_container_t & clkconstr,
-                                                     tchecker::clock_reset_container_t & clkreset)
-    {
-      // Assume stack=v1 ... vK where vK is the top symbol
+#if defined(__GNUC__)
+      static void * const dispatch_table[] = {
+        &&vm_ret, &&vm_retz, &&vm_failnotin, &&vm_push, &&vm_valueat, &&vm_assign, &&vm_land, &&vm_minus,
+        &&vm_div, &&vm_eq, &&vm_ge, &&vm_gt, &&vm_lt, &&vm_le, &&vm_mul, &&vm_mod, &&vm_ne, &&vm_sum, &&vm_neg,
+        &&vm_lnot, &&vm_clkconstr, &&vm_clkreset, &&vm_valueof, &&vm_eqvc, &&vm_nevc, &&vm_ltvc, &&vm_levc,
+        &&vm_gevc, &&vm_gtvc, &&vm_assignvc, &&vm_clkconstrc, &&vm_clkresetc, &&vm_nop
+      };
+      static_assert(sizeof(dispatch_table) / sizeof(void *) == tchecker::VM_NOP + 1, "missing instruction");
+      
+#define TCHECKER_VM_DISPATCH(N)  bytecode += (N); goto * dispatch_table[*bytecode]
+#else
+#define TCHECKER_VM_DISPATCH(N)  bytecode += (N); goto vm_dispatch
+      
+    vm_dispatch:
       switch (*bytecode) {
-          // end of operation, return vK
-        case VM_RET:
-        {
-          auto val = top_and_pop<tchecker::integer_t>();
-          assert( size() == 0 );
-          clear();
-          _return = true;
-          return val;
-        }
-          
-          
-          // end of operation when vK==0, return 0
-        case VM_RETZ:
-        {
-          if (top<tchecker::integer_t>() == 0) {
-            clear();
-            _return = true;
-            return 0;
-          }
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // raise exception when not (l <= vK <= h) for parameters l and h
-          // of instruction VM_FAILNOTIN
-        case VM_FAILNOTIN:
-        {
-          tchecker::bytecode_t const l = * ++bytecode;
-          tchecker::bytecode_t const h = * ++bytecode;
-          auto const offset = top<tchecker::bytecode_t>();
-          assert( contains_value<tchecker::integer_t>(l) );
-          assert( contains_value<tchecker::integer_t>(h) );
-          assert( contains_value<tchecker::integer_t>(offset) );
-          if ( (offset < l) || (offset > h) )
-            throw std::out_of_range("out-of-bounds value");
-          
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK v   where v is a parameter of instruction VM_PUSH
-        case VM_PUSH:
-        {
-          tchecker::bytecode_t const v = * ++bytecode;
-          push<tchecker::bytecode_t>(v);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... [vK]   vK replaced by value at ID vK in intvars
-          // valuation
-        case VM_VALUEAT:
-        {
-          auto const id = top_and_pop<tchecker::intvar_id_t>();
-          if (id >= _flat_intvars_size)
-            throw std::out_of_range("invalid variable ID");
-          push<tchecker::integer_t>(intvars_val[id]);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // [vK-1] = vK, stack = v1 ... vK-2
-        case VM_ASSIGN:
-        {
-          auto const value = top_and_pop<tchecker::integer_t>();
-          auto const id = top_and_pop<tchecker::intvar_id_t>();
-          if (id >= _flat_intvars_size)
-            throw std::out_of_range("invalid variable ID");
-          intvars_val[id] = value;
-          return value;
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 && vK)
-        case VM_LAND:       				{
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left && right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 - vK)
-        case VM_MINUS:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left - right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 / vK)
-        case VM_DIV:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left / right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 == vK)
-        case VM_EQ:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left == right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 >= vK)
-        case VM_GE:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left >= right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 > vK)
-        case VM_GT:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left > right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 < vK)
-        case VM_LT:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left < right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 <= vK)
-        case VM_LE:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left <= right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 * vK)
-        case VM_MUL:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left * right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 % vK)
-        case VM_MOD:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left % right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 != vK)
-        case VM_NE:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left != right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-2 (vK-1 + vK)
-        case VM_SUM:
-        {
-          auto const right = top_and_pop<tchecker::integer_t>();
-          auto const left = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(left + right);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-1 (- vK)
-        case VM_NEG:
-        {
-          auto const v = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(- v);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // stack = v1 ... vK-1 (! vK)
-        case VM_LNOT:
-        {
-          auto const v = top_and_pop<tchecker::integer_t>();
-          push<tchecker::integer_t>(! v);
-          return top<tchecker::integer_t>();
-        }
-          
-          
-          // no-operation
-        case VM_NOP:
-          return 1;
-          
-          
-          // stack = v1 ... vK-4 1  output (vK-2 vK-1 s vK)   where s is a
-          // parameter of VM_CLKCONSTR (strictness)
-        case VM_CLKCONSTR:
-        {
-          tchecker::bytecode_t cmp =  * ++bytecode;
-          auto const bound = top_and_pop<tchecker::integer_t>();
-          auto const id2 = top_and_pop<tchecker::clock_id_t>();
-          auto const id1 = top_and_pop<tchecker::clock_id_t>();
-          if (id1 >= _flat_clocks_size)
-            throw std::out_of_range("invalid first clock ID");
-          if (id2 >= _flat_clocks_size)
-            throw std::out_of_range("invalid second clock ID");
-          static_assert(tchecker::clock_constraint_t::LT == 0, "");
-          clkconstr.emplace_back(id1, id2, (cmp == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE), bound);
-          return 1;
-        }
-          
-          
-          // stack = v1 ... vK-3    output (vK-2 vK-1 vK)
-        case VM_CLKRESET:
-        {
-          auto const value = top_and_pop<tchecker::integer_t>();
-          auto const right_id = top_and_pop<tchecker::clock_id_t>();
-          auto const left_id = top_and_pop<tchecker::clock_id_t>();
-          if (right_id >= _flat_clocks_size)
-            throw std::out_of_range("invalid first clock ID");
-          if (left_id >= _flat_clocks_size)
-            throw std::out_of_range("invalid second clock ID");
-          clkreset.emplace_back(left_id, right_id, value);
-          return 1;
-        }
+        case VM_RET:        goto vm_ret;
+        case VM_RETZ:       goto vm_retz;
+        case VM_FAILNOTIN:  goto vm_failnotin;
+        case VM_PUSH:       goto vm_push;
+        case VM_VALUEAT:    goto vm_valueat;
+        case VM_ASSIGN:     goto vm_assign;
+        case VM_LAND:       goto vm_land;
+        case VM_MINUS:      goto vm_minus;
+        case VM_DIV:        goto vm_div;
+        case VM_EQ:         goto vm_eq;
+        case VM_GE:         goto vm_ge;
+        case VM_GT:         goto vm_gt;
+        case VM_LT:         goto vm_lt;
+        case VM_LE:         goto vm_le;
+        case VM_MUL:        goto vm_mul;
+        case VM_MOD:        goto vm_mod;
+        case VM_NE:         goto vm_ne;
+        case VM_SUM:        goto vm_sum;
+        case VM_NEG:        goto vm_neg;
+        case VM_LNOT:       goto vm_lnot;
+        case VM_CLKCONSTR:  goto vm_clkconstr;
+        case VM_CLKRESET:   goto vm_clkreset;
+        case VM_VALUEOF:    goto vm_valueof;
+        case VM_EQVC:       goto vm_eqvc;
+        case VM_NEVC:       goto vm_nevc;
+        case VM_LTVC:       goto vm_ltvc;
+        case VM_LEVC:       goto vm_levc;
+        case VM_GEVC:       goto vm_gevc;
+        case VM_GTVC:       goto vm_gtvc;
+        case VM_ASSIGNVC:   goto vm_assignvc;
+        case VM_CLKCONSTRC: goto vm_clkconstrc;
+        case VM_CLKRESETC:  goto vm_clkresetc;
+        case VM_NOP:        goto vm_nop;
       }
-      
       // should never be reached
       throw std::runtime_error("incomplete switch statement");
-    }
-    
-    
-    
-    
-    // integer domain checking
-    
-    /*!
-     \brief Check integer type compatibility
-     \tparam EXPECTED : expected integer type
-     \tparam ACTUAL : actual integer type
-     \param val : actual value
-     \return true if val can be represented by type EXPECTED, false otherwise
-     */
-    template <class EXPECTED, class ACTUAL>
-    inline static bool contains_value(ACTUAL val)
-    {
-      static_assert(std::is_integral<EXPECTED>::value, "EXPECTED should be an integral type");
-      static_assert(std::is_integral<ACTUAL>::value, "ACTUAL should be an integral type");
+#endif
       
-      return ((val >= std::numeric_limits<EXPECTED>::min()) && (val <= std::numeric_limits<EXPECTED>::max()));
-    }
-    
-    
-    
-    
-    // stack operations
-    
-    /*!
-     \brief Accessor
-     \tparam T : type of value
-     \return top stack value casted to T
-     \pre the stack is not empty and the top value can be represented by type T
-     (checked by assertion)
-     */
-    template <class T>
-    inline T top()
-    {
-      assert( _stack.size() >= 1 );
-      tchecker::bytecode_t const val = _stack.back();
-      if ( ! contains_value<T>(val) )
-        throw std::runtime_error("value out-of-bounds");
-      return static_cast<T>(val);
-    }
-    
-    
-    /*!
-     \brief Accessor
-     \tparam T : type of value
-     \return top stack values casted to T
-     \pre see top()
-     \post the top value has been popped
-     */
-    template <class T>
-    inline T top_and_pop()
-    {
-      T t = top<T>();
-      _stack.pop_back();
-      return t;
-    }
-    
-    
-    /*!
-     \brief Push a value to the stack
-     \tparam T : type of value
-     \param t : value
-     \pre t can be represented by tchecker::bytecode_t (checked by assertion)
-     \post t has been pushed on the stack
-     */
-    template <class T>
-    inline void push(T t)
-    {
-      if ( ! contains_value<tchecker::bytecode_t>(t) )
-        throw std::runtime_error("value out-of-bounds");
-      _stack.push_back(t);
-    }
-    
-    
-    /*!
-     \brief Clear the stack
-     \post the stack is empty
-     */
-    inline void clear()
-    {
-      _stack.clear();
-    }
-    
-    
-    /*!
-     \brief Accessor
-     \return size of the stack
-     */
-    inline std::size_t size() const
-    {
-      return _stack.size();
+#define TCHECKER_VM_BINARY(OP)  --sp; sp[-1] = (sp[-1] OP sp[0]); TCHECKER_VM_DISPATCH(1)
+#define TCHECKER_VM_COMPARE_VC(OP)                                                                         \
+assert( sp < _stack.get() + _stack_size );                                                                 \
+*sp++ = (intvars_val[static_cast<tchecker::intvar_id_t>(bytecode[1])] OP bytecode[2]);                     \
+TCHECKER_VM_DISPATCH(3)
+      
+      TCHECKER_VM_DISPATCH(0);
+      
+      // end of operation, return vK
+    vm_ret:
+      --sp;
+      assert( sp == _stack.get() );
+      return *sp;
+      
+      // end of operation when vK==0, return vK
+    vm_retz:
+      if (sp[-1] == 0)
+        return 0;
+      TCHECKER_VM_DISPATCH(1);
+      
+      // raise exception when not (l <= vK <= h) for parameters l and h
+      // of instruction VM_FAILNOTIN
+    vm_failnotin:
+      if ((sp[-1] < bytecode[1]) || (sp[-1] > bytecode[2]))
+        throw std::out_of_range("out-of-bounds value");
+      TCHECKER_VM_DISPATCH(3);
+      
+      // stack = v1 ... vK v   where v is a parameter of instruction VM_PUSH
+    vm_push:
+      assert( sp < _stack.get() + _stack_size );
+      *sp++ = static_cast<tchecker::integer_t>(bytecode[1]);
+      TCHECKER_VM_DISPATCH(2);
+      
+      // stack = v1 ... [vK]   vK replaced by value at ID vK in intvars
+      // valuation
+    vm_valueat:
+      sp[-1] = intvars_val[static_cast<tchecker::intvar_id_t>(sp[-1])];
+      TCHECKER_VM_DISPATCH(1);
+      
+      // [vK-1] = vK, stack = v1 ... vK-2
+    vm_assign:
+      sp -= 2;
+      intvars_val[static_cast<tchecker::intvar_id_t>(sp[0])] = sp[1];
+      TCHECKER_VM_DISPATCH(1);
+      
+      // stack = v1 ... vK-2 (vK-1 && vK)
+    vm_land:
+      TCHECKER_VM_BINARY(&&);
+      
+      // stack = v1 ... vK-2 (vK-1 - vK)
+    vm_minus:
+      TCHECKER_VM_BINARY(-);
+      
+      // stack = v1 ... vK-2 (vK-1 / vK)
+    vm_div:
+      TCHECKER_VM_BINARY(/);
+      
+      // stack = v1 ... vK-2 (vK-1 == vK)
+    vm_eq:
+      TCHECKER_VM_BINARY(==);
+      
+      // stack = v1 ... vK-2 (vK-1 >= vK)
+    vm_ge:
+      TCHECKER_VM_BINARY(>=);
+      
+      // stack = v1 ... vK-2 (vK-1 > vK)
+    vm_gt:
+      TCHECKER_VM_BINARY(>);
+      
+      // stack = v1 ... vK-2 (vK-1 < vK)
+    vm_lt:
+      TCHECKER_VM_BINARY(<);
+      
+      // stack = v1 ... vK-2 (vK-1 <= vK)
+    vm_le:
+      TCHECKER_VM_BINARY(<=);
+      
+      // stack = v1 ... vK-2 (vK-1 * vK)
+    vm_mul:
+      TCHECKER_VM_BINARY(*);
+      
+      // stack = v1 ... vK-2 (vK-1 % vK)
+    vm_mod:
+      TCHECKER_VM_BINARY(%);
+      
+      // stack = v1 ... vK-2 (vK-1 != vK)
+    vm_ne:
+      TCHECKER_VM_BINARY(!=);
+      
+      // stack = v1 ... vK-2 (vK-1 + vK)
+    vm_sum:
+      TCHECKER_VM_BINARY(+);
+      
+      // stack = v1 ... vK-1 (- vK)
+    vm_neg:
+      sp[-1] = - sp[-1];
+      TCHECKER_VM_DISPATCH(1);
+      
+      // stack = v1 ... vK-1 (! vK)
+    vm_lnot:
+      sp[-1] = ! sp[-1];
+      TCHECKER_VM_DISPATCH(1);
+      
+      // stack = v1 ... vK-3  output (vK-2 vK-1 s vK)   where s is a
+      // parameter of VM_CLKCONSTR (strictness)
+    vm_clkconstr:
+      sp -= 3;
+      clkconstr.emplace_back(static_cast<tchecker::clock_id_t>(sp[0]),
+                             static_cast<tchecker::clock_id_t>(sp[1]),
+                             (bytecode[1] == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE),
+                             sp[2]);
+      TCHECKER_VM_DISPATCH(2);
+      
+      // stack = v1 ... vK-3    output (vK-2 vK-1 vK)
+    vm_clkreset:
+      sp -= 3;
+      clkreset.emplace_back(static_cast<tchecker::clock_id_t>(sp[0]), static_cast<tchecker::clock_id_t>(sp[1]), sp[2]);
+      TCHECKER_VM_DISPATCH(1);
+      
+      // stack = v1 ... vK [x]   where x is a parameter of VM_VALUEOF
+    vm_valueof:
+      assert( sp < _stack.get() + _stack_size );
+      *sp++ = intvars_val[static_cast<tchecker::intvar_id_t>(bytecode[1])];
+      TCHECKER_VM_DISPATCH(2);
+      
+      // stack = v1 ... vK ([x] == c)   where x and c are parameters of VM_EQVC
+    vm_eqvc:
+      TCHECKER_VM_COMPARE_VC(==);
+      
+      // stack = v1 ... vK ([x] != c)   where x and c are parameters of VM_NEVC
+    vm_nevc:
+      TCHECKER_VM_COMPARE_VC(!=);
+      
+      // stack = v1 ... vK ([x] < c)   where x and c are parameters of VM_LTVC
+    vm_ltvc:
+      TCHECKER_VM_COMPARE_VC(<);
+      
+      // stack = v1 ... vK ([x] <= c)   where x and c are parameters of VM_LEVC
+    vm_levc:
+      TCHECKER_VM_COMPARE_VC(<=);
+      
+      // stack = v1 ... vK ([x] >= c)   where x and c are parameters of VM_GEVC
+    vm_gevc:
+      TCHECKER_VM_COMPARE_VC(>=);
+      
+      // stack = v1 ... vK ([x] > c)   where x and c are parameters of VM_GTVC
+    vm_gtvc:
+      TCHECKER_VM_COMPARE_VC(>);
+      
+      // [x] = c   where x and c are parameters of VM_ASSIGNVC
+    vm_assignvc:
+      intvars_val[static_cast<tchecker::intvar_id_t>(bytecode[1])] = static_cast<tchecker::integer_t>(bytecode[2]);
+      TCHECKER_VM_DISPATCH(3);
+      
+      // stack = v1 ... vK 1  output (x1 x2 s c)   where x1, x2, c and s are
+      // parameters of VM_CLKCONSTRC
+    vm_clkconstrc:
+      assert( sp < _stack.get() + _stack_size );
+      clkconstr.emplace_back(static_cast<tchecker::clock_id_t>(bytecode[1]),
+                             static_cast<tchecker::clock_id_t>(bytecode[2]),
+                             (bytecode[4] == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE),
+                             static_cast<tchecker::integer_t>(bytecode[3]));
+      *sp++ = 1;
+      TCHECKER_VM_DISPATCH(5);
+      
+      // output (x1 x2 c)   where x1, x2 and c are parameters of VM_CLKRESETC
+    vm_clkresetc:
+      clkreset.emplace_back(static_cast<tchecker::clock_id_t>(bytecode[1]),
+                            static_cast<tchecker::clock_id_t>(bytecode[2]),
+                            static_cast<tchecker::integer_t>(bytecode[3]));
+      TCHECKER_VM_DISPATCH(4);
+      
+      // no-operation
+    vm_nop:
+      TCHECKER_VM_DISPATCH(1);
+      
+#undef TCHECKER_VM_COMPARE_VC
+#undef TCHECKER_VM_BINARY
+#undef TCHECKER_VM_DISPATCH
     }
-    
-    
-    std::size_t const _flat_intvars_size;          /*!< Number of flat bounded integer variables */
-    std::size_t const _flat_clocks_size;           /*!< Number of flat clock variables */
-    bool _return;                                  /*!< Return flag */
-    std::vector<tchecker::bytecode_t> _stack;      /*!< Interpretation stack */
-    // NB: implemented as an std::vector for methods clear() and size()
+  protected:
+    std::size_t const _flat_intvars_size;                /*!< Number of flat bounded integer variables */
+    std::size_t const _flat_clocks_size;                 /*!< Number of flat clock variables */
+    std::size_t const _stack_size;                       /*!< Size of the stack */
+    std::unique_ptr<tchecker::integer_t[]> _stack;       /*!< Interpretation stack */
+    // NB: bytecode checked by tchecker::check_bytecode only pushes values that fit in tchecker::integer_t
   };
   
 } // end of namespace tchecker
@@ -8,6 +8,8 @@
 #ifndef TCHECKER_ZG_DETAILS_ALLOCATORS_HH
 #define TCHECKER_ZG_DETAILS_ALLOCATORS_HH
 
+#include <stdexcept>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/ta/details/allocators.hh"
 #include "tchecker/utils/pool.hh"
@@ -31,6 +33,14 @@ namespace tchecker {
        \tparam VLOC : type of tuple of locations
        \tparam INTVARS_VAL : type of integer variables valuations
        \tparam ZONE : type of zones
+       \note When zone sharing is enabled, states with equal zones share the same zone, see share(). As for tuples of
+       locations and integer variables valuations, shared zones are never modified since successor states are built
+       from a copy of the zone of their source state
+       \note When the flat layout is selected, each state is allocated in a single chunk that also stores its tuple
+       of locations, its integer variables valuation and its zone, right after the state. Hence, accessing the
+       components of a state does not jump to other pools. Components embedded in a chunk live as long as their state,
+       so they cannot be shared. Embedded components are not destructed: their destructors are trivial in effect
+       (arrays of locations pointers, of integers and of DBM entries)
        */
       template
       <class STATE,
@@ -80,6 +90,10 @@ namespace tchecker {
          \param intvars_val_capacity : capacity of allocated integer variables valuations
          \param zone_alloc_nb : number of zones allocated in one block
          \param zone_dimension : dimension of allocated zones
+         \param share_components : sharing flag for tuples of locations and integer variables valuations
+         \param share_zones : sharing flag for zones
+         \param flat_layout : flag for allocation of states with their components in a single chunk
+         \throw std::invalid_argument : if flat_layout is true and share_components or share_zones is true
          */
         state_pool_allocator_t(std::size_t state_alloc_nb,
                                std::size_t vloc_alloc_nb,
@@ -87,15 +101,33 @@ namespace tchecker {
                                std::size_t intvars_val_alloc_nb,
                                std::size_t intvars_val_capacity,
                                std::size_t zone_alloc_nb,
-                               tchecker::clock_id_t zone_dimension)
+                               tchecker::clock_id_t zone_dimension,
+                               bool share_components = false,
+                               bool share_zones = false,
+                               bool flat_layout = false)
         : tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>(state_alloc_nb,
                                                                                   vloc_alloc_nb,
                                                                                   vloc_capacity,
                                                                                   intvars_val_alloc_nb,
-                                                                                  intvars_val_capacity),
+                                                                                  intvars_val_capacity,
+                                                                                  share_components),
         _zone_dimension(zone_dimension),
-        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<ZONE>::alloc_size(_zone_dimension))
-        {}
+        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<ZONE>::alloc_size(_zone_dimension)),
+        _share_zones(share_zones),
+        _shared_zones(_zone_pool),
+        _zone_sharing_lookups(0),
+        _zone_sharing_hits(0),
+        _flat_layout(flat_layout),
+        _flat_vloc_offset(flat_block_size(tchecker::allocation_size_t<STATE>::alloc_size())),
+        _flat_intvars_val_offset(_flat_vloc_offset
+                                 + flat_block_size(tchecker::allocation_size_t<VLOC>::alloc_size(vloc_capacity))),
+        _flat_zone_offset(_flat_intvars_val_offset
+                          + flat_block_size(tchecker::allocation_size_t<INTVARS_VAL>::alloc_size(intvars_val_capacity))),
+        _flat_state_pool(state_alloc_nb, _flat_zone_offset + tchecker::allocation_size_t<ZONE>::alloc_size(zone_dimension))
+        {
+          if (flat_layout && (share_components || share_zones))
+            throw std::invalid_argument("flat layout of states is not compatible with sharing of components");
+        }
         
         /*!
          \brief Copy constructor (deleted)
@@ -136,6 +168,14 @@ namespace tchecker {
         template <class ... ARGS>
         tchecker::intrusive_shared_ptr_t<STATE> construct(ARGS && ... args)
         {
+          if (_flat_layout) {
+            tchecker::intrusive_shared_ptr_t<STATE> p = flat_construct(args...);
+            char * chunk = flat_chunk(p);
+            p->vloc_ptr() = flat_embed<VLOC>(chunk + _flat_vloc_offset, this->_vloc_capacity);
+            p->intvars_val_ptr() = flat_embed<INTVARS_VAL>(chunk + _flat_intvars_val_offset, this->_intvars_val_capacity);
+            p->zone_ptr() = flat_embed<ZONE>(chunk + _flat_zone_offset, _zone_dimension);
+            return p;
+          }
           return tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::construct
           (args..., _zone_pool.construct(_zone_dimension));
         }
@@ -149,10 +189,79 @@ namespace tchecker {
         template <class ... ARGS>
         tchecker::intrusive_shared_ptr_t<STATE> construct_from_state(STATE const & state, ARGS && ... args)
         {
+          if (_flat_layout) {
+            tchecker::intrusive_shared_ptr_t<STATE> p = flat_construct(args...);
+            char * chunk = flat_chunk(p);
+            p->vloc_ptr() = flat_embed<VLOC>(chunk + _flat_vloc_offset, state.vloc());
+            p->intvars_val_ptr() = flat_embed<INTVARS_VAL>(chunk + _flat_intvars_val_offset, state.intvars_valuation());
+            p->zone_ptr() = flat_embed<ZONE>(chunk + _flat_zone_offset, state.zone());
+            return p;
+          }
           return tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::construct_from_state
           (state, args..., _zone_pool.construct(state.zone()));
         }
         
+        /*!
+         \brief Share components of a state
+         \param state : a state
+         \pre state has been constructed by this allocator, and it will not be modified anymore
+         \post the tuple of locations and the integer variables valuation of state have been shared (see
+         tchecker::fsm::details::state_pool_allocator_t::share). If zone sharing is enabled, the zone of state has
+         been replaced by an equal shared zone if any, and it has been made shared otherwise. Does nothing if the flat
+         layout is selected
+         */
+        void share(STATE & state)
+        {
+          if (_flat_layout)
+            return;
+          tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::share(state);
+          if (! _share_zones)
+            return;
+          ++_zone_sharing_lookups;
+          _zone_sharing_hits += (_shared_zones.share(state.zone_ptr()) ? 1 : 0);
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of shared zones
+         */
+        inline std::size_t shared_zones_count() const
+        {
+          return _shared_zones.size();
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of zones looked up in the table of shared zones
+         */
+        inline std::size_t zone_sharing_lookups() const
+        {
+          return _zone_sharing_lookups;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Number of zones that have been replaced by an equal shared zone
+         */
+        inline std::size_t zone_sharing_hits() const
+        {
+          return _zone_sharing_hits;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Memory saved by sharing zones
+         */
+        inline std::size_t zone_saved_memsize() const
+        {
+          return _zone_sharing_hits * tchecker::allocation_size_t<ZONE>::alloc_size(_zone_dimension);
+        }
+        
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::shared_vlocs_count;
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::vloc_saved_memsize;
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::shared_intvars_vals_count;
+        using tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::intvars_val_saved_memsize;
+        
         /*!
          \brief Destruct state
          \param p : pointer to state
@@ -169,6 +278,9 @@ namespace tchecker {
           if (p.ptr() == nullptr)
             return false;
           
+          if (_flat_layout)
+            return _flat_state_pool.destruct(p);
+          
           auto zone_ptr = p->zone_ptr();
           
           if ( ! tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::destruct(p) )
@@ -188,6 +300,7 @@ namespace tchecker {
         {
           tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::collect();
           _zone_pool.collect();
+          _flat_state_pool.collect();
         }
         
         /*!
@@ -196,6 +309,8 @@ namespace tchecker {
          */
         void destruct_all()
         {
+          _shared_zones.clear();
+          _flat_state_pool.destruct_all();
           tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::destruct_all();
           _zone_pool.destruct_all();
         }
@@ -207,6 +322,8 @@ namespace tchecker {
          */
         void free_all()
         {
+          _shared_zones.clear();
+          _flat_state_pool.free_all();
           tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::free_all();
           _zone_pool.free_all();
         }
@@ -218,7 +335,7 @@ namespace tchecker {
         std::size_t memsize() const
         {
           return tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::memsize()
-          + _zone_pool.memsize();
+          + _zone_pool.memsize() + _flat_state_pool.memsize();
         }
         
         /*!
@@ -231,10 +348,96 @@ namespace tchecker {
         {
           tchecker::ta::details::state_pool_allocator_t<STATE, VLOC, INTVARS_VAL>::enroll(gc);
           _zone_pool.enroll(gc);
+          if (_flat_layout)
+            _flat_state_pool.enroll(gc);
+        }
+        
+        /*!
+         \brief Accessor
+         \return true if states are allocated with their components in a single chunk, false otherwise
+         */
+        inline bool flat_layout() const
+        {
+          return _flat_layout;
+        }
+        
+        /*!
+         \brief Accessor
+         \return Memory allocated for a state and its components (tuple of locations, integer variables valuation and
+         zone), in a single chunk with the flat layout, and in four chunks otherwise
+         */
+        inline std::size_t state_alloc_size() const
+        {
+          if (_flat_layout)
+            return _flat_zone_offset + tchecker::allocation_size_t<ZONE>::alloc_size(_zone_dimension);
+          return tchecker::allocation_size_t<STATE>::alloc_size()
+          + tchecker::allocation_size_t<VLOC>::alloc_size(this->_vloc_capacity)
+          + tchecker::allocation_size_t<INTVARS_VAL>::alloc_size(this->_intvars_val_capacity)
+          + tchecker::allocation_size_t<ZONE>::alloc_size(_zone_dimension);
         }
       protected:
-        tchecker::clock_id_t _zone_dimension;     /*!< Dimension of allocated zones */
-        tchecker::pool_t<ZONE> _zone_pool;        /*!< Pool of zones */
+        /*!
+         \brief Size of a block in a flat chunk
+         \param size : allocation size of an object
+         \return size rounded up to a multiple of the size of pointers
+         */
+        static constexpr std::size_t flat_block_size(std::size_t size)
+        {
+          return ((size + sizeof(void *) - 1) / sizeof(void *)) * sizeof(void *);
+        }
+        
+        /*!
+         \brief Construct a state in a flat chunk
+         \param args : arguments to a constructor of STATE beyond tuple of locations, integer variables valuation and zone
+         \return a new instance of STATE constructed from args and nullptr tuple of locations, integer variables
+         valuation and zone, allocated in a flat chunk
+         */
+        template <class ... ARGS>
+        tchecker::intrusive_shared_ptr_t<STATE> flat_construct(ARGS && ... args)
+        {
+          return _flat_state_pool.construct(args...,
+                                            typename STATE::zone_ptr_t(nullptr),
+                                            typename STATE::vloc_ptr_t(nullptr),
+                                            typename STATE::intvars_valuation_ptr_t(nullptr));
+        }
+        
+        /*!
+         \brief Accessor
+         \param p : pointer to a state
+         \pre p has been constructed by flat_construct()
+         \return pointer to the beginning of the chunk of p
+         */
+        static inline char * flat_chunk(tchecker::intrusive_shared_ptr_t<STATE> const & p)
+        {
+          return reinterpret_cast<char *>(p.ptr()) - sizeof(typename STATE::refcount_t);
+        }
+        
+        /*!
+         \brief Construct a component in a flat chunk
+         \tparam T : type of component, should be a tchecker::make_shared_t
+         \param block : pointer to the block of the component in a flat chunk
+         \param args : arguments to a constructor of T
+         \return a pointer to a new instance of T constructed from args in block
+         */
+        template <class T, class ... ARGS>
+        static tchecker::intrusive_shared_ptr_t<T> flat_embed(char * block, ARGS && ... args)
+        {
+          void * t = reinterpret_cast<typename T::refcount_t *>(block) + 1;
+          T::construct(t, std::forward<ARGS>(args)...);
+          return tchecker::intrusive_shared_ptr_t<T>(reinterpret_cast<T *>(t));
+        }
+        
+        tchecker::clock_id_t _zone_dimension;                              /*!< Dimension of allocated zones */
+        tchecker::pool_t<ZONE> _zone_pool;                                 /*!< Pool of zones */
+        bool _share_zones;                                                 /*!< Zone sharing flag */
+        tchecker::fsm::details::shared_components_t<ZONE> _shared_zones;   /*!< Shared zones */
+        std::size_t _zone_sharing_lookups;                                 /*!< Number of lookups in shared zones */
+        std::size_t _zone_sharing_hits;                                    /*!< Number of zones replaced by a shared zone */
+        bool _flat_layout;                                                 /*!< Flat layout flag */
+        std::size_t const _flat_vloc_offset;                               /*!< Offset of tuples of locations in chunks */
+        std::size_t const _flat_intvars_val_offset;                        /*!< Offset of intvars valuations in chunks */
+        std::size_t const _flat_zone_offset;                               /*!< Offset of zones in chunks */
+        tchecker::pool_t<STATE> _flat_state_pool;                          /*!< Pool of states with embedded components */
       };
       
       
@@ -113,7 +113,7 @@ namespace tchecker {
          */
         virtual tchecker::range_t<typename ZG::outgoing_edges_iterator_t> outgoing_edges(STATE const & s)
         {
-          return _zg.outgoing_edges(s.vloc());
+          return _zg.outgoing_edges(s.vloc(), s.intvars_valuation());
         }
         
         /*!
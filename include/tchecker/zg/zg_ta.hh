@@ -146,13 +146,21 @@ namespace tchecker {
          \brief Constructor
          \param model : a model
          \param alloc_nb : number of objects in an allocation block
+         \param share_components : sharing flag for tuples of locations and integer variables valuations
+         \param share_zones : sharing flag for zones
+         \param flat_layout : flag for allocation of states with their components in a single chunk
+         \throw std::invalid_argument : if flat_layout is true and share_components or share_zones is true
          */
-        state_pool_allocator_t(tchecker::zg::ta::model_t & model, std::size_t alloc_nb)
+        state_pool_allocator_t(tchecker::zg::ta::model_t & model, std::size_t alloc_nb, bool share_components = false,
+                               bool share_zones = false, bool flat_layout = false)
         : tchecker::zg::details::state_pool_allocator_t<STATE>
         (alloc_nb,
          alloc_nb, model.system().processes_count(),
-         alloc_nb, model.flattened_integer_variables().flattened_size(),
-         alloc_nb, model.flattened_clock_variables().flattened_size())
+         alloc_nb, model.intvars_valuation_size(),
+         alloc_nb, model.flattened_clock_variables().flattened_size(),
+         share_components,
+         share_zones,
+         flat_layout)
         {}
       };
       
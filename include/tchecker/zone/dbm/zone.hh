@@ -8,6 +8,8 @@
 #ifndef TCHECKER_ZONE_DBM_HH
 #define TCHECKER_ZONE_DBM_HH
 
+#include <cstdint>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/dbm.hh"
@@ -113,6 +115,14 @@ namespace tchecker {
        */
       std::size_t hash() const;
       
+      /*!
+       \brief Accessor
+       \return inclusion signature of this zone (see tchecker::dbm::signature)
+       \note if this zone is included in zone, then all the bits set in zone.signature() are also set in
+       this->signature()
+       */
+      std::uint64_t signature() const;
+      
       /*!
        \brief Accessor
        \return dimension of the zone
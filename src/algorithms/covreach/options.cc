@@ -25,7 +25,16 @@ namespace tchecker {
     _search_order(std::move(options._search_order)),
     _block_size(std::move(options._block_size)),
     _nodes_table_size(std::move(options._nodes_table_size)),
-    _stats(options._stats)
+    _native_code_dir(std::move(options._native_code_dir)),
+    _threads(std::move(options._threads)),
+    _stats(options._stats),
+    _detailed_stats(options._detailed_stats),
+    _share_components(options._share_components),
+    _share_zones(options._share_zones),
+    _packed_intvars(options._packed_intvars),
+    _flat_states(options._flat_states),
+    _verdict_only(options._verdict_only),
+    _trace(options._trace)
     {
       options._os = nullptr;
     }
@@ -51,7 +60,16 @@ namespace tchecker {
         _search_order = std::move(options._search_order);
         _block_size = options._block_size;
         _nodes_table_size = options._nodes_table_size;
+        _native_code_dir = std::move(options._native_code_dir);
+        _threads = options._threads;
         _stats = options._stats;
+        _detailed_stats = options._detailed_stats;
+        _share_components = options._share_components;
+        _share_zones = options._share_zones;
+        _packed_intvars = options._packed_intvars;
+        _flat_states = options._flat_states;
+        _verdict_only = options._verdict_only;
+        _trace = options._trace;
       }
       return *this;
     }
@@ -101,7 +119,19 @@ namespace tchecker {
     
     std::size_t options_t::nodes_table_size() const
     {
-      return _block_size;
+      return _nodes_table_size;
+    }
+    
+    
+    std::string const & options_t::native_code_dir() const
+    {
+      return _native_code_dir;
+    }
+    
+    
+    std::size_t options_t::threads() const
+    {
+      return _threads;
     }
     
     
@@ -111,6 +141,48 @@ namespace tchecker {
     }
     
     
+    bool options_t::detailed_stats() const
+    {
+      return (_detailed_stats == 1);
+    }
+    
+    
+    bool options_t::share_components() const
+    {
+      return (_share_components == 1);
+    }
+    
+    
+    bool options_t::share_zones() const
+    {
+      return (_share_zones == 1);
+    }
+    
+    
+    bool options_t::packed_intvars() const
+    {
+      return (_packed_intvars == 1);
+    }
+    
+    
+    bool options_t::flat_states() const
+    {
+      return (_flat_states == 1);
+    }
+    
+    
+    bool options_t::verdict_only() const
+    {
+      return (_verdict_only == 1);
+    }
+    
+    
+    bool options_t::trace() const
+    {
+      return (_trace == 1);
+    }
+    
+    
     void options_t::set_option(std::string const & key, std::string const & value, tchecker::log_t & log)
     {
       if (key == "c")
@@ -119,6 +191,8 @@ namespace tchecker {
         set_output_format(value, log);
       else if (key == "h") {
       }
+      else if (key == "j")
+        set_threads(value, log);
       else if (key == "l")
         set_accepting_labels(value, log);
       else if (key == "m")
@@ -133,6 +207,22 @@ namespace tchecker {
         set_nodes_table_size(value, log);
       else if (key == "S")
         set_stats(value, log);
+      else if (key == "detailed-stats")
+        set_detailed_stats(value, log);
+      else if (key == "share-components")
+        set_share_components(value, log);
+      else if (key == "share-zones")
+        set_share_zones(value, log);
+      else if (key == "packed-intvars")
+        set_packed_intvars(value, log);
+      else if (key == "flat-states")
+        set_flat_states(value, log);
+      else if (key == "native-code")
+        set_native_code_dir(value, log);
+      else if (key == "verdict-only")
+        set_verdict_only(value, log);
+      else if (key == "trace")
+        set_trace(value, log);
       else
         log.warning("Unknown command line option " + key);
     }
@@ -289,6 +379,14 @@ namespace tchecker {
         _search_order = tchecker::covreach::options_t::BFS;
       else if (value == "dfs")
         _search_order = tchecker::covreach::options_t::DFS;
+      else if (value == "bestfirst")
+        _search_order = tchecker::covreach::options_t::BEST_FIRST;
+      else if (value == "distance")
+        _search_order = tchecker::covreach::options_t::DISTANCE;
+      else if (value == "random")
+        _search_order = tchecker::covreach::options_t::RANDOM;
+      else if (value == "ranking")
+        _search_order = tchecker::covreach::options_t::RANKING;
       else
         log.error("Unknown search order: " + value + " for command line option -s");
     }
@@ -318,12 +416,80 @@ namespace tchecker {
     }
     
     
+    void options_t::set_native_code_dir(std::string const & value, tchecker::log_t & log)
+    {
+      if (value.empty()) {
+        log.error("Invalid value: empty directory for command line option --native-code");
+        return;
+      }
+      
+      _native_code_dir = value;
+    }
+    
+    
+    void options_t::set_threads(std::string const & value, tchecker::log_t & log)
+    {
+      for (auto c : value)
+        if (! isdigit(c)) {
+          log.error("Invalid value: " + value + " for command line option -j, expecting an unsigned integer");
+          return;
+        }
+      
+      _threads = std::stoul(value);
+      if (_threads == 0)
+        log.error("Invalid value: " + value + " for command line option -j, expecting a positive number of threads");
+    }
+    
+    
     void options_t::set_stats(std::string const & value, tchecker::log_t & log)
     {
       _stats = 1;
     }
     
     
+    void options_t::set_detailed_stats(std::string const & value, tchecker::log_t & log)
+    {
+      _stats = 1;
+      _detailed_stats = 1;
+    }
+    
+    
+    void options_t::set_share_components(std::string const & value, tchecker::log_t & log)
+    {
+      _share_components = 1;
+    }
+    
+    
+    void options_t::set_share_zones(std::string const & value, tchecker::log_t & log)
+    {
+      _share_zones = 1;
+    }
+    
+    
+    void options_t::set_packed_intvars(std::string const & value, tchecker::log_t & log)
+    {
+      _packed_intvars = 1;
+    }
+    
+    
+    void options_t::set_flat_states(std::string const & value, tchecker::log_t & log)
+    {
+      _flat_states = 1;
+    }
+    
+    
+    void options_t::set_verdict_only(std::string const & value, tchecker::log_t & log)
+    {
+      _verdict_only = 1;
+    }
+    
+    
+    void options_t::set_trace(std::string const & value, tchecker::log_t & log)
+    {
+      _trace = 1;
+    }
+    
+    
     void options_t::check_mandatory_options(tchecker::log_t & log) const
     {
       if (_algorithm_model == UNKNOWN)
@@ -341,6 +507,7 @@ namespace tchecker {
       os << "                 aMl           aM abstraction with local clock bounds" << std::endl;
       os << "-f (dot|raw)     output format (graphviz DOT format or raw format)" << std::endl;
       os << "-h               this help screen" << std::endl;
+      os << "-j n             number of worker threads (no graph output when n > 1)" << std::endl;
       os << "-l labels        accepting labels, where labels is a column-separated list of identifiers" << std::endl;
       os << "-m model         where model is one of the following:" << std::endl;
       os << "                 zg:semantics:extrapolation        zone graph with:" << std::endl;
@@ -360,12 +527,29 @@ namespace tchecker {
       os << "                                   non-elapsed     non time-elapsed semantics" << std::endl;
       os << "                   extrapolation:  extraLU+l       ExtraLU+ with local clock bounds" << std::endl;
       os << "-o filename      output graph to filename" << std::endl;
-      os << "-s (bfs|dfs)     search order (breadth-first search or depth-first search)" << std::endl;
+      os << "-s order         search order, where order is one of the following:" << std::endl;
+      os << "                 bfs           breadth-first search" << std::endl;
+      os << "                 dfs           depth-first search" << std::endl;
+      os << "                 bestfirst     best-first search: nodes with more processes in accepting locations first" << std::endl;
+      os << "                 distance      nodes closer to the accepting locations (-l) first" << std::endl;
+      os << "                 random        random search (reproducible)" << std::endl;
+      os << "                 ranking       breadth-first search, where nodes that cover expanded nodes and their" << std::endl;
+      os << "                               successors come first" << std::endl;
       os << "-S               output stats" << std::endl;
       os << "--block-size n   size of an allocation block (number of allocated objects)" << std::endl;
-      os << "--table-size n   size of the nodes table" << std::endl;
+      os << "--table-size n   initial size of the nodes table (0: estimated from the model)" << std::endl;
+      os << "--detailed-stats output stats, and stats on internal data structures" << std::endl;
+      os << "--share-components" << std::endl;
+      os << "                 share equal tuples of locations and integer variables valuations between nodes" << std::endl;
+      os << "--share-zones    share equal zones between nodes" << std::endl;
+      os << "--packed-intvars store bit-packed integer variables valuations in nodes (no graph output)" << std::endl;
+      os << "--trace          output a symbolic run from an initial node to the accepting node, if any" << std::endl;
+      os << "--flat-states    allocate each node with its tuple of locations, integer variables valuation and zone" << std::endl;
+      os << "                 in a single chunk of memory (zone graphs only, no sharing)" << std::endl;
+      os << "--native-code dir compile guards, invariants and statements to native code, cached in directory dir" << std::endl;
+      os << "--verdict-only   only compute the verdict: the graph keeps nodes but no edge (no graph output)" << std::endl;
       os << std::endl;
-      os << "Default parameters: -c inclusion -f raw -s dfs --block-size 10000 --table-size 65536, output to standard output";
+      os << "Default parameters: -c inclusion -f raw -s dfs -j 1 --block-size 10000 --table-size 0, output to standard output";
       os << std::endl;
       os << "                    -m must be specified" << std::endl;
       return os;
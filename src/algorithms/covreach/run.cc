@@ -5,6 +5,11 @@
  *
  */
 
+#include <limits>
+#include <vector>
+
+#include <unistd.h>
+
 #include "tchecker/algorithms/covreach/run.hh"
 #include "tchecker/algorithms/covreach/waiting.hh"
 
@@ -12,6 +17,28 @@ namespace tchecker {
   
   namespace covreach {
     
+    namespace details {
+      
+      std::size_t nodes_table_size_bound()
+      {
+        std::size_t bound = std::numeric_limits<tchecker::graph::cover::node_position_t>::max();
+        
+        // The initial nodes table should not use more than 1/1024 of the physical memory
+        long const pages = ::sysconf(_SC_PHYS_PAGES);
+        long const page_size = ::sysconf(_SC_PAGE_SIZE);
+        if ((pages > 0) && (page_size > 0)) {
+          std::size_t const memory = static_cast<std::size_t>(pages) * static_cast<std::size_t>(page_size);
+          bound = std::min(bound, memory / 1024 / sizeof(std::vector<void *>));
+        }
+        else
+          bound = std::min(bound, static_cast<std::size_t>(65536));
+        
+        return bound;
+      }
+      
+    } // end of namespace details
+    
+    
     void run(tchecker::parsing::system_declaration_t const & sysdecl,
              tchecker::covreach::options_t const & options,
              tchecker::log_t & log)
@@ -23,6 +50,18 @@ namespace tchecker {
         case tchecker::covreach::options_t::DFS:
           tchecker::covreach::details::run<tchecker::covreach::lifo_waiting_t>(sysdecl, options, log);
           break;
+        case tchecker::covreach::options_t::BEST_FIRST:
+          tchecker::covreach::details::run<tchecker::covreach::accepting_processes_waiting_t>(sysdecl, options, log);
+          break;
+        case tchecker::covreach::options_t::DISTANCE:
+          tchecker::covreach::details::run<tchecker::covreach::distance_waiting_t>(sysdecl, options, log);
+          break;
+        case tchecker::covreach::options_t::RANDOM:
+          tchecker::covreach::details::run<tchecker::covreach::random_waiting_t>(sysdecl, options, log);
+          break;
+        case tchecker::covreach::options_t::RANKING:
+          tchecker::covreach::details::run<tchecker::covreach::ranking_waiting_t>(sysdecl, options, log);
+          break;
         default:
           log.error("Unsupported search order for covreach algorithm");
           break;
@@ -12,7 +12,7 @@ namespace tchecker {
   namespace covreach {
     
     stats_t::stats_t()
-    : _visited_nodes(0), _covered_leaf_nodes(0), _covered_nonleaf_nodes(0)
+    : _visited_nodes(0), _covered_leaf_nodes(0), _covered_nonleaf_nodes(0), _expanded_covered_nodes(0)
     {}
     
     
@@ -49,6 +49,12 @@ namespace tchecker {
     }
     
     
+    unsigned long stats_t::expanded_covered_nodes() const
+    {
+      return _expanded_covered_nodes;
+    }
+    
+    
     void stats_t::increment_visited_nodes()
     {
       ++ _visited_nodes;
@@ -67,6 +73,22 @@ namespace tchecker {
     }
     
     
+    void stats_t::increment_expanded_covered_nodes()
+    {
+      ++ _expanded_covered_nodes;
+    }
+    
+    
+    tchecker::covreach::stats_t & stats_t::operator+= (tchecker::covreach::stats_t const & stats)
+    {
+      _visited_nodes += stats._visited_nodes;
+      _covered_leaf_nodes += stats._covered_leaf_nodes;
+      _covered_nonleaf_nodes += stats._covered_nonleaf_nodes;
+      _expanded_covered_nodes += stats._expanded_covered_nodes;
+      return *this;
+    }
+    
+    
     
     
     std::ostream & operator<< (std::ostream & os, tchecker::covreach::stats_t const & stats)
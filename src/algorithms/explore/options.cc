@@ -21,7 +21,9 @@ namespace tchecker {
     _explored_model(std::move(options._explored_model)),
     _os(options._os),
     _search_order(std::move(options._search_order)),
-    _block_size(std::move(options._block_size))
+    _block_size(std::move(options._block_size)),
+    _share_components(options._share_components),
+    _share_zones(options._share_zones)
     {
       options._os = nullptr;
     }
@@ -44,6 +46,8 @@ namespace tchecker {
         options._os = nullptr;
         _search_order = std::move(options._search_order);
         _block_size = options._block_size;
+        _share_components = options._share_components;
+        _share_zones = options._share_zones;
       }
       return *this;
     }
@@ -79,6 +83,18 @@ namespace tchecker {
     }
     
     
+    bool options_t::share_components() const
+    {
+      return _share_components;
+    }
+    
+    
+    bool options_t::share_zones() const
+    {
+      return _share_zones;
+    }
+    
+    
     void options_t::set_option(std::string const & key, std::string const & value, tchecker::log_t & log)
     {
       if (key == "f")
@@ -93,6 +109,10 @@ namespace tchecker {
         set_search_order(value, log);
       else if (key == "block-size")
         set_block_size(value, log);
+      else if (key == "share-components")
+        set_share_components(value, log);
+      else if (key == "share-zones")
+        set_share_zones(value, log);
       else
         log.warning("Unknown command line option " + key);
     }
@@ -246,6 +266,18 @@ namespace tchecker {
     }
     
     
+    void options_t::set_share_components(std::string const & value, tchecker::log_t & log)
+    {
+      _share_components = true;
+    }
+    
+    
+    void options_t::set_share_zones(std::string const & value, tchecker::log_t & log)
+    {
+      _share_zones = true;
+    }
+    
+    
     void options_t::check_mandatory_options(tchecker::log_t & log) const
     {
       if (_explored_model == UNKNOWN)
@@ -278,6 +310,9 @@ namespace tchecker {
       os << "-o filename      output graph to filename" << std::endl;
       os << "-s (bfs|dfs)     search order (breadth-first search or depth-first search)" << std::endl;
       os << "--block-size n   size of an allocation block (number of allocated objects)" << std::endl;
+      os << "--share-components" << std::endl;
+      os << "                 share equal tuples of locations and integer variables valuations between nodes" << std::endl;
+      os << "--share-zones    share equal zones between nodes (zone graphs only)" << std::endl;
       os << std::endl;
       os << "Default parameters: -f raw -s dfs --block-size 10000, output to standard output" << std::endl;
       os << "                    -m must be specified" << std::endl;
@@ -16,6 +16,14 @@ namespace tchecker {
       
       namespace fsm {
         
+        std::tuple<tchecker::explore::details::fsm::explored_model_t::model_t &, std::size_t, bool>
+        explored_model_t::node_allocator_args(tchecker::explore::details::fsm::explored_model_t::model_t & model,
+                                              tchecker::explore::options_t const & options)
+        {
+          return std::tuple<tchecker::explore::details::fsm::explored_model_t::model_t &, std::size_t, bool>
+          (model, options.block_size(), options.share_components());
+        }
+        
         std::tuple<tchecker::intvar_index_t const &>
         explored_model_t::node_outputter_args(tchecker::explore::details::fsm::explored_model_t::model_t const & model)
         {
@@ -35,6 +43,14 @@ namespace tchecker {
       
       namespace ta {
         
+        std::tuple<tchecker::explore::details::ta::explored_model_t::model_t &, std::size_t, bool>
+        explored_model_t::node_allocator_args(tchecker::explore::details::ta::explored_model_t::model_t & model,
+                                              tchecker::explore::options_t const & options)
+        {
+          return std::tuple<tchecker::explore::details::ta::explored_model_t::model_t &, std::size_t, bool>
+          (model, options.block_size(), options.share_components());
+        }
+        
         std::tuple<tchecker::intvar_index_t const &>
         explored_model_t::node_outputter_args(tchecker::explore::details::ta::explored_model_t::model_t const & model)
         {
@@ -5,7 +5,9 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 #if BOOST_VERSION <= 106600
 # include <boost/functional/hash.hpp>
@@ -14,7 +16,13 @@
 #endif
 
 #include "tchecker/dbm/dbm.hh"
-#include "tchecker/utils/ordering.hh"
+
+// AVX2 kernels are compiled for x86 with GCC/clang and 32-bit difference bounds, and selected at runtime if the CPU
+// supports AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && (INTEGER_T_SIZE == 32)
+# define TCHECKER_DBM_AVX2_DISPATCH
+# include <immintrin.h>
+#endif
 
 namespace tchecker {
   
@@ -24,6 +32,337 @@ namespace tchecker {
 #define DBM1(i,j)         dbm1[(i)*dim+(j)]
 #define DBM2(i,j)         dbm2[(i)*dim+(j)]
     
+    namespace details {
+      
+      /*
+       Kernels on arrays of n difference bounds. The scalar kernels are used as fallback when the AVX2 kernels are not
+       available. Both implementations compute the same results (in particular the same hash codes)
+       */
+      
+      std::size_t const HASH_LANES = 8;                  /*!< Number of hash lanes (one per 32-bit bound in 256 bits) */
+      std::uint32_t const HASH_MULTIPLIER = 0x01000193;  /*!< Multiplier in hash lanes */
+      
+      std::size_t scalar_mismatch(tchecker::dbm::db_t const * a, tchecker::dbm::db_t const * b, std::size_t n)
+      {
+        for (std::size_t k = 0; k < n; ++k)
+          if (a[k] != b[k])
+            return k;
+        return n;
+      }
+      
+      
+      bool scalar_is_le(tchecker::dbm::db_t const * a, tchecker::dbm::db_t const * b, std::size_t n)
+      {
+        for (std::size_t k = 0; k < n; ++k)
+          if (a[k] > b[k])
+            return false;
+        return true;
+      }
+      
+      
+      // row_i[j] is set to min(row_i[j], db_ik + row_k[j]) for all j < dim. db_ik should not be LT_INFINITY
+      void scalar_tighten_row(tchecker::dbm::db_t * row_i, tchecker::dbm::db_t db_ik, tchecker::dbm::db_t const * row_k,
+                              std::size_t dim)
+      {
+        for (std::size_t j = 0; j < dim; ++j)
+          row_i[j] = tchecker::dbm::min(tchecker::dbm::sum(db_ik, row_k[j]), row_i[j]);
+      }
+      
+      
+      bool scalar_is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                            tchecker::integer_t const * l, tchecker::integer_t const * u)
+      {
+        // dbm1 not included in aLU(dbm2) if there is x and y s.t.
+        //     dbm1[0x] >= (<= -u[x])
+        // &&  dbm2[yx] < dbm1[yx]
+        // &&  dbm2[yx] + (< -l[y]) < dbm1[0x]
+        
+        for (tchecker::clock_id_t x = 0; x < dim; ++x) {
+          assert(u[x] < tchecker::dbm::INF_VALUE);
+        
+          // Skip x as 1st condition cannot be satisfied
+          if (u[x] == - tchecker::dbm::INF_VALUE)
+            continue;
+        
+          // Check 1st condition
+          if (DBM1(0,x) < tchecker::dbm::db(tchecker::dbm::LE, -u[x]))
+            continue;
+        
+          for (tchecker::clock_id_t y = 0; y < dim; ++y) {
+            assert(l[y] < tchecker::dbm::INF_VALUE);
+          
+            if (x == y)
+              continue;
+          
+            // Skip y as 3rd condition cannot be satisfied
+            if (l[y] == - tchecker::dbm::INF_VALUE)
+              continue;
+          
+            // Check 2nd and 3rd conditions
+            if ((DBM2(y,x) < DBM1(y,x)) &&
+                (tchecker::dbm::sum(DBM2(y,x), tchecker::dbm::db(tchecker::dbm::LT, -l[y])) < DBM1(0,x)))
+              return false;
+          }
+        }
+        
+        return true;
+      }
+      
+      
+      // bound a[k] is accumulated in lane k % HASH_LANES, for k from first to n-1
+      void scalar_hash_lanes(tchecker::dbm::db_t const * a, std::size_t first, std::size_t n, std::uint32_t * lanes)
+      {
+        for (std::size_t k = first; k < n; ++k)
+          lanes[k % HASH_LANES] = lanes[k % HASH_LANES] * HASH_MULTIPLIER + static_cast<std::uint32_t>(a[k]);
+      }
+      
+#if defined(TCHECKER_DBM_AVX2_DISPATCH)
+      
+      __attribute__((target("avx2")))
+      std::size_t avx2_mismatch(tchecker::dbm::db_t const * a, tchecker::dbm::db_t const * b, std::size_t n)
+      {
+        std::size_t k = 0;
+        for ( ; k + 8 <= n; k += 8) {
+          __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + k));
+          __m256i vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + k));
+          unsigned int neq = ~ static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(va, vb)));
+          if (neq != 0)
+            return k + __builtin_ctz(neq) / 4;
+        }
+        return k + tchecker::dbm::details::scalar_mismatch(a + k, b + k, n - k);
+      }
+      
+      
+      __attribute__((target("avx2")))
+      bool avx2_is_le(tchecker::dbm::db_t const * a, tchecker::dbm::db_t const * b, std::size_t n)
+      {
+        std::size_t k = 0;
+        for ( ; k + 8 <= n; k += 8) {
+          __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + k));
+          __m256i vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + k));
+          if (! _mm256_testz_si256(_mm256_cmpgt_epi32(va, vb), _mm256_set1_epi32(-1)))
+            return false;
+        }
+        return tchecker::dbm::details::scalar_is_le(a + k, b + k, n - k);
+      }
+      
+      
+      // sums are computed on values and comparators as tchecker::dbm::sum. Blocks with a sum out of the bounds
+      // [MIN_VALUE, MAX_VALUE] are handed over to the scalar kernel that reports them
+      __attribute__((target("avx2")))
+      void avx2_tighten_row(tchecker::dbm::db_t * row_i, tchecker::dbm::db_t db_ik, tchecker::dbm::db_t const * row_k,
+                            std::size_t dim)
+      {
+        __m256i const one = _mm256_set1_epi32(1);
+        __m256i const infinity = _mm256_set1_epi32(tchecker::dbm::LT_INFINITY);
+        __m256i const max_value = _mm256_set1_epi32(tchecker::dbm::MAX_VALUE);
+        __m256i const min_value = _mm256_set1_epi32(tchecker::dbm::MIN_VALUE);
+        __m256i const a = _mm256_set1_epi32(db_ik);
+        __m256i const a_value = _mm256_srai_epi32(a, 1);
+        std::size_t j = 0;
+        for ( ; j + 8 <= dim; j += 8) {
+          __m256i b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row_k + j));
+          __m256i b_infinity = _mm256_cmpeq_epi32(b, infinity);
+          __m256i value = _mm256_add_epi32(a_value, _mm256_srai_epi32(b, 1));
+          __m256i out_of_bounds = _mm256_andnot_si256(b_infinity, _mm256_or_si256(_mm256_cmpgt_epi32(value, max_value),
+                                                                                   _mm256_cmpgt_epi32(min_value, value)));
+          if (! _mm256_testz_si256(out_of_bounds, out_of_bounds)) {
+            tchecker::dbm::details::scalar_tighten_row(row_i + j, db_ik, row_k + j, 8);
+            continue;
+          }
+          __m256i sum = _mm256_or_si256(_mm256_slli_epi32(value, 1), _mm256_and_si256(_mm256_and_si256(a, b), one));
+          sum = _mm256_blendv_epi8(sum, infinity, b_infinity);
+          __m256i r = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row_i + j));
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(row_i + j), _mm256_min_epi32(r, sum));
+        }
+        tchecker::dbm::details::scalar_tighten_row(row_i + j, db_ik, row_k + j, dim - j);
+      }
+      
+      
+      // the loops on x and y are swapped w.r.t. the scalar kernel, in order to check the conditions on a row y of
+      // the DBMs at once. If a sum in the 3rd condition is out of bounds, the scalar kernel decides the outcome
+      // (which may be an exception)
+      __attribute__((target("avx2")))
+      bool avx2_is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                          tchecker::integer_t const * l, tchecker::integer_t const * u)
+      {
+        __m256i const minus_infinity = _mm256_set1_epi32(- tchecker::dbm::INF_VALUE);
+        __m256i const infinity = _mm256_set1_epi32(tchecker::dbm::LT_INFINITY);
+        __m256i const max_value = _mm256_set1_epi32(tchecker::dbm::MAX_VALUE);
+        __m256i const min_value = _mm256_set1_epi32(tchecker::dbm::MIN_VALUE);
+        __m256i const one = _mm256_set1_epi32(1);
+        __m256i const lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        
+        for (tchecker::clock_id_t y = 0; y < dim; ++y) {
+          assert(l[y] < tchecker::dbm::INF_VALUE);
+          
+          // Skip y as 3rd condition cannot be satisfied
+          if (l[y] == - tchecker::dbm::INF_VALUE)
+            continue;
+          
+          tchecker::dbm::db_t const db_ly = tchecker::dbm::db(tchecker::dbm::LT, -l[y]);
+          __m256i const ly_value = _mm256_set1_epi32(-l[y]);
+          __m256i const vy = _mm256_set1_epi32(y);
+          
+          tchecker::clock_id_t x = 0;
+          for ( ; x + 8 <= dim; x += 8) {
+            __m256i ux = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(u + x));
+            __m256i db1_0x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm1 + x));
+            __m256i db1_yx = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm1 + y * dim + x));
+            __m256i db2_yx = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm2 + y * dim + x));
+            
+            // 1st condition (x != y, and u[x] is not -INF_VALUE)
+            __m256i db_ux = _mm256_or_si256(_mm256_slli_epi32(_mm256_sub_epi32(_mm256_setzero_si256(), ux), 1), one);
+            __m256i candidates = _mm256_andnot_si256(_mm256_cmpgt_epi32(db_ux, db1_0x),
+                                                     _mm256_andnot_si256(_mm256_cmpeq_epi32(ux, minus_infinity),
+                                                                         _mm256_set1_epi32(-1)));
+            candidates = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_add_epi32(lanes, _mm256_set1_epi32(x)), vy),
+                                             candidates);
+            
+            // 2nd condition
+            candidates = _mm256_and_si256(candidates, _mm256_cmpgt_epi32(db1_yx, db2_yx));
+            if (_mm256_testz_si256(candidates, candidates))
+              continue;
+            
+            // 3rd condition
+            __m256i db2_yx_infinity = _mm256_cmpeq_epi32(db2_yx, infinity);
+            __m256i value = _mm256_add_epi32(_mm256_srai_epi32(db2_yx, 1), ly_value);
+            __m256i out_of_bounds = _mm256_andnot_si256(db2_yx_infinity,
+                                                        _mm256_or_si256(_mm256_cmpgt_epi32(value, max_value),
+                                                                        _mm256_cmpgt_epi32(min_value, value)));
+            if (! _mm256_testz_si256(candidates, out_of_bounds))
+              return tchecker::dbm::details::scalar_is_alu_le(dbm1, dbm2, dim, l, u);
+            __m256i sum = _mm256_blendv_epi8(_mm256_slli_epi32(value, 1), infinity, db2_yx_infinity);
+            if (! _mm256_testz_si256(candidates, _mm256_cmpgt_epi32(db1_0x, sum)))
+              return false;
+          }
+          
+          for ( ; x < dim; ++x) {
+            if ((x == y) || (u[x] == - tchecker::dbm::INF_VALUE) || (DBM1(0,x) < tchecker::dbm::db(tchecker::dbm::LE, -u[x])))
+              continue;
+            if ((DBM2(y,x) < DBM1(y,x)) && (tchecker::dbm::sum(DBM2(y,x), db_ly) < DBM1(0,x)))
+              return false;
+          }
+        }
+        
+        return true;
+      }
+      
+      
+      __attribute__((target("avx2")))
+      void avx2_hash_lanes(tchecker::dbm::db_t const * a, std::size_t n, std::uint32_t * lanes)
+      {
+        static_assert(HASH_LANES == 8, "");
+        __m256i acc = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lanes));
+        __m256i const mul = _mm256_set1_epi32(static_cast<int>(HASH_MULTIPLIER));
+        std::size_t k = 0;
+        for ( ; k + 8 <= n; k += 8)
+          acc = _mm256_add_epi32(_mm256_mullo_epi32(acc, mul),
+                                 _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + k)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+        tchecker::dbm::details::scalar_hash_lanes(a, k, n, lanes);
+      }
+      
+      
+      bool cpu_supports_avx2()
+      {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+      }
+      
+      // false (hence scalar kernels) until initialized, if a kernel is called during static initialization
+      bool const use_avx2 = tchecker::dbm::details::cpu_supports_avx2();
+      
+#endif // TCHECKER_DBM_AVX2_DISPATCH
+      
+      /*!
+       \brief Mismatch
+       \param a : an array of difference bounds
+       \param b : an array of difference bounds
+       \param n : size of a and b
+       \return the smallest index k such that a[k] != b[k], n if a and b are equal
+       */
+      inline std::size_t mismatch(tchecker::dbm::db_t const * a, tchecker::dbm::db_t const * b, std::size_t n)
+      {
+#if defined(TCHECKER_DBM_AVX2_DISPATCH)
+        if (tchecker::dbm::details::use_avx2)
+          return tchecker::dbm::details::avx2_mismatch(a, b, n);
+#endif
+        return tchecker::dbm::details::scalar_mismatch(a, b, n);
+      }
+      
+      /*!
+       \brief Less-or-equal predicate
+       \param a : an array of difference bounds
+       \param b : an array of difference bounds
+       \param n : size of a and b
+       \return true if a[k] <= b[k] for all k < n, false otherwise
+       */
+      inline bool is_le(tchecker::dbm::db_t const * a, tchecker::dbm::db_t const * b, std::size_t n)
+      {
+#if defined(TCHECKER_DBM_AVX2_DISPATCH)
+        if (tchecker::dbm::details::use_avx2)
+          return tchecker::dbm::details::avx2_is_le(a, b, n);
+#endif
+        return tchecker::dbm::details::scalar_is_le(a, b, n);
+      }
+      
+      /*!
+       \brief Tighten a row of a DBM w.r.t. a clock
+       \param row_i : row i of a DBM
+       \param db_ik : difference bound i->k
+       \param row_k : row k of the DBM
+       \param dim : dimension of the DBM
+       \pre db_ik is not tchecker::dbm::LT_INFINITY
+       \post row_i[j] is the minimum of row_i[j] and db_ik + row_k[j] for all j < dim
+       \throw std::invalid_argument : if a sum cannot be represented (see tchecker::dbm::sum)
+       */
+      inline void tighten_row(tchecker::dbm::db_t * row_i, tchecker::dbm::db_t db_ik, tchecker::dbm::db_t const * row_k,
+                              std::size_t dim)
+      {
+        assert(db_ik != tchecker::dbm::LT_INFINITY);
+#if defined(TCHECKER_DBM_AVX2_DISPATCH)
+        if (tchecker::dbm::details::use_avx2) {
+          tchecker::dbm::details::avx2_tighten_row(row_i, db_ik, row_k, dim);
+          return;
+        }
+#endif
+        tchecker::dbm::details::scalar_tighten_row(row_i, db_ik, row_k, dim);
+      }
+      
+      /*!
+       \brief Checks inclusion w.r.t. abstraction aLU (see tchecker::dbm::is_alu_le)
+       */
+      inline bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                            tchecker::integer_t const * l, tchecker::integer_t const * u)
+      {
+#if defined(TCHECKER_DBM_AVX2_DISPATCH)
+        if (tchecker::dbm::details::use_avx2)
+          return tchecker::dbm::details::avx2_is_alu_le(dbm1, dbm2, dim, l, u);
+#endif
+        return tchecker::dbm::details::scalar_is_alu_le(dbm1, dbm2, dim, l, u);
+      }
+      
+      /*!
+       \brief Hash lanes
+       \param a : an array of difference bounds
+       \param n : size of a
+       \param lanes : an array of HASH_LANES hash codes
+       \post a has been accumulated in lanes
+       */
+      inline void hash_lanes(tchecker::dbm::db_t const * a, std::size_t n, std::uint32_t * lanes)
+      {
+#if defined(TCHECKER_DBM_AVX2_DISPATCH)
+        if (tchecker::dbm::details::use_avx2) {
+          tchecker::dbm::details::avx2_hash_lanes(a, n, lanes);
+          return;
+        }
+#endif
+        tchecker::dbm::details::scalar_hash_lanes(a, 0, n, lanes);
+      }
+      
+    } // end of namespace details
+    
 
     void universal(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
     {
@@ -164,8 +503,7 @@ namespace tchecker {
         for (tchecker::clock_id_t i = 0 ; i < dim; ++i) {
           if ((i == k) || (DBM(i,k) == tchecker::dbm::LT_INFINITY)) // optimization
             continue;
-          for (tchecker::clock_id_t j = 0; j < dim; ++j)
-            DBM(i,j) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i,k), DBM(k,j)), DBM(i,j));
+          tchecker::dbm::details::tighten_row(&DBM(i,0), DBM(i,k), &DBM(k,0), dim);
           if (DBM(i,i) < tchecker::dbm::LE_ZERO) {
             DBM(0,0) = tchecker::dbm::LT_ZERO;
             return tchecker::dbm::EMPTY;
@@ -198,8 +536,8 @@ namespace tchecker {
         }
         
         // tighten i->j w.r.t. i->y->j
-        for (tchecker::clock_id_t j = 0; j < dim; ++j)
-          DBM(i,j) = tchecker::dbm::min(DBM(i,j), tchecker::dbm::sum(DBM(i,y), DBM(y,j)));
+        if (DBM(i,y) != tchecker::dbm::LT_INFINITY)
+          tchecker::dbm::details::tighten_row(&DBM(i,0), DBM(i,y), &DBM(y,0), dim);
         
         if (DBM(i,i) < tchecker::dbm::LE_ZERO) {
           DBM(0,0) = tchecker::dbm::LT_ZERO;
@@ -248,11 +586,8 @@ namespace tchecker {
       assert(tchecker::dbm::is_tight(dbm1, dim));
       assert(tchecker::dbm::is_tight(dbm2, dim));
       
-      for (tchecker::clock_id_t i = 0; i < dim; ++i)
-        for (tchecker::clock_id_t j = 0; j < dim; ++j)
-          if (DBM1(i,j) != DBM2(i,j))
-            return false;
-      return true;
+      std::size_t const n = static_cast<std::size_t>(dim) * dim;
+      return (tchecker::dbm::details::mismatch(dbm1, dbm2, n) == n);
     }
     
     
@@ -264,11 +599,7 @@ namespace tchecker {
       assert(tchecker::dbm::is_tight(dbm1, dim));
       assert(tchecker::dbm::is_tight(dbm2, dim));
       
-      for (tchecker::clock_id_t i = 0; i < dim; ++i)
-        for (tchecker::clock_id_t j = 0; j < dim; ++j)
-          if (DBM1(i,j) > DBM2(i,j))
-            return false;
-      return true;
+      return tchecker::dbm::details::is_le(dbm1, dbm2, static_cast<std::size_t>(dim) * dim);
     }
     
     
@@ -707,40 +1038,7 @@ namespace tchecker {
       assert(l[0] == 0);
       assert(u[0] == 0);
       
-      // dbm1 not included in aLU(dbm2) if there is x and y s.t.
-      //     dbm1[0x] >= (<= -u[x])
-      // &&  dbm2[yx] < dbm1[yx]
-      // &&  dbm2[yx] + (< -l[y]) < dbm1[0x]
-      
-      for (tchecker::clock_id_t x = 0; x < dim; ++x) {
-        assert(u[x] < tchecker::dbm::INF_VALUE);
-        
-        // Skip x as 1st condition cannot be satisfied
-        if (u[x] == - tchecker::dbm::INF_VALUE)
-          continue;
-        
-        // Check 1st condition
-        if (DBM1(0,x) < tchecker::dbm::db(tchecker::dbm::LE, -u[x]))
-          continue;
-        
-        for (tchecker::clock_id_t y = 0; y < dim; ++y) {
-          assert(l[y] < tchecker::dbm::INF_VALUE);
-          
-          if (x == y)
-            continue;
-          
-          // Skip y as 3rd condition cannot be satisfied
-          if (l[y] == - tchecker::dbm::INF_VALUE)
-            continue;
-          
-          // Check 2nd and 3rd conditions
-          if ((DBM2(y,x) < DBM1(y,x)) &&
-              (tchecker::dbm::sum(DBM2(y,x), tchecker::dbm::db(tchecker::dbm::LT, -l[y])) < DBM1(0,x)))
-            return false;
-        }
-      }
-      
-      return true;
+      return tchecker::dbm::details::is_alu_le(dbm1, dbm2, dim, l, u);
     }
     
     
@@ -752,13 +1050,39 @@ namespace tchecker {
     
     std::size_t hash(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
     {
+      assert(dbm != nullptr);
+      assert(dim >= 1);
+      
+      std::uint32_t lanes[tchecker::dbm::details::HASH_LANES] = {0};
+      tchecker::dbm::details::hash_lanes(dbm, static_cast<std::size_t>(dim) * dim, lanes);
+      
       std::size_t seed = 0;
-      for (tchecker::clock_id_t k = 0; k < dim*dim; ++k)
-        boost::hash_combine(seed, tchecker::dbm::hash(dbm[k]));
+      for (std::uint32_t lane : lanes)
+        boost::hash_combine(seed, lane);
       return seed;
     }
     
     
+    std::uint64_t signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+    {
+      assert(dbm != nullptr);
+      assert(dim >= 1);
+      
+      std::uint64_t sig = 0;
+      
+      for (tchecker::clock_id_t j = 1; j < dim; ++j)
+        if (DBM(0,j) < tchecker::dbm::LE_ZERO)
+          sig |= (static_cast<std::uint64_t>(1) << (j % 64));
+      
+      for (tchecker::clock_id_t i = 1; i < dim; ++i)
+        for (tchecker::clock_id_t j = 0; j < dim; ++j)
+          if ((i != j) && (DBM(i,j) < tchecker::dbm::LT_INFINITY))
+            sig |= (static_cast<std::uint64_t>(1) << ((i * dim + j) % 64));
+      
+      return sig;
+    }
+    
+    
     std::ostream & output_matrix(std::ostream & os, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
     {
       assert(dbm != nullptr);
@@ -839,9 +1163,12 @@ namespace tchecker {
       assert(dbm2 != nullptr);
       assert(dim1 >= 1);
       assert(dim2 >= 1);
-      return tchecker::lexical_cmp(dbm1, dbm1 + dim1 * dim1,
-                                   dbm2, dbm2 + dim2 * dim2,
-                                   tchecker::dbm::db_cmp);
+      std::size_t const n1 = static_cast<std::size_t>(dim1) * dim1;
+      std::size_t const n2 = static_cast<std::size_t>(dim2) * dim2;
+      std::size_t const k = tchecker::dbm::details::mismatch(dbm1, dbm2, std::min(n1, n2));
+      if (k < std::min(n1, n2))
+        return tchecker::dbm::db_cmp(dbm1[k], dbm2[k]);
+      return (n1 < n2 ? -1 : (n1 == n2 ? 0 : 1));
     }
     
   } // end of namespace dbm
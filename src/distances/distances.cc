@@ -0,0 +1,55 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <deque>
+
+#include "tchecker/distances/distances.hh"
+
+namespace tchecker {
+  
+  namespace distances {
+    
+    /* labels_distances_t */
+    
+    bool labels_distances_t::contributes(tchecker::process_id_t pid) const
+    {
+      for (std::vector<tchecker::process_id_t> const & processes : _processes)
+        if (std::find(processes.begin(), processes.end(), pid) != processes.end())
+          return true;
+      return false;
+    }
+    
+    
+    void labels_distances_t::compute(std::vector<std::vector<tchecker::loc_id_t>> const & predecessors,
+                                     std::vector<std::vector<tchecker::loc_id_t>> const & targets)
+    {
+      _distances.assign(targets.size() * _locations_count, tchecker::distances::INF_DISTANCE);
+      
+      std::deque<tchecker::loc_id_t> waiting;
+      for (std::size_t rank = 0; rank < targets.size(); ++rank) {
+        tchecker::distances::distance_t * distances = _distances.data() + rank * _locations_count;
+        
+        for (tchecker::loc_id_t id : targets[rank]) {
+          distances[id] = 0;
+          waiting.push_back(id);
+        }
+        
+        while (! waiting.empty()) {
+          tchecker::loc_id_t id = waiting.front();
+          waiting.pop_front();
+          for (tchecker::loc_id_t pred : predecessors[id])
+            if (distances[pred] == tchecker::distances::INF_DISTANCE) {
+              distances[pred] = distances[id] + 1;
+              waiting.push_back(pred);
+            }
+        }
+      }
+    }
+    
+  } // end of namespace distances
+  
+} // end of namespace tchecker
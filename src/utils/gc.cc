@@ -5,18 +5,44 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 #include "tchecker/utils/gc.hh"
 
 namespace tchecker {
   
-  gc_t::gc_t() : _stop(true), _thread(nullptr)
+  gc_t::gc_t() : gc_t(tchecker::gc_t::DEFAULT_PERIOD)
   {}
   
   
+  gc_t::gc_t(std::chrono::milliseconds period)
+  : _period(period),
+  _stop(true),
+  _requested(false),
+  _thread(nullptr),
+  _collections(0),
+  _collected_chunks(0),
+  _collection_time(0),
+  _peak_memsize(0)
+  {
+    if (_period.count() <= 0)
+      throw std::invalid_argument("garbage collection period should be positive");
+  }
+  
+  
   gc_t::gc_t(tchecker::gc_t && gc)
-  : _functions(std::move(gc._functions)), _stop(gc._stop), _thread(gc._thread)
+  : _functions(std::move(gc._functions)),
+  _memsizes(std::move(gc._memsizes)),
+  _period(gc._period),
+  _stop(gc._stop.load()),
+  _requested(false),
+  _thread(gc._thread),
+  _collections(gc._collections.load()),
+  _collected_chunks(gc._collected_chunks.load()),
+  _collection_time(gc._collection_time.load()),
+  _peak_memsize(gc._peak_memsize.load())
   {
     gc._stop = true;
     gc._thread = nullptr;
@@ -34,8 +60,15 @@ namespace tchecker {
   {
     if (this != &gc) {
       _functions = std::move(gc._functions);
-      _stop = gc._stop;
+      _memsizes = std::move(gc._memsizes);
+      _period = gc._period;
+      _stop = gc._stop.load();
+      _requested = false;
       _thread = gc._thread;
+      _collections = gc._collections.load();
+      _collected_chunks = gc._collected_chunks.load();
+      _collection_time = gc._collection_time.load();
+      _peak_memsize = gc._peak_memsize.load();
       gc._stop = true;
       gc._thread = nullptr;
     }
@@ -43,26 +76,64 @@ namespace tchecker {
   }
   
   
-  void gc_t::enroll(std::function<void(void)> && f)
+  void gc_t::enroll(std::function<std::size_t(void)> && collect, std::function<std::size_t(void)> && memsize)
   {
     if (_thread != nullptr)
       throw std::runtime_error("cannot enroll when garbage collection is running");
-    _functions.push_back(std::forward<std::function<void(void)>>(f));
+    _functions.push_back(std::move(collect));
+    _memsizes.push_back(std::move(memsize));
   }
   
   
-  void gc_t::collect() const
+  void gc_t::collect()
   {
+    std::unique_lock<std::mutex> lock(_mutex);
     while (true) {
+      _cv.wait_for(lock, _period, [&] () { return _stop || _requested; });
       if (_stop)    // ensures stopping (empty list of functions)
         return;
+      _requested = false;
       
-      for (auto & f : _functions) {
-        if (_stop)  // earlier termination (optimization)
-          return;
-        f();
-      }
+      lock.unlock();  // enrolled pools may request a collection meanwhile
+      collect_once();
+      lock.lock();
+    }
+  }
+  
+  
+  void gc_t::collect_once()
+  {
+    auto const start_time = std::chrono::steady_clock::now();
+    
+    unsigned long collected = 0;
+    for (auto & f : _functions) {
+      if (_stop)  // earlier termination (optimization)
+        break;
+      collected += f();
     }
+    
+    auto const time = std::chrono::steady_clock::now() - start_time;
+    
+    std::size_t memsize = 0;
+    for (auto & m : _memsizes)
+      memsize += m();
+    
+    _collections.fetch_add(1, std::memory_order_relaxed);
+    _collected_chunks.fetch_add(collected, std::memory_order_relaxed);
+    _collection_time.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+                               std::memory_order_relaxed);
+    if (memsize > _peak_memsize.load(std::memory_order_relaxed))
+      _peak_memsize.store(memsize, std::memory_order_relaxed);
+  }
+  
+  
+  void gc_t::request_collection()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _requested = true;
+    }
+    _cv.notify_one();
   }
   
   
@@ -71,6 +142,7 @@ namespace tchecker {
     assert(_stop == (_thread == nullptr));
     if (_thread == nullptr) {
       _stop = false;
+      _requested = false;
       _thread = new std::thread(&tchecker::gc_t::collect, this);
     }
     assert(_stop == false);
@@ -82,7 +154,11 @@ namespace tchecker {
   {
     assert(_stop == (_thread == nullptr));
     if (_thread != nullptr) {
-      _stop = true;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _cv.notify_one();
       _thread->join();
       delete _thread;
       _thread = nullptr;
@@ -91,4 +167,10 @@ namespace tchecker {
     assert(_stop == true);
   }
   
+  
+  double gc_t::collection_time() const
+  {
+    return std::chrono::duration<double>(std::chrono::nanoseconds(_collection_time.load(std::memory_order_relaxed))).count();
+  }
+  
 } // end of namespace tchecker
@@ -38,7 +38,74 @@ namespace tchecker {
   }
   
   
-  std::ostream & output(std::ostream & os, tchecker::intvars_valuation_t const & intvars_val,
+  /* intvars_packing_t */
+  
+  intvars_packing_t::intvars_packing_t(tchecker::flat_integer_variables_t const & intvars)
+  : _packed_size(0)
+  {
+    std::size_t const size = intvars.flattened_size();
+    unsigned int bits = 0; // bits used in the last cell
+    
+    _fields.reserve(size);
+    for (tchecker::intvar_id_t id = 0; id < size; ++id) {
+      tchecker::intvar_info_t const & info = intvars.info(id);
+      cell_t const range = static_cast<cell_t>(static_cast<cell_t>(info.max()) - static_cast<cell_t>(info.min()));
+      
+      unsigned int width = 0;
+      for (cell_t r = range; r != 0; r = static_cast<cell_t>(r >> 1))
+        ++width;
+      
+      if ((_packed_size == 0) || (bits + width > CELL_BITS)) {
+        ++_packed_size;
+        bits = 0;
+      }
+      
+      cell_t const mask = (width == CELL_BITS ? ~static_cast<cell_t>(0)
+                           : static_cast<cell_t>((static_cast<cell_t>(1) << width) - 1));
+      unsigned int const shift = (width == 0 ? 0 : bits); // avoids shifting by CELL_BITS on a full cell
+      _fields.push_back(field_t{_packed_size - 1, shift, mask, range, info.min()});
+      bits += width;
+    }
+  }
+  
+  
+  void intvars_packing_t::pack(tchecker::intvars_valuation_t const & intvars_val,
+                               tchecker::intvars_valuation_t & packed) const
+  {
+    if ((intvars_val.size() < _fields.size()) || (packed.size() < _packed_size))
+      throw std::invalid_argument("valuation is too small");
+    
+    for (std::size_t i = 0; i < _packed_size; ++i)
+      packed[i] = 0;
+    
+    for (std::size_t id = 0; id < _fields.size(); ++id) {
+      field_t const & field = _fields[id];
+      cell_t const value = static_cast<cell_t>(static_cast<cell_t>(intvars_val[id]) - static_cast<cell_t>(field._min));
+      if (value > field._range)
+        throw std::out_of_range("value out of variable domain");
+      packed[field._cell] = static_cast<tchecker::integer_t>(static_cast<cell_t>(packed[field._cell])
+                                                             | static_cast<cell_t>(value << field._shift));
+    }
+  }
+  
+  
+  void intvars_packing_t::unpack(tchecker::intvars_valuation_t const & packed,
+                                 tchecker::intvars_valuation_t & intvars_val) const
+  {
+    if ((packed.size() < _packed_size) || (intvars_val.size() < _fields.size()))
+      throw std::invalid_argument("valuation is too small");
+    
+    for (std::size_t id = 0; id < _fields.size(); ++id) {
+      field_t const & field = _fields[id];
+      cell_t const value = static_cast<cell_t>(static_cast<cell_t>(packed[field._cell]) >> field._shift) & field._mask;
+      intvars_val[id] = static_cast<tchecker::integer_t>(static_cast<cell_t>(value + static_cast<cell_t>(field._min)));
+    }
+  }
+  
+  
+  
+  
+    std::ostream & output(std::ostream & os, tchecker::intvars_valuation_t const & intvars_val,
                         tchecker::intvar_index_t const & index)
   {
     auto const size = index.size();
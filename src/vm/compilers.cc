@@ -11,6 +11,7 @@
 #include "tchecker/expression/type_inference.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/vm/compilers.hh"
+#include "tchecker/vm/optimizer.hh"
 
 namespace tchecker {
   
@@ -289,7 +290,14 @@ namespace tchecker {
       
       
       /*
-       see compile_binary_expression
+       LAND expression:
+       insert expr.left_operand() bytecode
+       VM_RETZ
+       insert expr.right_operand() bytecode
+       VM_LAND
+       VM_RETZ
+       
+       other expressions: see compile_binary_expression
        */
       virtual void visit(tchecker::typed_binary_expression_t const & expr)
       {
@@ -298,7 +306,10 @@ namespace tchecker {
           if (expr.type() != tchecker::EXPR_TYPE_CONJUNCTIVE_FORMULA)
             throw std::invalid_argument("invalid expression");
           
-          compile_binary_expression(expr);
+          expr.left_operand().visit(*this);
+          _bytecode_back_inserter = tchecker::VM_RETZ;   // short-circuit: right operand is not evaluated if left is false
+          expr.right_operand().visit(*this);
+          _bytecode_back_inserter = tchecker::VM_LAND;
           _bytecode_back_inserter = tchecker::VM_RETZ;   // optimization: return as soon as conjunct is false
         }
         // LT, LE, EQ, NEQ, GE, GT expression
@@ -513,6 +524,8 @@ namespace tchecker {
       expr.visit(compiler);
       back_inserter = tchecker::VM_RET;
       
+      tchecker::optimize(bytecode);
+      
       // Production
       if (bytecode.size() == 0)
         throw std::runtime_error("compilation produced no bytecode");
@@ -847,6 +860,8 @@ namespace tchecker {
       back_inserter = 1;                  // ...for statement
       back_inserter = tchecker::VM_RET;
       
+      tchecker::optimize(bytecode);
+      
       if (bytecode.size() == 0)
         throw std::runtime_error("compilation produced no bytecode");
       if (bytecode.back() != tchecker::VM_RET)
@@ -0,0 +1,372 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include <tchecker/config.hh>
+
+#include "tchecker/vm/native.hh"
+
+namespace tchecker {
+
+  namespace details {
+
+    /*!
+     \brief Version of generated code (to be changed whenever code generation changes)
+     */
+    static char const * const native_code_version = "tchecker-native-1";
+
+
+    /*!
+     \brief Accessor
+     \return command for the system C++ compiler: value of environment variable TCHECKER_CXX if
+     set, compiler TChecker has been built with otherwise
+     */
+    static std::string native_compiler()
+    {
+      char const * cxx = std::getenv("TCHECKER_CXX");
+      return ((cxx != nullptr) && (*cxx != '\0') ? cxx : TCHECKER_CXX_COMPILER);
+    }
+
+
+    /*!
+     \brief FNV-1a hash of a sequence of bytes
+     \param h : hash value
+     \param p : pointer to bytes
+     \param size : number of bytes
+     \return h updated with the size bytes from p
+     */
+    static std::uint64_t fnv1a(std::uint64_t h, void const * p, std::size_t size)
+    {
+      unsigned char const * bytes = static_cast<unsigned char const *>(p);
+      for (std::size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ULL;
+      }
+      return h;
+    }
+
+
+    /*!
+     \brief Hash of native code
+     \param bytecodes : sequence of bytecodes
+     \param compiler : compiler command
+     \return hash of bytecodes, compiler and generated code version
+     */
+    static std::uint64_t native_code_hash(std::vector<tchecker::bytecode_t const *> const & bytecodes,
+                                          std::string const & compiler)
+    {
+      std::uint64_t h = 14695981039346656037ULL;
+      std::string const version = tchecker::details::native_code_version;
+      h = tchecker::details::fnv1a(h, version.c_str(), version.size() + 1);
+      std::size_t const integer_size = sizeof(tchecker::integer_t);
+      h = tchecker::details::fnv1a(h, &integer_size, sizeof(integer_size));
+      h = tchecker::details::fnv1a(h, compiler.c_str(), compiler.size() + 1);
+      for (tchecker::bytecode_t const * bytecode : bytecodes) {
+        tchecker::bytecode_t const * begin = bytecode;
+        while (*bytecode != tchecker::VM_RET)
+          bytecode += 1 + tchecker::instruction_parameters_count(*bytecode);
+        h = tchecker::details::fnv1a(h, begin, (bytecode - begin + 1) * sizeof(tchecker::bytecode_t));
+      }
+      return h;
+    }
+
+
+    /*!
+     \brief Output a literal
+     \param os : output stream
+     \param v : value
+     \post v has been output to os as a long long literal
+     \return os after output
+     */
+    static std::ostream & literal(std::ostream & os, tchecker::bytecode_t v)
+    {
+      if (v == std::numeric_limits<long long>::min())
+        return os << "(" << v + 1 << "LL - 1)";
+      return os << "(" << v << "LL)";
+    }
+
+
+    /*!
+     \brief Code generation for a bytecode
+     \param os : output stream
+     \param name : name of the function
+     \param bytecode : bytecode
+     \pre bytecode has been checked by tchecker::check_bytecode
+     \post the definition of a static function name that computes the same as
+     bytecode has been output to os (see tchecker::native_code_t::function_t)
+     \return os after output
+     \note the VM stack is translated to local variables s0, s1, ...
+     since the height of the stack is statically known at each instruction
+     */
+    static std::ostream & generate_function(std::ostream & os, std::string const & name,
+                                            tchecker::bytecode_t const * bytecode)
+    {
+      std::ostringstream body;
+      std::size_t sp = 0, max_sp = 0;
+
+      auto s = [&] (std::size_t k) { return "s" + std::to_string(k); };
+      auto top = [&] (std::size_t k) {
+        if (k > sp)
+          throw std::invalid_argument("stack underflow");
+        return s(sp - k);
+      };
+      auto push = [&] () { max_sp = std::max(max_sp, ++sp); return s(sp - 1); };
+      auto binary = [&] (char const * op) {
+        body << "  " << top(2) << " = (" << top(2) << " " << op << " " << top(1) << ");\n";
+        --sp;
+      };
+      auto compare_vc = [&] (char const * op) {
+        body << "  " << push() << " = (v[" << bytecode[1] << "] " << op << " ";
+        tchecker::details::literal(body, bytecode[2]) << ");\n";
+      };
+
+      for (bool ret = false; ! ret; bytecode += 1 + tchecker::instruction_parameters_count(*bytecode)) {
+        switch (*bytecode) {
+          case VM_RET:
+            body << "  *result = " << top(1) << ";\n  return 0;\n";
+            ret = true;
+            break;
+          case VM_RETZ:
+            body << "  if (" << top(1) << " == 0) { *result = 0; return 0; }\n";
+            break;
+          case VM_FAILNOTIN:
+            body << "  if ((" << top(1) << " < ";
+            tchecker::details::literal(body, bytecode[1]) << ") || (" << top(1) << " > ";
+            tchecker::details::literal(body, bytecode[2]) << ")) return 1;\n";
+            break;
+          case VM_PUSH:
+            body << "  " << push() << " = static_cast<integer_t>";
+            tchecker::details::literal(body, bytecode[1]) << ";\n";
+            break;
+          case VM_VALUEAT:
+            body << "  " << top(1) << " = v[" << top(1) << "];\n";
+            break;
+          case VM_ASSIGN:
+            body << "  v[" << top(2) << "] = " << top(1) << ";\n";
+            sp -= 2;
+            break;
+          case VM_LAND:   binary("&&"); break;
+          case VM_MINUS:  binary("-");  break;
+          case VM_DIV:    binary("/");  break;
+          case VM_EQ:     binary("=="); break;
+          case VM_GE:     binary(">="); break;
+          case VM_GT:     binary(">");  break;
+          case VM_LT:     binary("<");  break;
+          case VM_LE:     binary("<="); break;
+          case VM_MUL:    binary("*");  break;
+          case VM_MOD:    binary("%");  break;
+          case VM_NE:     binary("!="); break;
+          case VM_SUM:    binary("+");  break;
+          case VM_NEG:
+            body << "  " << top(1) << " = - " << top(1) << ";\n";
+            break;
+          case VM_LNOT:
+            body << "  " << top(1) << " = ! " << top(1) << ";\n";
+            break;
+          case VM_CLKCONSTR:
+            body << "  e->clkconstr(clkconstr, static_cast<clock_id_t>(" << top(3) << "), static_cast<clock_id_t>("
+            << top(2) << "), " << (bytecode[1] == 0 ? 0 : 1) << ", " << top(1) << ");\n";
+            sp -= 3;
+            break;
+          case VM_CLKRESET:
+            body << "  e->clkreset(clkreset, static_cast<clock_id_t>(" << top(3) << "), static_cast<clock_id_t>("
+            << top(2) << "), " << top(1) << ");\n";
+            sp -= 3;
+            break;
+          case VM_VALUEOF:
+            body << "  " << push() << " = v[" << bytecode[1] << "];\n";
+            break;
+          case VM_EQVC:   compare_vc("=="); break;
+          case VM_NEVC:   compare_vc("!="); break;
+          case VM_LTVC:   compare_vc("<");  break;
+          case VM_LEVC:   compare_vc("<="); break;
+          case VM_GEVC:   compare_vc(">="); break;
+          case VM_GTVC:   compare_vc(">");  break;
+          case VM_ASSIGNVC:
+            body << "  v[" << bytecode[1] << "] = static_cast<integer_t>";
+            tchecker::details::literal(body, bytecode[2]) << ";\n";
+            break;
+          case VM_CLKCONSTRC:
+            body << "  e->clkconstr(clkconstr, " << bytecode[1] << "U, " << bytecode[2] << "U, "
+            << (bytecode[4] == 0 ? 0 : 1) << ", static_cast<integer_t>";
+            tchecker::details::literal(body, bytecode[3]) << ");\n";
+            body << "  " << push() << " = 1;\n";
+            break;
+          case VM_CLKRESETC:
+            body << "  e->clkreset(clkreset, " << bytecode[1] << "U, " << bytecode[2] << "U, static_cast<integer_t>";
+            tchecker::details::literal(body, bytecode[3]) << ");\n";
+            break;
+          case VM_NOP:
+            break;
+          default:
+            throw std::invalid_argument("unknown instruction");
+        }
+      }
+
+      os << "static int " << name
+      << "(integer_t * v, void * clkconstr, void * clkreset, emitters_t const * e, integer_t * result)\n{\n";
+      for (std::size_t k = 0; k < max_sp; ++k)
+        os << "  integer_t " << s(k) << ";\n";
+      os << body.str() << "}\n\n";
+      return os;
+    }
+
+
+    /*!
+     \brief Clock constraints emitter
+     \param clkconstr : pointer to a tchecker::clock_constraint_container_t
+     \param id1 : first clock
+     \param id2 : second clock
+     \param cmp : comparator (0 for <, <= otherwise)
+     \param value : bound
+     \post clock constraint id1 - id2 # value has been pushed into clkconstr
+     */
+    static void emit_clkconstr(void * clkconstr, tchecker::clock_id_t id1, tchecker::clock_id_t id2, int cmp,
+                               tchecker::integer_t value)
+    {
+      static_cast<tchecker::clock_constraint_container_t *>(clkconstr)->emplace_back
+      (id1, id2, (cmp == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE), value);
+    }
+
+
+    /*!
+     \brief Clock resets emitter
+     \param clkreset : pointer to a tchecker::clock_reset_container_t
+     \param id1 : first clock
+     \param id2 : second clock
+     \param value : value
+     \post clock reset id1 := id2 + value has been pushed into clkreset
+     */
+    static void emit_clkreset(void * clkreset, tchecker::clock_id_t id1, tchecker::clock_id_t id2,
+                              tchecker::integer_t value)
+    {
+      static_cast<tchecker::clock_reset_container_t *>(clkreset)->emplace_back(id1, id2, value);
+    }
+
+  } // end of namespace details
+
+
+
+
+  /* native_code_t */
+
+  tchecker::native_code_t::emitters_t const
+  tchecker::native_code_t::_emitters{&tchecker::details::emit_clkconstr, &tchecker::details::emit_clkreset};
+
+
+  native_code_t::native_code_t(std::vector<tchecker::bytecode_t const *> const & bytecodes,
+                               std::string const & cache_dir)
+  : _handle(nullptr), _cached(true)
+  {
+    std::string const compiler = tchecker::details::native_compiler();
+
+    std::ostringstream hash;
+    hash << std::hex << tchecker::details::native_code_hash(bytecodes, compiler);
+
+    std::filesystem::path const dir(cache_dir.empty() ? "." : cache_dir);
+    std::filesystem::path const library = dir / ("tchecker-native-" + hash.str() + ".so");
+
+    if ( ! std::filesystem::exists(library) ) {
+      _cached = false;
+
+      std::error_code ec;
+      std::filesystem::create_directories(dir, ec);
+      if (ec)
+        throw std::runtime_error("cannot create native code cache directory " + dir.string() + ": " + ec.message());
+
+      // Temporary files are private to this process, then the library is atomically moved
+      // to the cache, hence concurrent runs may safely share the cache directory
+      std::string const tmp = "tchecker-native-" + hash.str() + "." + std::to_string(::getpid());
+      std::filesystem::path const source = dir / (tmp + ".cc");
+      std::filesystem::path const tmp_library = dir / (tmp + ".so");
+
+      for (std::string const & path : {source.string(), tmp_library.string()})
+        if (path.find('\'') != std::string::npos)
+          throw std::runtime_error("invalid native code cache directory " + dir.string());
+
+      {
+        std::ofstream ofs(source);
+        tchecker::native_code_t::generate(ofs, bytecodes);
+        if ( ! ofs )
+          throw std::runtime_error("cannot write native code to " + source.string());
+      }
+
+      std::string const command = compiler + " -std=c++11 -O2 -w -shared -fPIC -o '" + tmp_library.string() + "' '"
+      + source.string() + "'";
+      int const status = std::system(command.c_str());
+      std::filesystem::remove(source, ec);
+      if (status != 0) {
+        std::filesystem::remove(tmp_library, ec);
+        throw std::runtime_error("native code compilation failed: " + command);
+      }
+
+      std::filesystem::rename(tmp_library, library, ec);
+      if (ec) {
+        std::filesystem::remove(tmp_library, ec);
+        throw std::runtime_error("cannot store native code in " + library.string());
+      }
+    }
+
+    _handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (_handle == nullptr)
+      throw std::runtime_error("cannot load native code " + library.string() + ": " + ::dlerror());
+
+    auto functions = reinterpret_cast<function_t const *>(::dlsym(_handle, "tchecker_native_functions"));
+    if (functions != nullptr) {
+      for ( ; (*functions != nullptr) && (_functions.size() < bytecodes.size()); ++functions)
+        _functions.push_back(*functions);
+    }
+    if ((functions == nullptr) || (*functions != nullptr) || (_functions.size() != bytecodes.size())) {
+      ::dlclose(_handle);
+      throw std::runtime_error("invalid native code " + library.string());
+    }
+  }
+
+
+  native_code_t::~native_code_t()
+  {
+    ::dlclose(_handle);
+  }
+
+
+  std::ostream & native_code_t::generate(std::ostream & os,
+                                         std::vector<tchecker::bytecode_t const *> const & bytecodes)
+  {
+    os << "// Generated by TChecker (" << tchecker::details::native_code_version << "), do not edit\n\n";
+    os << "#include <cstdint>\n\n";
+    os << "typedef std::int" << 8 * sizeof(tchecker::integer_t) << "_t integer_t;\n";
+    os << "typedef std::uint32_t clock_id_t;\n\n";
+    os << "struct emitters_t {\n";
+    os << "  void (*clkconstr)(void *, clock_id_t, clock_id_t, int, integer_t);\n";
+    os << "  void (*clkreset)(void *, clock_id_t, clock_id_t, integer_t);\n";
+    os << "};\n\n";
+    os << "typedef int (*function_t)(integer_t *, void *, void *, emitters_t const *, integer_t *);\n\n";
+
+    for (std::size_t i = 0; i < bytecodes.size(); ++i)
+      tchecker::details::generate_function(os, "f" + std::to_string(i), bytecodes[i]);
+
+    os << "extern \"C\" function_t const tchecker_native_functions[] = {\n";
+    for (std::size_t i = 0; i < bytecodes.size(); ++i)
+      os << "  f" << i << ",\n";
+    os << "  nullptr\n};\n";
+    return os;
+  }
+
+} // end of namespace tchecker
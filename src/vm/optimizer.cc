@@ -0,0 +1,260 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include "tchecker/vm/optimizer.hh"
+
+namespace tchecker {
+  
+  namespace details {
+    
+    /*!
+     \class decoded_instruction_t
+     \brief Bytecode instruction along with its parameters
+     */
+    struct decoded_instruction_t {
+      tchecker::bytecode_t instruction;   /*!< Instruction */
+      tchecker::bytecode_t params[4];     /*!< Parameters (if any) */
+    };
+    
+    
+    /*!
+     \brief Check integer values
+     \param v : value
+     \return true if v can be represented by tchecker::integer_t, false otherwise
+     */
+    static inline bool is_integer(tchecker::bytecode_t v)
+    {
+      return ((v >= std::numeric_limits<tchecker::integer_t>::min())
+              && (v <= std::numeric_limits<tchecker::integer_t>::max()));
+    }
+    
+    
+    /*!
+     \brief Constant folding of binary operators
+     \param instruction : an instruction
+     \param left : left operand
+     \param right : right operand
+     \param result : result
+     \post result is the value computed by instruction on left and right if true is returned, and it is
+     unchanged otherwise
+     \return true if instruction is a binary operator that can be computed on left and right without
+     overflow nor division by zero, false otherwise
+     */
+    static bool fold(tchecker::bytecode_t instruction, tchecker::bytecode_t left, tchecker::bytecode_t right,
+                     tchecker::bytecode_t & result)
+    {
+      if ( ! is_integer(left) || ! is_integer(right) )
+        return false;
+      
+      tchecker::bytecode_t r = 0;
+      switch (instruction) {
+        case VM_LAND:   r = (left && right);  break;
+        case VM_MINUS:  r = left - right;     break;
+        case VM_EQ:     r = (left == right);  break;
+        case VM_GE:     r = (left >= right);  break;
+        case VM_GT:     r = (left > right);   break;
+        case VM_LT:     r = (left < right);   break;
+        case VM_LE:     r = (left <= right);  break;
+        case VM_MUL:    r = left * right;     break;
+        case VM_NE:     r = (left != right);  break;
+        case VM_SUM:    r = left + right;     break;
+        case VM_DIV:
+          if (right == 0)
+            return false;
+          r = left / right;
+          break;
+        case VM_MOD:
+          if (right == 0)
+            return false;
+          r = left % right;
+          break;
+        default:
+          return false;
+      }
+      
+      if ( ! is_integer(r) )
+        return false;
+      result = r;
+      return true;
+    }
+    
+    
+    /*!
+     \brief Accessor
+     \param instruction : an instruction
+     \param swap : true if the operands of instruction are swapped
+     \return superinstruction that compares a variable to a constant w.r.t. instruction,
+     VM_NOP if instruction is not a comparison
+     */
+    static tchecker::bytecode_t compare_vc(tchecker::bytecode_t instruction, bool swap)
+    {
+      switch (instruction) {
+        case VM_EQ:  return VM_EQVC;
+        case VM_NE:  return VM_NEVC;
+        case VM_LT:  return (swap ? VM_GTVC : VM_LTVC);
+        case VM_LE:  return (swap ? VM_GEVC : VM_LEVC);
+        case VM_GE:  return (swap ? VM_LEVC : VM_GEVC);
+        case VM_GT:  return (swap ? VM_LTVC : VM_GTVC);
+        default:     return VM_NOP;
+      }
+    }
+    
+    
+    /*!
+     \brief Peephole rewriting
+     \param code : sequence of instructions
+     \param i : position in code
+     \post the first rewriting rule that matches code at position i has been applied (if any)
+     \return true if a rewriting rule has been applied, false otherwise
+     */
+    static bool rewrite(std::vector<tchecker::details::decoded_instruction_t> & code, std::size_t i)
+    {
+      auto const at = [&] (std::size_t k) -> tchecker::bytecode_t {
+        return (i + k < code.size() ? code[i + k].instruction : VM_RET);
+      };
+      auto const replace = [&] (std::size_t count, tchecker::details::decoded_instruction_t const & instr) {
+        code.erase(code.begin() + i + 1, code.begin() + i + count);
+        code[i] = instr;
+      };
+      auto const param = [&] (std::size_t k) -> tchecker::bytecode_t {
+        return code[i + k].params[0];
+      };
+      
+      tchecker::details::decoded_instruction_t const & c = code[i];
+      tchecker::bytecode_t r = 0;
+      
+      // NOP ~> (nothing)
+      if (c.instruction == VM_NOP) {
+        code.erase(code.begin() + i);
+        return true;
+      }
+      
+      // RETZ RETZ ~> RETZ
+      if ((c.instruction == VM_RETZ) && (at(1) == VM_RETZ)) {
+        code.erase(code.begin() + i + 1);
+        return true;
+      }
+      
+      if (c.instruction == VM_PUSH) {
+        // PUSH a PUSH b op ~> PUSH (a op b)
+        if ((at(1) == VM_PUSH) && fold(at(2), c.params[0], param(1), r)) {
+          replace(3, {VM_PUSH, {r}});
+          return true;
+        }
+        
+        // PUSH a NEG ~> PUSH (-a)
+        if ((at(1) == VM_NEG) && is_integer(c.params[0]) && is_integer(- c.params[0])) {
+          replace(2, {VM_PUSH, {- c.params[0]}});
+          return true;
+        }
+        
+        // PUSH a LNOT ~> PUSH (!a)
+        if (at(1) == VM_LNOT) {
+          replace(2, {VM_PUSH, {! c.params[0]}});
+          return true;
+        }
+        
+        // PUSH a FAILNOTIN l h ~> PUSH a     when l <= a <= h
+        if ((at(1) == VM_FAILNOTIN) && (param(1) <= c.params[0]) && (c.params[0] <= code[i + 1].params[1])) {
+          code.erase(code.begin() + i + 1);
+          return true;
+        }
+        
+        // PUSH a RETZ ~> PUSH a     when a != 0
+        if ((at(1) == VM_RETZ) && (c.params[0] != 0)) {
+          code.erase(code.begin() + i + 1);
+          return true;
+        }
+        
+        // PUSH x VALUEAT ~> VALUEOF x
+        if (at(1) == VM_VALUEAT) {
+          replace(2, {VM_VALUEOF, {c.params[0]}});
+          return true;
+        }
+        
+        // PUSH x PUSH c ASSIGN ~> ASSIGNVC x c
+        if ((at(1) == VM_PUSH) && (at(2) == VM_ASSIGN)) {
+          replace(3, {VM_ASSIGNVC, {c.params[0], param(1)}});
+          return true;
+        }
+        
+        // PUSH x1 PUSH x2 PUSH c CLKCONSTR s PUSH 1 ~> CLKCONSTRC x1 x2 c s
+        if ((at(1) == VM_PUSH) && (at(2) == VM_PUSH) && (at(3) == VM_CLKCONSTR) && (at(4) == VM_PUSH) && (param(4) == 1)) {
+          replace(5, {VM_CLKCONSTRC, {c.params[0], param(1), param(2), param(3)}});
+          return true;
+        }
+        
+        // PUSH x1 PUSH x2 PUSH c CLKRESET ~> CLKRESETC x1 x2 c
+        if ((at(1) == VM_PUSH) && (at(2) == VM_PUSH) && (at(3) == VM_CLKRESET)) {
+          replace(4, {VM_CLKRESETC, {c.params[0], param(1), param(2)}});
+          return true;
+        }
+        
+        // PUSH c VALUEOF x cmp ~> cmpVC x c     (with swapped comparison)
+        if ((at(1) == VM_VALUEOF) && (compare_vc(at(2), true) != VM_NOP)) {
+          replace(3, {compare_vc(at(2), true), {param(1), c.params[0]}});
+          return true;
+        }
+      }
+      
+      // CLKCONSTRC x1 x2 c s RETZ ~> CLKCONSTRC x1 x2 c s     (pushes 1)
+      if ((c.instruction == VM_CLKCONSTRC) && (at(1) == VM_RETZ)) {
+        code.erase(code.begin() + i + 1);
+        return true;
+      }
+      
+      // VALUEOF x PUSH c cmp ~> cmpVC x c
+      if ((c.instruction == VM_VALUEOF) && (at(1) == VM_PUSH) && (compare_vc(at(2), false) != VM_NOP)) {
+        replace(3, {compare_vc(at(2), false), {c.params[0], param(1)}});
+        return true;
+      }
+      
+      return false;
+    }
+    
+  } // end of namespace details
+  
+  
+  
+  
+  void optimize(std::vector<tchecker::bytecode_t> & bytecode)
+  {
+    // decode
+    std::vector<tchecker::details::decoded_instruction_t> code;
+    for (std::size_t i = 0; i < bytecode.size(); ++i) {
+      tchecker::details::decoded_instruction_t instr{bytecode[i], {0, 0, 0, 0}};
+      std::size_t const count = tchecker::instruction_parameters_count(bytecode[i]);
+      if (i + count >= bytecode.size())
+        throw std::invalid_argument("missing instruction parameters");
+      for (std::size_t k = 0; k < count; ++k)
+        instr.params[k] = bytecode[++i];
+      code.push_back(instr);
+    }
+    
+    // rewrite until fixpoint (each rewriting shortens code)
+    bool rewritten = true;
+    while (rewritten) {
+      rewritten = false;
+      for (std::size_t i = 0; i < code.size(); ++i)
+        while ((i < code.size()) && tchecker::details::rewrite(code, i))
+          rewritten = true;
+    }
+    
+    // encode
+    bytecode.clear();
+    for (tchecker::details::decoded_instruction_t const & instr : code) {
+      bytecode.push_back(instr.instruction);
+      std::size_t const count = tchecker::instruction_parameters_count(instr.instruction);
+      for (std::size_t k = 0; k < count; ++k)
+        bytecode.push_back(instr.params[k]);
+    }
+  }
+  
+} // end of namespace tchecker
@@ -5,7 +5,10 @@
  *
  */
 
+#include <algorithm>
 #include <limits>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "tchecker/vm/vm.hh"
@@ -15,6 +18,34 @@ namespace tchecker {
   /* bytecode_t */
   
   
+  std::size_t instruction_parameters_count(tchecker::bytecode_t instruction)
+  {
+    switch (instruction) {
+      case VM_PUSH:
+      case VM_CLKCONSTR:
+      case VM_VALUEOF:
+        return 1;
+      case VM_FAILNOTIN:
+      case VM_EQVC:
+      case VM_NEVC:
+      case VM_LTVC:
+      case VM_LEVC:
+      case VM_GEVC:
+      case VM_GTVC:
+      case VM_ASSIGNVC:
+        return 2;
+      case VM_CLKRESETC:
+        return 3;
+      case VM_CLKCONSTRC:
+        return 4;
+      default:
+        if ((instruction < 0) || (instruction > VM_NOP))
+          throw std::invalid_argument("unknown instruction");
+        return 0;
+    }
+  }
+  
+  
   std::ostream & output(std::ostream & os, tchecker::bytecode_t const * bytecode)
   {
     for (bool ret = false; ! ret; ++bytecode) {
@@ -116,6 +147,84 @@ namespace tchecker {
           os << "CLKRESET";
           break;
           
+        case VM_VALUEOF:
+          os << "VALUEOF";
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_EQVC:
+          os << "EQVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_NEVC:
+          os << "NEVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_LTVC:
+          os << "LTVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_LEVC:
+          os << "LEVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_GEVC:
+          os << "GEVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_GTVC:
+          os << "GTVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_ASSIGNVC:
+          os << "ASSIGNVC";
+          ++bytecode;
+          os << " " << *bytecode;
+          ++bytecode;
+          os << " " << *bytecode;
+          break;
+          
+        case VM_CLKCONSTRC:
+          os << "CLKCONSTRC";
+          for (int i = 0; i < 4; ++i) {
+            ++bytecode;
+            os << " " << *bytecode;
+          }
+          break;
+          
+        case VM_CLKRESETC:
+          os << "CLKRESETC";
+          for (int i = 0; i < 3; ++i) {
+            ++bytecode;
+            os << " " << *bytecode;
+          }
+          break;
+          
         case VM_NOP:
           os << "NOP";
           break;
@@ -129,4 +238,253 @@ namespace tchecker {
     return os;
   }
   
+  
+  
+  
+  /* check_bytecode */
+  
+  namespace details {
+    
+    /*!
+     \class value_interval_t
+     \brief Interval of values on the stack of the VM
+     */
+    struct value_interval_t {
+      tchecker::bytecode_t min;   /*!< Lower bound */
+      tchecker::bytecode_t max;   /*!< Upper bound */
+    };
+    
+    
+    /*!
+     \brief Interval of integer values
+     */
+    static tchecker::details::value_interval_t const integers{std::numeric_limits<tchecker::integer_t>::min(),
+      std::numeric_limits<tchecker::integer_t>::max()};
+    
+    
+    /*!
+     \brief Interval of Boolean values
+     */
+    static tchecker::details::value_interval_t const booleans{0, 1};
+    
+    
+    /*!
+     \brief Check integer values
+     \param v : value
+     \return true if v can be represented by tchecker::integer_t, false otherwise
+     */
+    static inline bool is_integer(tchecker::bytecode_t v)
+    {
+      return ((v >= tchecker::details::integers.min) && (v <= tchecker::details::integers.max));
+    }
+    
+    
+    /*!
+     \brief Integer interval
+     \param min : lower bound
+     \param max : upper bound
+     \return [min,max] if it is included in integers, integers otherwise (overflow)
+     */
+    static inline tchecker::details::value_interval_t integer_interval(tchecker::bytecode_t min, tchecker::bytecode_t max)
+    {
+      if (tchecker::details::is_integer(min) && tchecker::details::is_integer(max))
+        return tchecker::details::value_interval_t{min, max};
+      return tchecker::details::integers;
+    }
+    
+    
+    /*!
+     \brief Check variable IDs
+     \param ids : interval of IDs
+     \param size : number of variables
+     \param what : kind of variables
+     \throw std::invalid_argument : if ids is not included in 0..size-1
+     */
+    static void check_ids(tchecker::details::value_interval_t const & ids, std::size_t size, std::string const & what)
+    {
+      if ((ids.min < 0) || (static_cast<std::size_t>(ids.max) >= size))
+        throw std::invalid_argument(what + " ID cannot be proved within bounds");
+    }
+    
+  } // end of namespace details
+  
+  
+  std::size_t check_bytecode(tchecker::bytecode_t const * bytecode,
+                             std::size_t flat_intvars_size,
+                             std::size_t flat_clocks_size)
+  {
+    std::vector<tchecker::details::value_interval_t> stack;
+    std::size_t stack_size = 0;
+    
+    auto pop = [&] () {
+      if (stack.empty())
+        throw std::invalid_argument("stack underflow");
+      tchecker::details::value_interval_t const top = stack.back();
+      stack.pop_back();
+      return top;
+    };
+    
+    auto push = [&] (tchecker::details::value_interval_t const & v) {
+      stack.push_back(v);
+      stack_size = std::max(stack_size, stack.size());
+    };
+    
+    for ( ; ; ++bytecode) {
+      switch (*bytecode) {
+        case VM_RET:
+          pop();
+          if ( ! stack.empty() )
+            throw std::invalid_argument("non-empty stack on return");
+          return stack_size;
+          
+        case VM_RETZ:
+          push(pop());
+          break;
+          
+        case VM_FAILNOTIN:
+        {
+          tchecker::bytecode_t const l = * ++bytecode;
+          tchecker::bytecode_t const h = * ++bytecode;
+          if ( ! tchecker::details::is_integer(l) || ! tchecker::details::is_integer(h) )
+            throw std::invalid_argument("bounds cannot be represented by integers");
+          tchecker::details::value_interval_t v = pop();
+          v.min = std::max(v.min, l);
+          v.max = std::min(v.max, h);
+          // otherwise, VM_FAILNOTIN always fails
+          push((v.min <= v.max) ? v : tchecker::details::value_interval_t{l, h});
+          break;
+        }
+          
+        case VM_PUSH:
+        {
+          tchecker::bytecode_t const v = * ++bytecode;
+          if ( ! tchecker::details::is_integer(v) )
+            throw std::invalid_argument("value cannot be represented by an integer");
+          push(tchecker::details::value_interval_t{v, v});
+          break;
+        }
+          
+        case VM_VALUEAT:
+          tchecker::details::check_ids(pop(), flat_intvars_size, "integer variable");
+          push(tchecker::details::integers);
+          break;
+          
+        case VM_ASSIGN:
+          pop();
+          tchecker::details::check_ids(pop(), flat_intvars_size, "integer variable");
+          break;
+          
+        case VM_SUM:
+        {
+          auto const right = pop();
+          auto const left = pop();
+          push(tchecker::details::integer_interval(left.min + right.min, left.max + right.max));
+          break;
+        }
+          
+        case VM_MINUS:
+        {
+          auto const right = pop();
+          auto const left = pop();
+          push(tchecker::details::integer_interval(left.min - right.max, left.max - right.min));
+          break;
+        }
+          
+        case VM_DIV:
+        case VM_MUL:
+        case VM_MOD:
+          pop();
+          pop();
+          push(tchecker::details::integers);
+          break;
+          
+        case VM_LAND:
+        case VM_EQ:
+        case VM_GE:
+        case VM_GT:
+        case VM_LT:
+        case VM_LE:
+        case VM_NE:
+          pop();
+          pop();
+          push(tchecker::details::booleans);
+          break;
+          
+        case VM_NEG:
+          pop();
+          push(tchecker::details::integers);
+          break;
+          
+        case VM_LNOT:
+          pop();
+          push(tchecker::details::booleans);
+          break;
+          
+        case VM_CLKCONSTR:
+          ++bytecode;
+          pop();
+          tchecker::details::check_ids(pop(), flat_clocks_size, "second clock");
+          tchecker::details::check_ids(pop(), flat_clocks_size, "first clock");
+          break;
+          
+        case VM_CLKRESET:
+          pop();
+          tchecker::details::check_ids(pop(), flat_clocks_size, "second clock");
+          tchecker::details::check_ids(pop(), flat_clocks_size, "first clock");
+          break;
+          
+        case VM_VALUEOF:
+        {
+          tchecker::bytecode_t const x = * ++bytecode;
+          tchecker::details::check_ids(tchecker::details::value_interval_t{x, x}, flat_intvars_size, "integer variable");
+          push(tchecker::details::integers);
+          break;
+        }
+          
+        case VM_EQVC:
+        case VM_NEVC:
+        case VM_LTVC:
+        case VM_LEVC:
+        case VM_GEVC:
+        case VM_GTVC:
+        case VM_ASSIGNVC:
+        {
+          bool const assign = (*bytecode == VM_ASSIGNVC);
+          tchecker::bytecode_t const x = * ++bytecode;
+          tchecker::bytecode_t const c = * ++bytecode;
+          tchecker::details::check_ids(tchecker::details::value_interval_t{x, x}, flat_intvars_size, "integer variable");
+          if ( ! tchecker::details::is_integer(c) )
+            throw std::invalid_argument("value cannot be represented by an integer");
+          if ( ! assign )
+            push(tchecker::details::booleans);
+          break;
+        }
+          
+        case VM_CLKCONSTRC:
+        case VM_CLKRESETC:
+        {
+          bool const constr = (*bytecode == VM_CLKCONSTRC);
+          tchecker::bytecode_t const x1 = * ++bytecode;
+          tchecker::bytecode_t const x2 = * ++bytecode;
+          tchecker::bytecode_t const c = * ++bytecode;
+          if (constr)
+            ++bytecode;
+          tchecker::details::check_ids(tchecker::details::value_interval_t{x1, x1}, flat_clocks_size, "first clock");
+          tchecker::details::check_ids(tchecker::details::value_interval_t{x2, x2}, flat_clocks_size, "second clock");
+          if ( ! tchecker::details::is_integer(c) )
+            throw std::invalid_argument("value cannot be represented by an integer");
+          if (constr)
+            push(tchecker::details::value_interval_t{1, 1});
+          break;
+        }
+          
+        case VM_NOP:
+          break;
+          
+        default:
+          throw std::invalid_argument("unknown instruction");
+      }
+    }
+  }
+  
 } // end of namespace tchecker
@@ -102,6 +102,12 @@ namespace tchecker {
     }
     
     
+    std::uint64_t zone_t::signature() const
+    {
+      return tchecker::dbm::signature(dbm_ptr(), _dim);
+    }
+    
+    
     std::ostream & zone_t::output(std::ostream & os, tchecker::clock_index_t const & index) const
     {
       return tchecker::dbm::output(os, dbm_ptr(), _dim, [&] (tchecker::clock_id_t id) { return index.value(id); });
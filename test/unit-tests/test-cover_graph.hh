@@ -0,0 +1,79 @@
+/*
+* This file is a part of the TChecker project.
+*
+* See files AUTHORS and LICENSE for copyright details.
+*
+*/
+
+#include <iterator>
+#include <vector>
+
+#include "tchecker/graph/cover_graph.hh"
+
+struct cover_test_node_t : public tchecker::graph::cover::node_t {
+  cover_test_node_t(std::size_t key, int value) : _key(key), _value(value) {}
+  std::size_t _key;
+  int _value;
+};
+
+TEST_CASE( "cover graph with growing table" , "[cover_graph]" ) {
+  
+  using graph_t = tchecker::graph::cover::graph_t<cover_test_node_t *>;
+  
+  graph_t graph(2,
+                [] (cover_test_node_t * const & n) { return n->_key; },
+                [] (cover_test_node_t * const & n1, cover_test_node_t * const & n2) {
+                  return (n1->_key == n2->_key) && (n1->_value <= n2->_value);
+                },
+                [] (cover_test_node_t * const & n) {
+                  return (~static_cast<tchecker::graph::cover::signature_t>(0)) << n->_value;
+                },
+                1.0);
+  
+  std::vector<cover_test_node_t> nodes;
+  for (std::size_t i = 0; i < 100; ++i)
+    nodes.emplace_back(i, 1);
+  
+  for (cover_test_node_t & n : nodes)
+    graph.add_node(&n);
+  
+  REQUIRE( graph.nodes_count() == 100 );
+  REQUIRE( graph.table_size() >= 100 );
+  REQUIRE( std::distance(graph.begin(), graph.end()) == 100 );
+  
+  SECTION( "Covering queries after growth" ) {
+    cover_test_node_t * covering_node = nullptr;
+    for (cover_test_node_t & n : nodes) {
+      REQUIRE( graph.is_covered(&n, covering_node) );
+      REQUIRE( covering_node == &n );
+    }
+    
+    cover_test_node_t bigger(42, 2);
+    graph.add_node(&bigger);
+    std::vector<cover_test_node_t *> covered;
+    auto inserter = std::back_inserter(covered);
+    graph.covered_nodes(&bigger, inserter);
+    REQUIRE( covered.size() == 2 );
+    REQUIRE( ((covered[0] == &nodes[42]) || (covered[1] == &nodes[42])) );
+    
+    unsigned long checks = graph.cover_checks();
+    REQUIRE( graph.is_covered(&bigger, covering_node) );
+    REQUIRE( covering_node == &bigger );
+    REQUIRE( graph.cover_checks() == checks + 1 );  // nodes[42] is pruned by signatures
+  }
+  
+  SECTION( "Removal after growth" ) {
+    for (cover_test_node_t & n : nodes)
+      graph.remove_node(&n);
+    REQUIRE( graph.nodes_count() == 0 );
+    REQUIRE( graph.begin() == graph.end() );
+  }
+  
+  SECTION( "Clear" ) {
+    graph.clear();
+    REQUIRE( graph.nodes_count() == 0 );
+    REQUIRE( graph.table_size() == 2 );
+    graph.add_node(&nodes[0]);
+    REQUIRE( graph.nodes_count() == 1 );
+  }
+}
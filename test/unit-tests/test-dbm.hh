@@ -5,6 +5,13 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "tchecker/dbm/dbm.hh"
 
 #define DBM(i,j)       dbm[(i)*dim+(j)]
@@ -1614,3 +1621,230 @@ TEST_CASE( "Zone inclusion w.r.t. abstraction aLU from LICS12", "[dbm]" ) {
     REQUIRE(tchecker::dbm::is_alu_le(dbm_positive, dbm, dim, l_inf, u_inf));
   }
 }
+
+
+
+
+TEST_CASE( "Inclusion signatures", "[dbm]" ) {
+  
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x = 1;
+  tchecker::clock_id_t const y = 2;
+  
+  tchecker::dbm::db_t dbm_positive[dim*dim];
+  tchecker::dbm::universal_positive(dbm_positive, dim);
+  
+  // 1 < x <= 4 & y <= x
+  tchecker::dbm::db_t dbm[dim*dim];
+  tchecker::dbm::universal_positive(dbm, dim);
+  DBM(0,x) = tchecker::dbm::db(tchecker::dbm::LT, -1);
+  DBM(x,0) = tchecker::dbm::db(tchecker::dbm::LE, 4);
+  DBM(y,x) = tchecker::dbm::LE_ZERO;
+  tchecker::dbm::tighten(dbm, dim);
+  
+  SECTION( "Signature of universal positive zone is empty" ) {
+    REQUIRE(tchecker::dbm::signature(dbm_positive, dim) == 0);
+  }
+  
+  SECTION( "Signatures are ordered w.r.t. inclusion" ) {
+    REQUIRE(tchecker::dbm::is_le(dbm, dbm_positive, dim));
+    std::uint64_t sig = tchecker::dbm::signature(dbm, dim);
+    std::uint64_t sig_positive = tchecker::dbm::signature(dbm_positive, dim);
+    REQUIRE((sig_positive & ~sig) == 0);
+    REQUIRE((sig & ~sig_positive) != 0);
+  }
+  
+  SECTION( "Signatures of a zone and a subzone" ) {
+    // 2 <= x <= 3 & y <= x
+    tchecker::dbm::db_t dbm2[dim*dim];
+    std::memcpy(dbm2, dbm, dim * dim * sizeof(*dbm));
+    DBM2(0,x) = tchecker::dbm::db(tchecker::dbm::LE, -2);
+    DBM2(x,0) = tchecker::dbm::db(tchecker::dbm::LE, 3);
+    tchecker::dbm::tighten(dbm2, dim);
+    
+    REQUIRE(tchecker::dbm::is_le(dbm2, dbm, dim));
+    std::uint64_t sig = tchecker::dbm::signature(dbm, dim);
+    std::uint64_t sig2 = tchecker::dbm::signature(dbm2, dim);
+    REQUIRE((sig & ~sig2) == 0);
+  }
+}
+
+
+
+
+TEST_CASE( "Vectorized DBM comparisons and hashing", "[dbm]" ) {
+  
+  std::mt19937 gen(1234);
+  
+  for (tchecker::clock_id_t dim : {1, 2, 3, 4, 5, 7, 12, 20, 40}) {
+    std::size_t const n = dim * dim;
+    
+    // dbm1 : random constraints x <= c, dbm2 : dbm1 with an additional random constraint
+    std::vector<tchecker::dbm::db_t> dbm1(n), dbm2(n), dbm1_copy(n);
+    tchecker::dbm::universal_positive(dbm1.data(), dim);
+    for (tchecker::clock_id_t x = 1; x < dim; ++x)
+      if (gen() % 2 == 0)
+        tchecker::dbm::constrain(dbm1.data(), dim, x, 0, tchecker::dbm::LE, gen() % 20);
+    dbm2 = dbm1;
+    dbm1_copy = dbm1;
+    if (dim > 1)
+      tchecker::dbm::constrain(dbm2.data(), dim, 1 + gen() % (dim - 1), 0, tchecker::dbm::LT, gen() % 10);
+    
+    auto reference_le = [&] (std::vector<tchecker::dbm::db_t> const & d1, std::vector<tchecker::dbm::db_t> const & d2) {
+      for (std::size_t k = 0; k < n; ++k)
+        if (d1[k] > d2[k])
+          return false;
+      return true;
+    };
+    
+    SECTION( "Equality, dim=" + std::to_string(dim) ) {
+      REQUIRE(tchecker::dbm::is_equal(dbm1.data(), dbm1_copy.data(), dim));
+      REQUIRE(tchecker::dbm::is_equal(dbm1.data(), dbm2.data(), dim) == (dbm1 == dbm2));
+    }
+    
+    SECTION( "Inclusion, dim=" + std::to_string(dim) ) {
+      REQUIRE(tchecker::dbm::is_le(dbm2.data(), dbm1.data(), dim));
+      REQUIRE(tchecker::dbm::is_le(dbm1.data(), dbm2.data(), dim) == reference_le(dbm1, dbm2));
+    }
+    
+    SECTION( "Lexical ordering, dim=" + std::to_string(dim) ) {
+      REQUIRE(tchecker::dbm::lexical_cmp(dbm1.data(), dim, dbm1_copy.data(), dim) == 0);
+      int expected = (dbm1 < dbm2 ? -1 : (dbm1 == dbm2 ? 0 : 1));
+      REQUIRE(tchecker::dbm::lexical_cmp(dbm1.data(), dim, dbm2.data(), dim) == expected);
+      REQUIRE(tchecker::dbm::lexical_cmp(dbm2.data(), dim, dbm1.data(), dim) == -expected);
+      
+      std::vector<tchecker::dbm::db_t> dbm3((dim + 1) * (dim + 1));
+      std::copy(dbm1.begin(), dbm1.end(), dbm3.begin());
+      REQUIRE(tchecker::dbm::lexical_cmp(dbm1.data(), dim, dbm3.data(), dim + 1) < 0);
+      REQUIRE(tchecker::dbm::lexical_cmp(dbm3.data(), dim + 1, dbm1.data(), dim) > 0);
+    }
+    
+    SECTION( "Hash, dim=" + std::to_string(dim) ) {
+      REQUIRE(tchecker::dbm::hash(dbm1.data(), dim) == tchecker::dbm::hash(dbm1_copy.data(), dim));
+      if (dbm1 != dbm2)
+        REQUIRE(tchecker::dbm::hash(dbm1.data(), dim) != tchecker::dbm::hash(dbm2.data(), dim));
+    }
+  }
+}
+
+
+
+
+TEST_CASE( "Vectorized DBM tightening", "[dbm]" ) {
+  
+  std::mt19937 gen(4321);
+  
+  // Floyd-Warshall algorithm, returns false as soon as the DBM has a negative diagonal
+  auto reference_tighten = [] (std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim) {
+    for (tchecker::clock_id_t k = 0; k < dim; ++k) {
+      for (tchecker::clock_id_t i = 0; i < dim; ++i)
+        for (tchecker::clock_id_t j = 0; j < dim; ++j)
+          DBM(i,j) = tchecker::dbm::min(DBM(i,j), tchecker::dbm::sum(DBM(i,k), DBM(k,j)));
+      for (tchecker::clock_id_t i = 0; i < dim; ++i)
+        if (DBM(i,i) < tchecker::dbm::LE_ZERO)
+          return false;
+    }
+    return true;
+  };
+  
+  for (tchecker::clock_id_t dim : {2, 3, 5, 9, 17, 40}) {
+    for (int round = 0; round < 20; ++round) {
+      std::vector<tchecker::dbm::db_t> dbm(dim * dim);
+      tchecker::dbm::universal_positive(dbm.data(), dim);
+      for (tchecker::clock_id_t i = 0; i < dim; ++i)
+        for (tchecker::clock_id_t j = 0; j < dim; ++j)
+          if ((i != j) && (gen() % 3 == 0)) {
+            auto cmp = (gen() % 2 == 0 ? tchecker::dbm::LT : tchecker::dbm::LE);
+            tchecker::integer_t value = static_cast<tchecker::integer_t>(gen() % 30) - (i == 0 ? 10 : 5);
+            DBM(i,j) = tchecker::dbm::min(DBM(i,j), tchecker::dbm::db(cmp, value));
+          }
+      
+      std::vector<tchecker::dbm::db_t> expected = dbm;
+      bool const non_empty = reference_tighten(expected, dim);
+      
+      auto status = tchecker::dbm::tighten(dbm.data(), dim);
+      REQUIRE((status == tchecker::dbm::NON_EMPTY) == non_empty);
+      if (non_empty) {
+        REQUIRE(dbm == expected);
+        
+        // incremental tightening after a single constraint x - 0 < 1 (when x has lower bound < 1)
+        tchecker::clock_id_t const x = 1 + gen() % (dim - 1);
+        std::vector<tchecker::dbm::db_t> dbm_x = dbm;
+        auto status_x = tchecker::dbm::constrain(dbm_x.data(), dim, x, 0, tchecker::dbm::LT, 1);
+        std::vector<tchecker::dbm::db_t> expected_x = dbm;
+        expected_x[x * dim] = tchecker::dbm::min(expected_x[x * dim], tchecker::dbm::db(tchecker::dbm::LT, 1));
+        bool const non_empty_x = reference_tighten(expected_x, dim);
+        REQUIRE((status_x == tchecker::dbm::NON_EMPTY) == non_empty_x);
+        if (non_empty_x)
+          REQUIRE(dbm_x == expected_x);
+      }
+    }
+  }
+}
+
+
+
+
+TEST_CASE( "Vectorized zone inclusion w.r.t. abstractions aLU and aM", "[dbm]" ) {
+  
+  std::mt19937 gen(2468);
+  
+  // scalar definition (see "Better abstractions for timed automata", Herbreteau, Srivathsan and Walukiewicz. Inf. Comput., 2016)
+  auto reference_alu_le = [] (std::vector<tchecker::dbm::db_t> const & dbm1, std::vector<tchecker::dbm::db_t> const & dbm2,
+                              tchecker::clock_id_t dim, std::vector<tchecker::integer_t> const & l,
+                              std::vector<tchecker::integer_t> const & u) {
+    for (tchecker::clock_id_t x = 0; x < dim; ++x)
+      for (tchecker::clock_id_t y = 0; y < dim; ++y) {
+        if ((x == y) || (u[x] == - tchecker::dbm::INF_VALUE) || (l[y] == - tchecker::dbm::INF_VALUE))
+          continue;
+        if ((DBM1(0,x) >= tchecker::dbm::db(tchecker::dbm::LE, -u[x])) && (DBM2(y,x) < DBM1(y,x)) &&
+            (tchecker::dbm::sum(DBM2(y,x), tchecker::dbm::db(tchecker::dbm::LT, -l[y])) < DBM1(0,x)))
+          return false;
+      }
+    return true;
+  };
+  
+  // random constraints on a tight positive DBM
+  auto constrain = [&] (std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim, int count) {
+    for (int k = 0; k < count; ++k) {
+      std::vector<tchecker::dbm::db_t> copy = dbm;
+      tchecker::clock_id_t x = gen() % dim, y = gen() % dim;
+      if (x == y)
+        continue;
+      auto cmp = (gen() % 2 == 0 ? tchecker::dbm::LT : tchecker::dbm::LE);
+      tchecker::integer_t value = static_cast<tchecker::integer_t>(gen() % 16) - (x == 0 ? 15 : (y == 0 ? 0 : 5));
+      if (tchecker::dbm::constrain(dbm.data(), dim, x, y, cmp, value) == tchecker::dbm::EMPTY)
+        dbm = copy;
+    }
+  };
+  
+  for (tchecker::clock_id_t dim : {2, 3, 5, 9, 12, 17, 33}) {
+    std::size_t included = 0, not_included = 0;
+    
+    for (int round = 0; round < 50; ++round) {
+      std::vector<tchecker::integer_t> l(dim), u(dim), m(dim);
+      for (tchecker::clock_id_t x = 1; x < dim; ++x) {
+        l[x] = (gen() % 4 == 0 ? - tchecker::dbm::INF_VALUE : static_cast<tchecker::integer_t>(gen() % 16));
+        u[x] = (gen() % 4 == 0 ? - tchecker::dbm::INF_VALUE : static_cast<tchecker::integer_t>(gen() % 16));
+        m[x] = std::max(l[x], u[x]);
+      }
+      
+      std::vector<tchecker::dbm::db_t> dbm1(dim * dim), dbm2(dim * dim);
+      tchecker::dbm::universal_positive(dbm2.data(), dim);
+      constrain(dbm2, dim, dim);
+      dbm1 = dbm2;
+      constrain(dbm1, dim, 2);
+      
+      for (auto const & p : {std::make_pair(&dbm1, &dbm2), std::make_pair(&dbm2, &dbm1)}) {
+        bool const expected = reference_alu_le(*p.first, *p.second, dim, l, u);
+        REQUIRE(tchecker::dbm::is_alu_le(p.first->data(), p.second->data(), dim, l.data(), u.data()) == expected);
+        REQUIRE(tchecker::dbm::is_am_le(p.first->data(), p.second->data(), dim, m.data())
+                == reference_alu_le(*p.first, *p.second, dim, m, m));
+        ++ (expected ? included : not_included);
+      }
+    }
+    
+    REQUIRE(included > 0);
+    REQUIRE(not_included > 0);
+  }
+}
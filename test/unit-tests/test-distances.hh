@@ -0,0 +1,110 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/distances/distances.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/ta.hh"
+#include "tchecker/utils/log.hh"
+
+#include "utils.hh"
+
+TEST_CASE( "distances to labels in location graphs", "[distances]" ) {
+  std::string model =
+  "system:distances \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{labels: ok} \n\
+  location:P1:l2{labels: err} \n\
+  location:P1:l3 \n\
+  edge:P1:l0:l1:a \n\
+  edge:P1:l1:l2:a \n\
+  edge:P1:l0:l3:b \n\
+  \n\
+  process:P2 \n\
+  location:P2:m0{initial:} \n\
+  location:P2:m1{labels: err} \n\
+  edge:P2:m0:m1:a \n\
+  \n\
+  sync:P1@a:P2@a\n";
+
+  tchecker::log_t log(&std::cerr);
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(model, log);
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::model_t ta_model(*sysdecl, log);
+  auto const & system = ta_model.system();
+  tchecker::label_index_t const & index = system.labels();
+
+  std::vector<std::vector<tchecker::ta::loc_t const *>> locations(2);
+  for (tchecker::ta::loc_t const * loc : system.locations())
+    locations[loc->pid()].push_back(loc);
+  auto const * l0 = locations[0][0], * l1 = locations[0][1], * l3 = locations[0][3];
+  auto const * m0 = locations[1][0], * m1 = locations[1][1];
+
+  tchecker::ta::vloc_t * vloc = tchecker::vloc_allocate_and_construct<tchecker::ta::loc_t const>(2, 2);
+
+  SECTION( "one label in several processes" ) {
+    boost::dynamic_bitset<> labels(index.size());
+    labels[index.key("err")] = 1;
+    tchecker::distances::labels_distances_t distances(system, labels);
+
+    REQUIRE(distances.labels_count() == 1);
+    REQUIRE(distances.contributes(0));
+    REQUIRE(distances.contributes(1));
+    REQUIRE(distances.distance(0, l0->id()) == 2);
+    REQUIRE(distances.distance(0, l3->id()) == tchecker::distances::INF_DISTANCE);
+
+    (*vloc)[0] = l0;
+    (*vloc)[1] = m0;
+    REQUIRE(distances.distance(*vloc) == 1);
+    (*vloc)[0] = l3;
+    REQUIRE(distances.distance(*vloc) == 1);
+    (*vloc)[1] = m1;
+    REQUIRE(distances.distance(*vloc) == 0);
+  }
+
+  SECTION( "several labels, non-contributing processes" ) {
+    boost::dynamic_bitset<> labels(index.size());
+    labels[index.key("ok")] = 1;
+    labels[index.key("err")] = 1;
+    tchecker::distances::labels_distances_t distances(system, labels);
+
+    REQUIRE(distances.labels_count() == 2);
+
+    (*vloc)[0] = l0;
+    (*vloc)[1] = m0;
+    REQUIRE(distances.distance(*vloc) == 2);
+    (*vloc)[0] = l1;
+    REQUIRE(distances.distance(*vloc) == 1);
+    (*vloc)[0] = l3;
+    REQUIRE(distances.distance(*vloc) == tchecker::distances::INF_DISTANCE);
+
+    boost::dynamic_bitset<> ok(index.size());
+    ok[index.key("ok")] = 1;
+    tchecker::distances::labels_distances_t ok_distances(system, ok);
+    REQUIRE(ok_distances.contributes(0));
+    REQUIRE_FALSE(ok_distances.contributes(1));
+  }
+
+  SECTION( "no label" ) {
+    tchecker::distances::labels_distances_t distances(system, boost::dynamic_bitset<>(index.size()));
+    (*vloc)[0] = l3;
+    (*vloc)[1] = m0;
+    REQUIRE(distances.distance(*vloc) == 0);
+  }
+
+  tchecker::vloc_destruct_and_deallocate(vloc);
+  delete sysdecl;
+}
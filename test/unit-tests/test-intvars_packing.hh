@@ -0,0 +1,84 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include "tchecker/variables/intvars.hh"
+
+TEST_CASE( "packing of integer variables valuations", "[intvars_packing]" ) {
+  
+  tchecker::integer_variables_t intvars;
+  intvars.declare("b", 1, 0, 1, 0);
+  intvars.declare("c", 1, 5, 5, 5);
+  intvars.declare("t", 3, -4, 3, 0);
+  intvars.declare("w", 1, std::numeric_limits<tchecker::integer_t>::min(),
+                  std::numeric_limits<tchecker::integer_t>::max(), 0);
+  intvars.declare("n", 1, -10, 20, 1);
+  
+  tchecker::flat_integer_variables_t flat_intvars(intvars);
+  tchecker::intvars_packing_t packing(flat_intvars);
+  
+  std::size_t const size = flat_intvars.flattened_size();
+  std::size_t const packed_size = packing.packed_size();
+  
+  tchecker::intvars_valuation_t * v = tchecker::intvars_valuation_allocate_and_construct(size, size);
+  tchecker::intvars_valuation_t * u = tchecker::intvars_valuation_allocate_and_construct(size, size);
+  tchecker::intvars_valuation_t * p = tchecker::intvars_valuation_allocate_and_construct(packed_size, packed_size);
+  tchecker::intvars_valuation_t * q = tchecker::intvars_valuation_allocate_and_construct(packed_size, packed_size);
+  
+  SECTION( "packed valuations are smaller" ) {
+    REQUIRE(packing.size() == size);
+    REQUIRE(packed_size == 3); // b, c, t[] | w | n
+  }
+  
+  SECTION( "unpack(pack(v)) == v" ) {
+    (*v)[0] = 1;
+    (*v)[1] = 5;
+    (*v)[2] = -4;
+    (*v)[3] = 3;
+    (*v)[4] = -1;
+    (*v)[5] = std::numeric_limits<tchecker::integer_t>::min();
+    (*v)[6] = 20;
+    
+    packing.pack(*v, *p);
+    packing.unpack(*p, *u);
+    REQUIRE(*u == *v);
+    
+    (*v)[5] = std::numeric_limits<tchecker::integer_t>::max();
+    (*v)[6] = -9;
+    packing.pack(*v, *p);
+    packing.unpack(*p, *u);
+    REQUIRE(*u == *v);
+  }
+  
+  SECTION( "pack is injective" ) {
+    for (std::size_t i = 0; i < size; ++i)
+      (*v)[i] = (*u)[i] = flat_intvars.info(i).min();
+    (*u)[4] = 0;
+    
+    packing.pack(*v, *p);
+    packing.pack(*u, *q);
+    REQUIRE_FALSE(*p == *q);
+    
+    (*u)[4] = (*v)[4];
+    packing.pack(*u, *q);
+    REQUIRE(*p == *q);
+  }
+  
+  SECTION( "out-of-domain values cannot be packed" ) {
+    for (std::size_t i = 0; i < size; ++i)
+      (*v)[i] = flat_intvars.info(i).min();
+    (*v)[2] = 4;
+    REQUIRE_THROWS_AS(packing.pack(*v, *p), std::out_of_range);
+  }
+  
+  tchecker::intvars_valuation_destruct_and_deallocate(q);
+  tchecker::intvars_valuation_destruct_and_deallocate(p);
+  tchecker::intvars_valuation_destruct_and_deallocate(u);
+  tchecker::intvars_valuation_destruct_and_deallocate(v);
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "tchecker/flat_system/outgoing_edges_cache.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/ta.hh"
+#include "tchecker/utils/log.hh"
+
+#include "utils.hh"
+
+namespace {
+
+  using system_t = tchecker::ta::model_t::system_t;
+  using edge_t = system_t::edge_t;
+  using vloc_t = tchecker::ta::vloc_t;
+
+  // tuples of edges in range, as sequences of edge identifiers
+  template <class RANGE>
+  std::vector<std::vector<tchecker::edge_id_t>> vedges(RANGE && range)
+  {
+    std::vector<std::vector<tchecker::edge_id_t>> v;
+    for (auto it = range.begin(); ! it.at_end(); ++it) {
+      v.emplace_back();
+      for (edge_t const * edge : *it)
+        v.back().push_back(edge->id());
+    }
+    return v;
+  }
+
+} // end of anonymous namespace
+
+TEST_CASE( "cache of outgoing edges", "[outgoing_edges_cache]" ) {
+  std::string model =
+  "system:outgoing_edges_cache \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  \n\
+  process:P1 \n\
+  int:1:0:1:0:i \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1 \n\
+  edge:P1:l0:l1:a \n\
+  edge:P1:l0:l0:c{provided: i>0} \n\
+  edge:P1:l1:l0:b \n\
+  \n\
+  process:P2 \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1 \n\
+  location:P2:l2 \n\
+  edge:P2:l0:l1:a \n\
+  edge:P2:l0:l2:a \n\
+  edge:P2:l1:l0:c \n\
+  \n\
+  sync:P1@a:P2@a\n";
+
+  tchecker::log_t log(&std::cerr);
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(model, log);
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::model_t ta_model(*sysdecl, log);
+  system_t const & system = ta_model.system();
+
+  vloc_t * vloc = tchecker::vloc_allocate_and_construct<tchecker::ta::loc_t const>(2, 2);
+  std::vector<std::vector<tchecker::ta::loc_t const *>> locations(2);
+  for (tchecker::ta::loc_t const * loc : system.locations())
+    locations[loc->pid()].push_back(loc);
+
+  SECTION( "cached edges coincide with synchronized edges, with LRU eviction" ) {
+    tchecker::outgoing_edges_cache_t<system_t, vloc_t> cache(system, ta_model.synchronizer(), 2);
+    REQUIRE(cache.capacity() == 2);
+
+    for (unsigned round = 0; round < 2; ++round)
+      for (auto const * l1 : locations[0])
+        for (auto const * l2 : locations[1]) {
+          (*vloc)[0] = l1;
+          (*vloc)[1] = l2;
+          REQUIRE(vedges(cache.outgoing_edges(*vloc)) == vedges(ta_model.synchronizer().outgoing_edges(*vloc)));
+          REQUIRE(cache.size() <= 2);
+        }
+
+    (*vloc)[0] = locations[0][0];
+    (*vloc)[1] = locations[1][0];
+    REQUIRE(vedges(cache.outgoing_edges(*vloc)).size() == 3);  // <a,a>, <a,a>, c
+
+    tchecker::details::edges_filter_t<edge_t> filter([] (edge_t const * edge) { return edge->event_id() != 0; });
+    REQUIRE(vedges(cache.outgoing_edges(*vloc, &filter)).size() == 1);
+  }
+
+  SECTION( "prebuilt cache" ) {
+    tchecker::outgoing_edges_cache_t<system_t, vloc_t> cache(system, ta_model.synchronizer(), 16);
+    REQUIRE_FALSE(cache.prebuild(5));
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.prebuild(6));
+    REQUIRE(cache.size() == 6);
+  }
+
+  tchecker::vloc_destruct_and_deallocate(vloc);
+  delete sysdecl;
+}
@@ -0,0 +1,128 @@
+/*
+* This file is a part of the TChecker project.
+*
+* See files AUTHORS and LICENSE for copyright details.
+*
+*/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "tchecker/fsm/details/allocators.hh"
+#include "tchecker/utils/gc.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+namespace pool_test {
+  
+  struct object_t {
+    object_t(int v) : value(v) {}
+    int value;
+  };
+  
+  bool operator== (object_t const & o1, object_t const & o2)
+  {
+    return (o1.value == o2.value);
+  }
+  
+  std::size_t hash_value(object_t const & o)
+  {
+    return static_cast<std::size_t>(o.value);
+  }
+  
+} // end of namespace pool_test
+
+namespace tchecker {
+  
+  template <>
+  class allocation_size_t<pool_test::object_t> {
+  public:
+    template <class ... ARGS>
+    static constexpr std::size_t alloc_size(ARGS && ... args)
+    {
+      return sizeof(pool_test::object_t);
+    }
+  };
+  
+} // end of namespace tchecker
+
+TEST_CASE( "pool collection", "[pool]" ) {
+
+  using shared_t = tchecker::make_shared_t<pool_test::object_t>;
+  using pool_t = tchecker::pool_t<shared_t>;
+
+  SECTION( "collect reclaims released objects" ) {
+    pool_t pool(4, tchecker::allocation_size_t<shared_t>::alloc_size());
+    
+    pool_t::ptr_t p1 = pool.construct(1), p2 = pool.construct(2);
+    REQUIRE( pool.collect() == 0 );
+    
+    p1 = nullptr;
+    REQUIRE( pool.collect() == 1 );
+    REQUIRE( pool.collect() == 0 );
+    REQUIRE( p2->value == 2 );
+    
+    p1 = pool.construct(3);  // reuses the collected chunk
+    REQUIRE( p1->value == 3 );
+    REQUIRE( pool.memsize() == 4 * pool_t::MIN_ALLOC_SIZE + sizeof(void *) );
+  }
+
+  SECTION( "collection is triggered by the garbage collector" ) {
+    pool_t pool(4, tchecker::allocation_size_t<shared_t>::alloc_size());
+    tchecker::gc_t gc(std::chrono::milliseconds(1));
+    pool.enroll(gc);
+    gc.start();
+    
+    std::vector<pool_t::ptr_t> v;
+    for (int i = 0; i < 10; ++i)
+      v.push_back(pool.construct(i));
+    v.clear();
+    
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((gc.collected_chunks() < 10) && (std::chrono::steady_clock::now() < deadline))
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    gc.stop();
+    
+    REQUIRE( gc.collected_chunks() == 10 );
+    REQUIRE( gc.collections() > 0 );
+    REQUIRE( gc.peak_memsize() == pool.memsize() );
+    REQUIRE( pool.collect() == 0 );
+    
+    // collected chunks are reused before any new block is allocated
+    std::size_t const memsize = pool.memsize();
+    for (int i = 0; i < 10; ++i)
+      v.push_back(pool.construct(i));
+    REQUIRE( pool.memsize() == memsize );
+  }
+}
+
+
+
+TEST_CASE( "shared components", "[pool]" ) {
+  
+  using shared_t = tchecker::make_shared_t<pool_test::object_t>;
+  using pool_t = tchecker::pool_t<shared_t>;
+  
+  pool_t pool(4, tchecker::allocation_size_t<shared_t>::alloc_size());
+  tchecker::fsm::details::shared_components_t<shared_t> shared(pool);
+  
+  pool_t::ptr_t p1 = pool.construct(1), p2 = pool.construct(1), p3 = pool.construct(2);
+  shared_t const * p2_initial = p2.ptr();
+  
+  REQUIRE_FALSE( shared.share(p1) );
+  REQUIRE( shared.share(p2) );
+  REQUIRE( p2.ptr() == p1.ptr() );
+  REQUIRE( p2.ptr() != p2_initial );
+  REQUIRE_FALSE( shared.share(p3) );
+  REQUIRE_FALSE( shared.share(p1) );
+  REQUIRE( shared.size() == 2 );
+  
+  // the copy of p1 has been destructed when p2 was shared
+  pool_t::ptr_t p4 = pool.construct(4);
+  REQUIRE( p4.ptr() == p2_initial );
+  
+  shared.clear();
+  REQUIRE( shared.size() == 0 );
+  REQUIRE( p1->refcount() == 2 );
+}
@@ -0,0 +1,193 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/native.hh"
+#include "tchecker/vm/optimizer.hh"
+#include "tchecker/vm/vm.hh"
+
+TEST_CASE( "checking and interpretation of bytecode", "[vm]" ) {
+  
+  std::size_t const intvars_size = 4;  // x, t[3]
+  std::size_t const clocks_size = 2;   // zero clock, y
+  
+  tchecker::intvars_valuation_t * v = tchecker::intvars_valuation_allocate_and_construct(intvars_size, intvars_size);
+  for (std::size_t i = 0; i < intvars_size; ++i)
+    (*v)[i] = static_cast<tchecker::integer_t>(10 * i);
+  
+  tchecker::clock_constraint_container_t clkconstr;
+  tchecker::clock_reset_container_t clkreset;
+  
+  // t[x+2] < 25
+  tchecker::bytecode_t const guard[] = {
+    tchecker::VM_PUSH, 1,
+    tchecker::VM_PUSH, 0, tchecker::VM_VALUEAT, tchecker::VM_PUSH, 2, tchecker::VM_SUM,
+    tchecker::VM_FAILNOTIN, 0, 2,
+    tchecker::VM_SUM, tchecker::VM_VALUEAT,
+    tchecker::VM_PUSH, 25, tchecker::VM_LT,
+    tchecker::VM_RET
+  };
+  
+  SECTION( "stack size and variable IDs are checked statically" ) {
+    REQUIRE(tchecker::check_bytecode(guard, intvars_size, clocks_size) == 3);
+    REQUIRE_THROWS_AS(tchecker::check_bytecode(guard, intvars_size - 1, clocks_size), std::invalid_argument);
+    
+    tchecker::bytecode_t const unbounded[] = {
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_VALUEAT, tchecker::VM_SUM, tchecker::VM_VALUEAT,
+      tchecker::VM_RET
+    };
+    REQUIRE_THROWS_AS(tchecker::check_bytecode(unbounded, intvars_size, clocks_size), std::invalid_argument);
+    
+    tchecker::bytecode_t const underflow[] = {tchecker::VM_PUSH, 1, tchecker::VM_SUM, tchecker::VM_RET};
+    REQUIRE_THROWS_AS(tchecker::check_bytecode(underflow, intvars_size, clocks_size), std::invalid_argument);
+  }
+  
+  SECTION( "interpretation of checked bytecode" ) {
+    tchecker::vm_t vm(intvars_size, clocks_size, tchecker::check_bytecode(guard, intvars_size, clocks_size));
+    
+    (*v)[0] = -1;
+    REQUIRE(vm.run(guard, *v, clkconstr, clkreset) == 1);  // t[1] = 20
+    (*v)[0] = 0;
+    REQUIRE(vm.run(guard, *v, clkconstr, clkreset) == 0);  // t[2] = 30
+    (*v)[0] = 1;
+    REQUIRE_THROWS_AS(vm.run(guard, *v, clkconstr, clkreset), std::out_of_range);
+    (*v)[0] = -1;
+    REQUIRE(vm.run(guard, *v, clkconstr, clkreset) == 1);  // VM is usable after exception
+  }
+  
+  SECTION( "interpretation of clock constraints, resets and assignments" ) {
+    // y <= 3 && x == 0 ; x = 2; y = 0
+    tchecker::bytecode_t const bytecode[] = {
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 3, tchecker::VM_CLKCONSTR, 1,
+      tchecker::VM_PUSH, 1, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 0, tchecker::VM_VALUEAT, tchecker::VM_PUSH, 0, tchecker::VM_EQ, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 2, tchecker::VM_FAILNOTIN, 0, 5, tchecker::VM_ASSIGN,
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 0, tchecker::VM_CLKRESET,
+      tchecker::VM_LAND, tchecker::VM_RET
+    };
+    tchecker::vm_t vm(intvars_size, clocks_size, tchecker::check_bytecode(bytecode, intvars_size, clocks_size));
+    
+    (*v)[0] = 1;
+    REQUIRE(vm.run(bytecode, *v, clkconstr, clkreset) == 0);
+    REQUIRE(clkconstr.size() == 1);
+    REQUIRE(clkconstr[0].id1() == 1);
+    REQUIRE(clkconstr[0].id2() == 0);
+    REQUIRE(clkconstr[0].comparator() == tchecker::clock_constraint_t::LE);
+    REQUIRE(clkconstr[0].value() == 3);
+    REQUIRE(clkreset.empty());
+    
+    (*v)[0] = 0;
+    REQUIRE(vm.run(bytecode, *v, clkconstr, clkreset) == 1);
+    REQUIRE((*v)[0] == 2);
+    REQUIRE(clkreset.size() == 1);
+    REQUIRE(clkreset[0].left_id() == 1);
+    REQUIRE(clkreset[0].right_id() == 0);
+    REQUIRE(clkreset[0].value() == 0);
+  }
+  
+  SECTION( "peephole optimization" ) {
+    // y <= 3 && t[2-1] <= 3*10 && x == 0
+    std::vector<tchecker::bytecode_t> bytecode{
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 3, tchecker::VM_CLKCONSTR, 1,
+      tchecker::VM_PUSH, 1, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 2, tchecker::VM_PUSH, 1, tchecker::VM_MINUS,
+      tchecker::VM_FAILNOTIN, 0, 2, tchecker::VM_SUM, tchecker::VM_VALUEAT,
+      tchecker::VM_PUSH, 3, tchecker::VM_PUSH, 10, tchecker::VM_MUL, tchecker::VM_LE, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 0, tchecker::VM_VALUEAT, tchecker::VM_EQ,
+      tchecker::VM_LAND, tchecker::VM_RETZ, tchecker::VM_LAND, tchecker::VM_RETZ, tchecker::VM_NOP, tchecker::VM_RET
+    };
+    std::vector<tchecker::bytecode_t> optimized(bytecode);
+    tchecker::optimize(optimized);
+    
+    std::vector<tchecker::bytecode_t> const expected{
+      tchecker::VM_CLKCONSTRC, 1, 0, 3, 1,
+      tchecker::VM_LEVC, 2, 30, tchecker::VM_RETZ, tchecker::VM_EQVC, 0, 0, tchecker::VM_LAND, tchecker::VM_RETZ,
+      tchecker::VM_LAND, tchecker::VM_RETZ, tchecker::VM_RET
+    };
+    REQUIRE(optimized == expected);
+    
+    tchecker::vm_t vm(intvars_size, clocks_size, tchecker::check_bytecode(bytecode.data(), intvars_size, clocks_size));
+    REQUIRE(tchecker::check_bytecode(optimized.data(), intvars_size, clocks_size) <= vm.stack_size());
+    for (tchecker::integer_t x = -1; x <= 1; ++x) {
+      (*v)[0] = x;
+      REQUIRE(vm.run(optimized.data(), *v, clkconstr, clkreset) == vm.run(bytecode.data(), *v, clkconstr, clkreset));
+    }
+    REQUIRE(clkconstr.size() == 6);
+    
+    // division by zero and out-of-bounds constants are not folded
+    std::vector<tchecker::bytecode_t> failing{
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_DIV, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 7, tchecker::VM_FAILNOTIN, 0, 5, tchecker::VM_ASSIGN,
+      tchecker::VM_PUSH, 1, tchecker::VM_RET
+    };
+    std::vector<tchecker::bytecode_t> const failing_copy(failing);
+    tchecker::optimize(failing);
+    REQUIRE(failing == failing_copy);
+  }
+  
+  SECTION( "native code" ) {
+    // y <= 3 && t[x+1] <= 30 ; x = 2; y = 0   (with t of size 2)
+    std::vector<tchecker::bytecode_t> bytecode{
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 3, tchecker::VM_CLKCONSTR, 1,
+      tchecker::VM_PUSH, 1, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_VALUEAT, tchecker::VM_PUSH, 1, tchecker::VM_SUM,
+      tchecker::VM_FAILNOTIN, 0, 1, tchecker::VM_SUM, tchecker::VM_VALUEAT, tchecker::VM_PUSH, 30, tchecker::VM_LE,
+      tchecker::VM_LAND, tchecker::VM_RETZ,
+      tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 2, tchecker::VM_ASSIGN,
+      tchecker::VM_PUSH, 1, tchecker::VM_PUSH, 0, tchecker::VM_PUSH, 0, tchecker::VM_CLKRESET,
+      tchecker::VM_RET
+    };
+    std::vector<tchecker::bytecode_t> optimized(bytecode);
+    tchecker::optimize(optimized);
+    
+    std::string const cache_dir = (std::filesystem::temp_directory_path() / "tchecker-test-native").string();
+    std::vector<tchecker::bytecode_t const *> const bytecodes{guard, bytecode.data(), optimized.data()};
+    tchecker::native_code_t native(bytecodes, cache_dir);
+    REQUIRE(tchecker::native_code_t(bytecodes, cache_dir).cached());
+    
+    tchecker::vm_t vm(intvars_size, clocks_size, tchecker::check_bytecode(bytecode.data(), intvars_size, clocks_size));
+    for (std::size_t i = 0; i < bytecodes.size(); ++i)
+      for (tchecker::integer_t x = -1; x <= 1; ++x) {
+        (*v)[0] = x;
+        tchecker::clock_constraint_container_t native_clkconstr;
+        tchecker::clock_reset_container_t native_clkreset;
+        if (x == 1) {
+          REQUIRE_THROWS_AS(vm.run(bytecodes[i], *v, clkconstr, clkreset), std::out_of_range);
+          REQUIRE_THROWS_AS(tchecker::native_code_t::run(native.function(i), *v, native_clkconstr, native_clkreset),
+                            std::out_of_range);
+          continue;
+        }
+        clkconstr.clear();
+        clkreset.clear();
+        tchecker::integer_t const result = vm.run(bytecodes[i], *v, clkconstr, clkreset);
+        tchecker::integer_t const vm_x = (*v)[0];
+        (*v)[0] = x;
+        REQUIRE(tchecker::native_code_t::run(native.function(i), *v, native_clkconstr, native_clkreset) == result);
+        REQUIRE((*v)[0] == vm_x);
+        REQUIRE(native_clkconstr.size() == clkconstr.size());
+        for (std::size_t k = 0; k < clkconstr.size(); ++k) {
+          REQUIRE(native_clkconstr[k].id1() == clkconstr[k].id1());
+          REQUIRE(native_clkconstr[k].id2() == clkconstr[k].id2());
+          REQUIRE(native_clkconstr[k].comparator() == clkconstr[k].comparator());
+          REQUIRE(native_clkconstr[k].value() == clkconstr[k].value());
+        }
+        REQUIRE(native_clkreset.size() == clkreset.size());
+        for (std::size_t k = 0; k < clkreset.size(); ++k) {
+          REQUIRE(native_clkreset[k].left_id() == clkreset[k].left_id());
+          REQUIRE(native_clkreset[k].right_id() == clkreset[k].right_id());
+          REQUIRE(native_clkreset[k].value() == clkreset[k].value());
+        }
+      }
+  }
+  
+  tchecker::intvars_valuation_destruct_and_deallocate(v);
+}
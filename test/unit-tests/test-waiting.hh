@@ -0,0 +1,171 @@
+/*
+* This file is a part of the TChecker project.
+*
+* See files AUTHORS and LICENSE for copyright details.
+*
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tchecker/utils/waiting.hh"
+
+TEST_CASE( "work-stealing waiting container, single worker" , "[waiting]" ) {
+
+  SECTION( "LIFO policy" ) {
+    tchecker::work_stealing_waiting_t<int> waiting(1, tchecker::work_stealing_waiting_t<int>::LIFO);
+    int t = 0;
+
+    waiting.insert(0, 1);
+    waiting.insert(0, 2);
+    waiting.insert(0, 3);
+
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 3 );
+    waiting.done();
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 2 );
+    waiting.done();
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 1 );
+    waiting.done();
+    REQUIRE( ! waiting.take(0, t) );
+  }
+
+  SECTION( "FIFO policy" ) {
+    tchecker::work_stealing_waiting_t<int> waiting(1, tchecker::work_stealing_waiting_t<int>::FIFO);
+    int t = 0;
+
+    waiting.insert(0, 1);
+    waiting.insert(0, 2);
+    waiting.insert(0, 3);
+
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 1 );
+    waiting.done();
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 2 );
+    waiting.done();
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 3 );
+    waiting.done();
+    REQUIRE( ! waiting.take(0, t) );
+  }
+
+  SECTION( "Filter" ) {
+    std::vector<bool> active{true, false, true, true};
+    tchecker::work_stealing_waiting_t<int> waiting(1, tchecker::work_stealing_waiting_t<int>::FIFO,
+                                                   [&] (int const & i) { return active[i]; });
+    int t = 0;
+
+    waiting.insert(0, 0);
+    waiting.insert(0, 1);   // filtered out at insertion
+    waiting.insert(0, 2);
+    waiting.insert(0, 3);
+    active[2] = false;      // filtered out when taken
+
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 0 );
+    waiting.done();
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 3 );
+    waiting.done();
+    REQUIRE( ! waiting.take(0, t) );
+  }
+
+  SECTION( "Stop" ) {
+    tchecker::work_stealing_waiting_t<int> waiting(1, tchecker::work_stealing_waiting_t<int>::LIFO);
+    int t = 0;
+
+    waiting.insert(0, 1);
+    waiting.stop();
+    REQUIRE( ! waiting.take(0, t) );
+  }
+}
+
+
+TEST_CASE( "work-stealing waiting container, several workers" , "[waiting]" ) {
+
+  SECTION( "Stealing oldest element" ) {
+    tchecker::work_stealing_waiting_t<int> waiting(2, tchecker::work_stealing_waiting_t<int>::LIFO);
+    int t = 0;
+
+    waiting.insert(0, 1);
+    waiting.insert(0, 2);
+
+    REQUIRE( waiting.take(1, t) );
+    REQUIRE( t == 1 );
+    REQUIRE( waiting.take(0, t) );
+    REQUIRE( t == 2 );
+    waiting.done();
+    waiting.done();
+    REQUIRE( ! waiting.take(1, t) );
+  }
+
+  SECTION( "Concurrent exploration of a binary tree" ) {
+    std::size_t const workers = 4;
+    int const depth = 12;
+    tchecker::work_stealing_waiting_t<int> waiting(workers, tchecker::work_stealing_waiting_t<int>::LIFO);
+    std::atomic<int> visited(0);
+
+    waiting.insert(0, 0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < workers; ++i)
+      threads.emplace_back([&, i] () {
+        int t = 0;
+        while (waiting.take(i, t)) {
+          ++ visited;
+          if (t < depth) {
+            waiting.insert(i, t + 1);
+            waiting.insert(i, t + 1);
+          }
+          waiting.done();
+        }
+      });
+
+    for (std::thread & thread : threads)
+      thread.join();
+
+    REQUIRE( visited == (1 << (depth + 1)) - 1 );
+  }
+}
+
+
+TEST_CASE( "priority waiting container" , "[waiting]" ) {
+
+  auto priority = [] (int const & i) { return i / 10; };
+  using waiting_t = tchecker::priority_waiting_t<int, decltype(priority)>;
+
+  SECTION( "smallest priority first, LIFO among same priority" ) {
+    waiting_t waiting(priority);
+    REQUIRE( waiting.empty() );
+
+    for (int i : {25, 3, 14, 7, 21, 12})
+      waiting.insert(i);
+
+    std::vector<int> order;
+    while (! waiting.empty()) {
+      order.push_back(waiting.first());
+      waiting.remove_first();
+    }
+    REQUIRE( order == std::vector<int>{7, 3, 12, 14, 21, 25} );
+  }
+
+  SECTION( "lazy removal of filtered elements" ) {
+    std::vector<bool> active(30, true);
+    tchecker::filter_waiting_t<waiting_t> waiting([&] (int const & i) { return active[i]; }, priority);
+
+    for (int i : {25, 3, 14, 7})
+      waiting.insert(i);
+    active[7] = false;
+    active[14] = false;
+
+    REQUIRE( waiting.first() == 3 );
+    waiting.remove_first();
+    REQUIRE( waiting.first() == 25 );
+    waiting.remove_first();
+    REQUIRE( waiting.empty() );
+  }
+}
@@ -8,11 +8,18 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 
+#include "test-cover_graph.hh"
 #include "test-db.hh"
 #include "test-dbm.hh"
+#include "test-distances.hh"
 #include "test-extract_variables.hh"
 #include "test-guard_weak_sync.hh"
+#include "test-intvars_packing.hh"
 #include "test-offset_clock_variables.hh"
 #include "test-offset_dbm.hh"
 #include "test-ordering.hh"
+#include "test-outgoing_edges_cache.hh"
+#include "test-pool.hh"
 #include "test-variables-access.hh"
+#include "test-vm.hh"
+#include "test-waiting.hh"